@@ -1,202 +1,362 @@
-#include "Arduino.h"
-#include <ESPAsyncWebServer.h>                 // Provides asynchronous web server support for up to 8 clients
-#include "SerialWS.h"
-
-SerialWS::SerialWS(){}
-
-AsyncWebServer *_server;                       // Server on which SerialWS is being served
-AsyncWebSocket _ws("/SerialWS");               // Websocket on which SerialWS will be served
-size_t _rxBufferSize;                          // Size of Rx buffer (receive buffer). Should always be a multiple of 4
-unsigned char * _rx_buffer;                    // Pointer to Rx buffer of size _rxBufferSize
-volatile size_t _rx_buffer_head;               // Index of Rx buffer head (Where next received byte will be stored)
-volatile size_t _rx_buffer_tail;               // Index of Rx buffer tail (Where next byte from buffer will be read)
-
-// begin must be called to initiate SerialWS.
-// AsyncWebServer *server: A pointer to the main webserver SerialWS will be hosted on.
-// uint16_t RxBufferSize: Size, in bytes, for the receive buffer. Data received via SerialWS will be placed here for later peek, read, etc.
-// uint16_t TxBufferSize: Size, in bytes, for the transmit buffer. Transmits are usually buffered in order to prevent multiple mini writes.
-void SerialWS::begin(AsyncWebServer *server, uint16_t TxBufferSize, uint16_t RxBufferSize){
-  _rxBufferSize   = RxBufferSize;              // Size of Rx buffer (receive buffer). Should always be a multiple of 4
-  _txBufferSize   = TxBufferSize;              // Size of Tx buffer (transmit buffer). Should always be a multiple of 4
-  _rx_buffer_head = 0;                         // Index of Rx buffer head (Where next received byte will be stored)
-  _rx_buffer_tail = 0;                         // Index of Rx buffer tail (Where next byte from buffer will be read)
-  _tx_buffer_head = 0;                         // Index of Tx buffer head (Where next byte to be transmitted will be stored)
-  _tx_buffer_tail = 0;                         // Index of Tx buffer tail (Where next byte to be transmitted from buffer will be read)
-  _timeout = 1;                                // The Serial class has a timeout for receiving bytes. We don't need it because we receive in blocks.
- 
-  if(_rxBufferSize > SerialWSmaxBuffer)_rxBufferSize = SerialWSmaxBuffer;
-  if(_txBufferSize > SerialWSmaxBuffer)_txBufferSize = SerialWSmaxBuffer;
-
-  if(_rxBufferSize  > 0) _rx_buffer = (unsigned char*)malloc(_rxBufferSize);     // Pointer to Rx buffer of size _rxBufferSize
-  if(_txBufferSize  > 0) _tx_buffer = (unsigned char*)malloc(_txBufferSize);     // Pointer to Tx buffer of size _txBufferSize
-  _server = server;                                              // Server on which SerialWS is being served
-  _ws.onEvent(onSerialWsEvent);                                  // Server will call function onSerialWsEvent when SerialWS websocket events occur
-  _server->addHandler(&_ws);
-}
-
-// end can be called to stop SerialWS
-// SerialWS websocket handler will be removed from the server,
-// the Rx and Tx buffers will be released (memory returned to heap)
-// and all internal variables reset
-void SerialWS::end(){
-  _server->removeHandler(&_ws);                                    // Remove the SerialWS websocket handler from the server
-  if(_rxBufferSize  > 0) free(_rx_buffer);                         // Release Rx buffer memory back to the heap
-  if(_txBufferSize  > 0) free(_tx_buffer);                         // Release Tx buffer memory back to the heap
-  _txBufferSize = 0;
-  _rxBufferSize = 0;
-  _rx_buffer_head = 0;
-  _rx_buffer_tail = 0;
-  _tx_buffer_head = 0;
-  _tx_buffer_tail = 0;
-}
-
-// Returns the number of bytes in the receive buffer
-int SerialWS::available(void){
-  int retVal = 0;
-  if(_rxBufferSize > 0)
-    retVal = (unsigned int)(_rxBufferSize + _rx_buffer_head - _rx_buffer_tail) % _rxBufferSize;
-  return retVal;
-}
-
-// Returns the number of bytes in the transmission buffer awaiting transmission. Will return 0 if not buffering.
-int SerialWS::awaitingSend(void){
-  int retVal = 0;
-  if(_txBufferSize > 0)
-    retVal = (unsigned int)(_txBufferSize + _tx_buffer_head - _tx_buffer_tail) % _txBufferSize;
-  return retVal;
-}
-
-// Returns the number of bytes remaining in the transmit buffer. Will return 0 if not buffering.
-int SerialWS::availableForWrite(void){
-  int retVal = 0;
-  if(_txBufferSize > 0)
-    retVal = _txBufferSize - awaitingSend();
-  return retVal;
-}
-
-// Returns the ASCII code of the next byte in the receive buffer. The byte remains in the buffer! Returns -1 if there is no byte in the buffer.
-int SerialWS::peek(void){
-  int retVal = -1;
-  if((_rxBufferSize > 0) && !(_rx_buffer_head == _rx_buffer_tail)){
-    retVal = (int)_rx_buffer[_rx_buffer_tail];
-  }
-  return retVal;
-}
-
-// Returns the ASCII code of the next byte in the receive buffer. The byte is removed from the buffer. Returns -1 if there is no byte in the buffer.
-int SerialWS::read(void){
-  int retVal = peek();
-  if(retVal >= 0)
-    _rx_buffer_tail = (_rx_buffer_tail + 1) % _rxBufferSize;
-  return retVal;
-}
-
-// Reads up to size/length bytes from the receive buffer. Bytes are removed from the buffer. The number of bytes read will be returned.
-int SerialWS::read(uint8_t *buffer, int size){
-  int cnt;
-  int c;
-  for(cnt = 0; cnt < size; cnt++){
-    c=read();
-    if(c >= 0){
-      buffer[cnt] = (uint8_t) c;
-    }else
-      break;
-  }
-  return cnt;
-}
-
-// Clears the buffer(s). No processing of any data will be done!
-void SerialWS::flush(void){
-  flushRecv();
-  flushSend();
-}
-void SerialWS::flushRecv(void){
-  if(_rxBufferSize  > 0){
-    _rx_buffer_head = 0;
-    _rx_buffer_tail = 0;
-  }
-}
-void SerialWS::flushSend(void){
-  if(_txBufferSize  > 0){
-    _tx_buffer_head = 0;
-    _tx_buffer_tail = 0;
-  }
-}
-
-void SerialWS::cleanupClients(void){
-  _ws.cleanupClients();
-}
-
-void SerialWS::send(){
- if(!(_tx_buffer_head == _tx_buffer_tail)){
-   char tmpBuff[_txBufferSize];                                    // New buffer (because our ring buffer is not necessarily ordered)
-   int i = 0;
-   while(!(_tx_buffer_head == _tx_buffer_tail)){
-     tmpBuff[i] = _tx_buffer[_tx_buffer_tail];
-     _tx_buffer_tail = (_tx_buffer_tail + 1) % _txBufferSize;
-     i++;
-   }
-   _ws.textAll(tmpBuff, i);
-   flushSend();
-  }
-}
-
-// checkBuffer will test if the buffer is full. If full, it will send it to all clients and reset th buffer.
-void SerialWS::checkBuffer(){
-  int w = (_tx_buffer_head + 1) % _txBufferSize;
-  if(w == _tx_buffer_tail){                                        //  If buffer is full
-    send();
-  }
-}
-
-// Write a single byte
-size_t SerialWS::write(uint8_t b){
-  if(_txBufferSize  > 0){                                          // If buffering
-    checkBuffer();
-    _tx_buffer[_tx_buffer_head] = b;
-    _tx_buffer_head = (_tx_buffer_head + 1) % _txBufferSize;
-  }else{                                                           // Not buffering. Direct write! (bad idea as bad performance to broadcast single bytes!)
-    _ws.textAll(&b, 1);
-  }
-  return 1;                                                        // One byte written
-}
-
-// Write a block of bytes
-size_t SerialWS::write(uint8_t *buffer, size_t size){
-  if(_txBufferSize  > 0){                                          // If buffering
-    for(int i =0; i < size; i++){
-      checkBuffer();
-      _tx_buffer[_tx_buffer_head] = buffer[i];
-      _tx_buffer_head = (_tx_buffer_head + 1) % _txBufferSize;
-    }
-  }else{                                                           // Not buffering. Direct write!
-    _ws.textAll(buffer, size);
-  }
-  return size;
-}
-
-// Handles SerialWS web socket events
-void SerialWS::onSerialWsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len){
-  switch(type){
-  case WS_EVT_CONNECT:
-    break;
-  case WS_EVT_DISCONNECT:
-    break;
-  case WS_EVT_ERROR:
-    break;
-  case WS_EVT_PONG:
-    break;
-  case WS_EVT_DATA:
-    // Data has been received by the SerialWS websocket
-    if(_rxBufferSize > 0){                                         // Else, if there is a receive buffer
-      int index;
-      for(int i = 0; i < len; i++){                                // Loop through each byte received
-        index = (_rx_buffer_head + 1) % _rxBufferSize;             // Calculate a new ring buffer head
-        if(index == _rx_buffer_tail)                               // If new head = tail, buffer is full so the data can't be stored.
-          break;                                                   // So leave the loop, abandoning the rest of the data.
-        _rx_buffer[_rx_buffer_head] = data[i];                     // Store the data byte in the buffer
-        _rx_buffer_head = index;                                   // Remember the new head.
-      }
-    }
-  }
-}
+#include "Arduino.h"
+#include <ESPAsyncWebServer.h>                 // Provides asynchronous web server support for up to 8 clients
+#include "SerialWS.h"
+
+SerialWS::SerialWS(){}
+
+AsyncWebServer *_server;                       // Server on which SerialWS is being served
+AsyncWebSocket _ws("/SerialWS");               // Websocket on which SerialWS will be served
+size_t _rxBufferSize;                          // Size of Rx buffer (receive buffer). Should always be a multiple of 4
+unsigned char * _rx_buffer;                    // Pointer to Rx buffer of size _rxBufferSize
+volatile size_t _rx_buffer_head;               // Index of Rx buffer head (Where next received byte will be stored)
+volatile size_t _rx_buffer_tail;               // Index of Rx buffer tail (Where next byte from buffer will be read)
+
+// Clients connected to SerialWS, maintained from the connect/disconnect events.
+// A client whose websocket queue is full gets data held back in its backlog instead of queueing more frames on the heap.
+typedef struct {uint32_t id;                   // Websocket client id. 0 = slot is empty
+                uint8_t * backlog;             // Data held back for this client. Only allocated while the client is stalled
+                size_t used;                   // Bytes in backlog
+               } SerialWSclient;
+SerialWSclient _clients[SerialWSmaxClients];
+
+// Advances a ring buffer index by n bytes, wrapping around at size. Avoids a modulo for every byte.
+static inline size_t ringAdvance(size_t index, size_t n, size_t size){
+  index += n;
+  if(index >= size) index -= size;
+  return index;
+}
+
+// begin must be called to initiate SerialWS.
+// AsyncWebServer *server: A pointer to the main webserver SerialWS will be hosted on.
+// uint16_t RxBufferSize: Size, in bytes, for the receive buffer. Data received via SerialWS will be placed here for later peek, read, etc.
+// uint16_t TxBufferSize: Size, in bytes, for the transmit buffer. Transmits are usually buffered in order to prevent multiple mini writes.
+void SerialWS::begin(AsyncWebServer *server, uint16_t TxBufferSize, uint16_t RxBufferSize){
+  _rxBufferSize   = RxBufferSize;              // Size of Rx buffer (receive buffer). Should always be a multiple of 4
+  _txBufferSize   = TxBufferSize;              // Size of Tx buffer (transmit buffer). Should always be a multiple of 4
+  _rx_buffer_head = 0;                         // Index of Rx buffer head (Where next received byte will be stored)
+  _rx_buffer_tail = 0;                         // Index of Rx buffer tail (Where next byte from buffer will be read)
+  _tx_buffer_head = 0;                         // Index of Tx buffer head (Where next byte to be transmitted will be stored)
+  _tx_buffer_tail = 0;                         // Index of Tx buffer tail (Where next byte to be transmitted from buffer will be read)
+  _timeout = 1;                                // The Serial class has a timeout for receiving bytes. We don't need it because we receive in blocks.
+ 
+  if(_rxBufferSize > SerialWSmaxBuffer)_rxBufferSize = SerialWSmaxBuffer;
+  if(_txBufferSize > SerialWSmaxBuffer)_txBufferSize = SerialWSmaxBuffer;
+  if(_rxBufferSize == 1)_rxBufferSize = 2;                       // A ring buffer always keeps one slot empty, so 1 byte could never hold data
+  if(_txBufferSize == 1)_txBufferSize = 2;
+
+  if(_rxBufferSize  > 0) _rx_buffer = (unsigned char*)malloc(_rxBufferSize);     // Pointer to Rx buffer of size _rxBufferSize
+  if(_txBufferSize  > 0) _tx_buffer = (unsigned char*)malloc(_txBufferSize);     // Pointer to Tx buffer of size _txBufferSize
+  _server = server;                                              // Server on which SerialWS is being served
+  _ws.onEvent(onSerialWsEvent);                                  // Server will call function onSerialWsEvent when SerialWS websocket events occur
+  _server->addHandler(&_ws);
+}
+
+// end can be called to stop SerialWS
+// SerialWS websocket handler will be removed from the server,
+// the Rx and Tx buffers will be released (memory returned to heap)
+// and all internal variables reset
+void SerialWS::end(){
+  _server->removeHandler(&_ws);                                    // Remove the SerialWS websocket handler from the server
+  if(_rxBufferSize  > 0) free(_rx_buffer);                         // Release Rx buffer memory back to the heap
+  if(_txBufferSize  > 0) free(_tx_buffer);                         // Release Tx buffer memory back to the heap
+  _txBufferSize = 0;
+  _rxBufferSize = 0;
+  _rx_buffer_head = 0;
+  _rx_buffer_tail = 0;
+  _tx_buffer_head = 0;
+  _tx_buffer_tail = 0;
+  for(int c = 0; c < SerialWSmaxClients; c++){
+    free(_clients[c].backlog);
+    _clients[c] = {0, NULL, 0};
+  }
+}
+
+// Flush policy used by handle(). Buffered data is sent once maxBytes are waiting or the oldest waiting byte
+// is maxDelayMs old, whichever comes first. A full buffer is always sent.
+void SerialWS::setFlushPolicy(uint16_t maxBytes, uint32_t maxDelayMs){
+  _flushBytes = maxBytes;
+  _flushMs = maxDelayMs;
+}
+
+// Backpressure policy for slow clients. See SerialWS.h
+void SerialWS::setClientPolicy(uint16_t backlogSize, bool dropOldest){
+  _backlogSize = backlogSize;
+  _dropOldest = dropOldest;
+}
+
+// Applies the flush policy and delivers backlogs to clients that caught up. Call this from within loop().
+void SerialWS::handle(void){
+  size_t cnt = awaitingSend();
+  if(cnt && ((cnt >= _flushBytes) || ((millis() - _pendingSince) >= _flushMs)))
+    send();
+  for(int c = 0; c < SerialWSmaxClients; c++){
+    if(_clients[c].used == 0) continue;
+    AsyncWebSocketClient *client = _ws.client(_clients[c].id);
+    if(client && client->queueIsFull()) continue;                  // Still stalled. Try again next time
+    if(client){
+      client->text((char*)_clients[c].backlog, _clients[c].used);  // The whole backlog goes out as one frame
+      _framesSent++;
+    }
+    free(_clients[c].backlog);                                     // Only keep memory while a client is stalled
+    _clients[c].backlog = NULL;
+    _clients[c].used = 0;
+  }
+}
+
+// Returns the number of bytes in the receive buffer
+int SerialWS::available(void){
+  int retVal = 0;
+  if(_rxBufferSize > 0)
+    retVal = (unsigned int)(_rxBufferSize + _rx_buffer_head - _rx_buffer_tail) % _rxBufferSize;
+  return retVal;
+}
+
+// Returns the number of bytes in the transmission buffer awaiting transmission. Will return 0 if not buffering.
+int SerialWS::awaitingSend(void){
+  int retVal = 0;
+  if(_txBufferSize > 0)
+    retVal = (unsigned int)(_txBufferSize + _tx_buffer_head - _tx_buffer_tail) % _txBufferSize;
+  return retVal;
+}
+
+// Returns the number of bytes remaining in the transmit buffer. Will return 0 if not buffering.
+int SerialWS::availableForWrite(void){
+  int retVal = 0;
+  if(_txBufferSize > 0)
+    retVal = _txBufferSize - awaitingSend();
+  return retVal;
+}
+
+// Returns the ASCII code of the next byte in the receive buffer. The byte remains in the buffer! Returns -1 if there is no byte in the buffer.
+int SerialWS::peek(void){
+  int retVal = -1;
+  if((_rxBufferSize > 0) && !(_rx_buffer_head == _rx_buffer_tail)){
+    retVal = (int)_rx_buffer[_rx_buffer_tail];
+  }
+  return retVal;
+}
+
+// Returns the ASCII code of the next byte in the receive buffer. The byte is removed from the buffer. Returns -1 if there is no byte in the buffer.
+int SerialWS::read(void){
+  int retVal = peek();
+  if(retVal >= 0)
+    _rx_buffer_tail = (_rx_buffer_tail + 1) % _rxBufferSize;
+  return retVal;
+}
+
+// Reads up to size/length bytes from the receive buffer. Bytes are removed from the buffer. The number of bytes read will be returned.
+// The data is copied in at most two blocks (tail to end of ring, then start of ring) instead of byte by byte.
+int SerialWS::read(uint8_t *buffer, int size){
+  int cnt = available();
+  if(cnt > size) cnt = size;
+  if(cnt <= 0) return 0;
+  size_t first = _rxBufferSize - _rx_buffer_tail;                  // Bytes from tail up to the physical end of the ring
+  if(first > (size_t)cnt) first = cnt;
+  memcpy(buffer, _rx_buffer + _rx_buffer_tail, first);
+  if(first < (size_t)cnt)                                          // Wrapped? Copy the rest from the start of the ring
+    memcpy(buffer + first, _rx_buffer, cnt - first);
+  _rx_buffer_tail = ringAdvance(_rx_buffer_tail, cnt, _rxBufferSize);
+  return cnt;
+}
+
+// Clears the buffer(s). No processing of any data will be done!
+void SerialWS::flush(void){
+  flushRecv();
+  flushSend();
+}
+void SerialWS::flushRecv(void){
+  if(_rxBufferSize  > 0){
+    _rx_buffer_head = 0;
+    _rx_buffer_tail = 0;
+  }
+}
+void SerialWS::flushSend(void){
+  if(_txBufferSize  > 0){
+    _tx_buffer_head = 0;
+    _tx_buffer_tail = 0;
+  }
+}
+
+void SerialWS::cleanupClients(void){
+  _ws.cleanupClients();
+}
+
+// Sends any data in the transmit buffer to all clients.
+// Normally the ring is copied (in at most two blocks) straight into a message buffer owned by AsyncWebSocket.
+// That one buffer is shared by all clients, so no intermediate copy on the stack is necessary.
+// If any client is stalled, each client is served separately so the stalled ones can be held back.
+void SerialWS::send(){
+  size_t cnt = awaitingSend();
+  if(cnt == 0) return;
+  bool stalled = false;
+  for(int c = 0; c < SerialWSmaxClients; c++){
+    if(_clients[c].id == 0) continue;
+    AsyncWebSocketClient *client = _ws.client(_clients[c].id);
+    if(client && ((_clients[c].used > 0) || client->queueIsFull())){
+      stalled = true;
+      break;
+    }
+  }
+  size_t first = _txBufferSize - _tx_buffer_tail;                  // Bytes from tail up to the physical end of the ring
+  if(first > cnt) first = cnt;
+  if(!stalled){
+    AsyncWebSocketMessageBuffer *msg = _ws.makeBuffer(cnt);       // Released by AsyncWebSocket once sent to all clients
+    if(msg){
+      memcpy(msg->get(), _tx_buffer + _tx_buffer_tail, first);
+      if(first < cnt)                                              // Wrapped? Copy the rest from the start of the ring
+        memcpy(msg->get() + first, _tx_buffer, cnt - first);
+      _ws.textAll(msg);
+      _framesSent += _ws.count();
+      _bytesCoalesced += cnt;
+    }
+  } else {
+    uint8_t *msg = (uint8_t*)malloc(cnt);                          // Heap, not stack. Only used while a client is stalled
+    if(msg){
+      memcpy(msg, _tx_buffer + _tx_buffer_tail, first);
+      if(first < cnt)
+        memcpy(msg + first, _tx_buffer, cnt - first);
+      deliver(msg, cnt);
+      free(msg);
+      _bytesCoalesced += cnt;
+    }
+  }
+  flushSend();                                                     // If no message buffer could be allocated, the data is lost
+}
+
+// Sends a binary frame to all clients, in a message buffer shared by all of them like send().
+// Binary data is never held back in a backlog: a stalled client misses it.
+size_t SerialWS::binary(const uint8_t *data, size_t len){
+  if((len == 0) || (_ws.count() == 0)) return 0;
+  send();                                                          // Text written before goes out first
+  AsyncWebSocketMessageBuffer *msg = _ws.makeBuffer(len);         // Released by AsyncWebSocket once sent to all clients
+  if(msg == NULL) return 0;
+  memcpy(msg->get(), data, len);
+  _ws.binaryAll(msg);
+  _framesSent += _ws.count();
+  return len;
+}
+
+// Sends data to each client that can take it and adds it to the backlog of each client that can't.
+void SerialWS::deliver(uint8_t *data, size_t len){
+  for(int c = 0; c < SerialWSmaxClients; c++){
+    if(_clients[c].id == 0) continue;
+    AsyncWebSocketClient *client = _ws.client(_clients[c].id);
+    if(!client) continue;                                          // Already gone. The disconnect event will clear the slot
+    if((_clients[c].used == 0) && !client->queueIsFull()){
+      client->text((char*)data, len);
+      _framesSent++;
+    } else
+      backlog(c, data, len);
+  }
+}
+
+// Adds data to the backlog of client slot c, dropping the oldest or newest bytes once the backlog is full.
+void SerialWS::backlog(int c, uint8_t *data, size_t len){
+  if(_backlogSize == 0){                                           // No backlog. The client simply misses this data
+    _bytesDropped += len;
+    return;
+  }
+  if(_clients[c].backlog == NULL){
+    _clients[c].backlog = (uint8_t*)malloc(_backlogSize);
+    _clients[c].used = 0;
+    if(_clients[c].backlog == NULL){
+      _bytesDropped += len;
+      return;
+    }
+  }
+  size_t room = _backlogSize - _clients[c].used;
+  if(_dropOldest){
+    if(len >= _backlogSize){                                       // New data alone fills the backlog. Keep only its newest bytes
+      _bytesDropped += _clients[c].used + len - _backlogSize;
+      memcpy(_clients[c].backlog, data + len - _backlogSize, _backlogSize);
+      _clients[c].used = _backlogSize;
+      return;
+    }
+    if(len > room){                                                // Shift out just enough of the oldest bytes
+      size_t drop = len - room;
+      memmove(_clients[c].backlog, _clients[c].backlog + drop, _clients[c].used - drop);
+      _clients[c].used -= drop;
+      _bytesDropped += drop;
+    }
+  } else if(len > room){                                           // Drop newest: keep what fits
+    _bytesDropped += len - room;
+    len = room;
+  }
+  memcpy(_clients[c].backlog + _clients[c].used, data, len);
+  _clients[c].used += len;
+}
+
+// Write a single byte
+size_t SerialWS::write(uint8_t b){
+  return write(&b, 1);
+}
+
+// Write a block of bytes
+// Bytes are copied into the ring in at most two blocks. Whenever the ring is full, it is sent and writing continues.
+size_t SerialWS::write(uint8_t *buffer, size_t size){
+  if(_txBufferSize  > 0){                                          // If buffering
+    if((size > 0) && (_tx_buffer_head == _tx_buffer_tail))         // Buffer was empty, so this is now the oldest waiting byte
+      _pendingSince = millis();
+    size_t done = 0;
+    while(done < size){
+      size_t room = _txBufferSize - 1 - awaitingSend();            // One slot always stays empty to tell full from empty
+      if(room == 0){                                               // If buffer is full
+        send();                                                    // send it and continue with an empty buffer
+        room = _txBufferSize - 1;
+        _pendingSince = millis();
+      }
+      size_t cnt = size - done;
+      if(cnt > room) cnt = room;
+      size_t first = _txBufferSize - _tx_buffer_head;              // Bytes from head up to the physical end of the ring
+      if(first > cnt) first = cnt;
+      memcpy(_tx_buffer + _tx_buffer_head, buffer + done, first);
+      if(first < cnt)                                              // Wrapped? Copy the rest to the start of the ring
+        memcpy(_tx_buffer, buffer + done + first, cnt - first);
+      _tx_buffer_head = ringAdvance(_tx_buffer_head, cnt, _txBufferSize);
+      done += cnt;
+    }
+  }else{                                                           // Not buffering. Direct write! (bad idea as bad performance to broadcast single bytes!)
+    _ws.textAll(buffer, size);
+  }
+  return size;
+}
+
+// Handles SerialWS web socket events
+void SerialWS::onSerialWsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len){
+  switch(type){
+  case WS_EVT_CONNECT:
+    for(int c = 0; c < SerialWSmaxClients; c++){                   // Remember the client in the first empty slot
+      if(_clients[c].id == 0){
+        _clients[c] = {client->id(), NULL, 0};
+        break;
+      }
+    }
+    break;
+  case WS_EVT_DISCONNECT:
+    for(int c = 0; c < SerialWSmaxClients; c++){                   // Forget the client and release its backlog
+      if(_clients[c].id == client->id()){
+        free(_clients[c].backlog);
+        _clients[c] = {0, NULL, 0};
+        break;
+      }
+    }
+    break;
+  case WS_EVT_ERROR:
+    break;
+  case WS_EVT_PONG:
+    break;
+  case WS_EVT_DATA:
+    // Data has been received by the SerialWS websocket
+    if(_rxBufferSize > 0){                                         // Else, if there is a receive buffer
+      size_t used = (_rxBufferSize + _rx_buffer_head - _rx_buffer_tail) % _rxBufferSize;
+      size_t cnt = _rxBufferSize - 1 - used;                       // Room left. One slot always stays empty to tell full from empty
+      if(cnt > len) cnt = len;                                     // If the buffer fills up, the rest of the data is abandoned
+      size_t first = _rxBufferSize - _rx_buffer_head;              // Bytes from head up to the physical end of the ring
+      if(first > cnt) first = cnt;
+      memcpy(_rx_buffer + _rx_buffer_head, data, first);
+      if(first < cnt)                                              // Wrapped? Copy the rest to the start of the ring
+        memcpy(_rx_buffer, data + first, cnt - first);
+      _rx_buffer_head = ringAdvance(_rx_buffer_head, cnt, _rxBufferSize);
+    }
+  }
+}
@@ -0,0 +1,227 @@
+// Hot asset cache
+// Without it every page, .css, .js or image request opens a file on LittleFS or SD. That is slow on SD, and a page load
+// quickly uses up the few file handles available (see SDmaxOpenFiles/MMCmaxOpenFiles in customize.h).
+// Files up to AssetCacheMaxFileKB are kept in PSRAM instead, up to AssetCacheKB in total. When the cache is full
+// the least recently used file is dropped. Files are loaded on first request or preloaded at boot from a manifest.
+// Files that can't be cached (too big or not there) are remembered too, so they go straight to the file system.
+// File manager uploads, deletes and new directories invalidate the affected entries (see staticFileChanged).
+// Entries are keyed by file system (FSUsageLittleFS or FSUsageSD) and path within that file system. A file
+// and its .gz/.br siblings are separate entries. StaticFiles decides which of them is sent.
+// Without PSRAM the cache stays disabled and everything is served from the file systems as before.
+
+#if UseAssetCache
+
+typedef struct {int fs;                           // File system of this entry (FSUsageLittleFS or FSUsageSD)
+                char path[StaticPathLen];         // Path within the file system. Empty if the slot is free
+                uint8_t *data;                    // File contents in PSRAM. NULL if the file can't be cached
+                size_t len;                       // Bytes in data
+                bool stale;                       // Invalidated while still being sent. Freed once the last response is done
+                uint16_t inUse;                   // Number of responses still sending data
+                uint32_t used;                    // Tick of the last use, for LRU replacement
+               } AssetEntry;
+AssetEntry assetCache[AssetCacheFiles];
+size_t assetBytes = 0;                            // Bytes of PSRAM used by the cache
+size_t assetBudget = 0;                           // Bytes of PSRAM the cache may use. 0 if disabled
+uint32_t assetTick = 0;                           // Incremented on every use
+uint32_t assetHits = 0;                           // Requests served from the cache
+uint32_t assetMisses = 0;                         // Requests that had to go to the file system
+uint32_t assetGeneration = 0;                     // Incremented on every invalidation, so a file read meanwhile isn't cached
+SemaphoreHandle_t assetMutex = NULL;              // Protects the cache. It is used by the async webserver, file manager and setup
+
+// Initializes the cache and preloads the files listed in AssetCachePreload. Call after the file systems were mounted.
+// Each line of the manifest is a file system name and a path, such as LittleFS:/Main.htm or SD:/style.css
+// The .gz and .br siblings of a file are preloaded too, if there are any.
+void initAssetCache(){
+  assetMutex = xSemaphoreCreateMutex();
+  memset(assetCache, 0, sizeof(assetCache));
+  if(!psramFound()) return;                                           // Without PSRAM the cache stays disabled
+  assetBudget = (size_t)AssetCacheKB * 1024;
+  FS *fs = staticFS(StandardFiles == onSD ? FSUsageSD : FSUsageLittleFS);
+  if((fs == NULL) || !fs->exists(AssetCachePreload)) return;
+  File manifest = fs->open(AssetCachePreload, "r");
+  int preloaded = 0;
+  while(manifest.available()){
+    String line = manifest.readStringUntil('\n');
+    line.trim();
+    int colon = line.indexOf(':');
+    if((line.length() == 0) || (line[0] == '#') || (colon < 0)) continue;
+    int fsNum = fsUsageNum(line.substring(0, colon).c_str());
+    String path = line.substring(colon + 1);
+    StaticInfo info;
+    if(!staticLookup(fsNum, path.c_str(), info)) continue;
+    if(info.exists[StaticPlain] && assetCacheLoad(fsNum, path.c_str())) preloaded++;
+    if(info.exists[StaticGz] && assetCacheLoad(fsNum, (path + ".gz").c_str())) preloaded++;
+    if(info.exists[StaticBr] && assetCacheLoad(fsNum, (path + ".br").c_str())) preloaded++;
+  }
+  manifest.close();
+  assetHits = assetMisses = 0;                                        // Only count requests
+#if serialEnabled && setupVerbose
+  char buff[60];
+  sprintf(buff, "Asset cache: %i files preloaded\n", preloaded);
+  serialPrint(buff, true);
+#endif
+}
+
+// Finds an entry. Mutex must be held. -1 if not cached
+int assetFind(int fs, const char *path){
+  for(int i = 0; i < AssetCacheFiles; i++)
+    if((assetCache[i].path[0] != 0) && !assetCache[i].stale && (assetCache[i].fs == fs) && (strcmp(assetCache[i].path, path) == 0))
+      return i;
+  return -1;
+}
+
+// Frees an entry. Mutex must be held
+void assetFree(int i){
+  if(assetCache[i].data){
+    free(assetCache[i].data);
+    assetBytes -= assetCache[i].len;
+  }
+  memset(&assetCache[i], 0, sizeof(AssetEntry));
+}
+
+// Finds a slot for len more bytes, dropping least recently used entries as needed. Mutex must be held. -1 if there is no room
+int assetMakeRoom(size_t len){
+  while(true){
+    int victim = -1;
+    int freeSlot = -1;
+    for(int i = 0; i < AssetCacheFiles; i++){
+      if(assetCache[i].path[0] == 0){
+        if(freeSlot < 0) freeSlot = i;
+      } else if((assetCache[i].inUse == 0) && ((victim < 0) || (assetCache[i].used < assetCache[victim].used))){
+        victim = i;
+      }
+    }
+    if((freeSlot >= 0) && (assetBytes + len <= assetBudget)) return freeSlot;
+    if(victim < 0) return -1;                                         // Everything left is still being sent
+    assetFree(victim);
+  }
+}
+
+// Records a file that can't be cached (too big, a directory or not there), but only in a free slot: requests for
+// missing files must not push out cached ones. Mutex must be held
+void assetRememberUncacheable(int fs, const char *path){
+  for(int i = 0; i < AssetCacheFiles; i++){
+    if(assetCache[i].path[0] != 0) continue;
+    assetCache[i].fs = fs;
+    strcpy(assetCache[i].path, path);
+    assetCache[i].used = ++assetTick;
+    return;
+  }
+}
+
+// Makes sure a file is in the cache, loading it if necessary. Returns true if it can be served from the cache.
+// The file is read without holding the mutex, so a slow SD card doesn't hold up requests for cached files. If the
+// PSRAM or the read fails, nothing is recorded and the next request tries again.
+bool assetCacheLoad(int fs, const char *path){
+  if((assetBudget == 0) || (strlen(path) >= StaticPathLen)) return false;
+  FS *fileSys = staticFS(fs);
+  if(fileSys == NULL) return false;
+  xSemaphoreTake(assetMutex, portMAX_DELAY);
+  int i = assetFind(fs, path);
+  if(i >= 0){
+    bool cached = (assetCache[i].data != NULL);
+    if(cached) assetHits++;
+    else assetMisses++;                                               // Known to be uncacheable
+    xSemaphoreGive(assetMutex);
+    return cached;
+  }
+  assetMisses++;
+  uint32_t generation = assetGeneration;
+  xSemaphoreGive(assetMutex);
+
+  File file;
+  if(fileSys->exists(path)) file = fileSys->open(path, "r");
+  bool cacheable = file && !file.isDirectory() && (file.size() <= (size_t)AssetCacheMaxFileKB * 1024);
+  uint8_t *data = NULL;
+  size_t len = 0;
+  if(cacheable){
+    len = file.size();
+    data = (uint8_t *)heap_caps_malloc(len > 0 ? len : 1, MALLOC_CAP_SPIRAM);
+    if(data && (file.read(data, len) != len)){
+      free(data);
+      data = NULL;
+    }
+  }
+  if(file) file.close();
+  if(cacheable && (data == NULL)) return false;                       // Out of PSRAM or read error. Try again next time
+
+  xSemaphoreTake(assetMutex, portMAX_DELAY);
+  bool cached = false;
+  if(generation != assetGeneration){
+    // Invalidated while it was read. What was read may be out of date already, leave it to the next request
+  } else if((i = assetFind(fs, path)) >= 0){
+    cached = (assetCache[i].data != NULL);                            // Loaded by another request in the meantime
+  } else if(!cacheable){
+    assetRememberUncacheable(fs, path);
+  } else if((i = assetMakeRoom(len)) >= 0){                           // No room right now. Try again on the next request
+    assetCache[i].fs = fs;
+    strcpy(assetCache[i].path, path);
+    assetCache[i].data = data;
+    assetCache[i].len = len;
+    assetCache[i].used = ++assetTick;
+    assetBytes += len;
+    data = NULL;
+    cached = true;
+  }
+  xSemaphoreGive(assetMutex);
+  if(data) free(data);
+  return cached;
+}
+
+// Creates a response sending a file from the cache. Call assetCacheLoad first. Returns NULL if it isn't cached (anymore),
+// the caller has to send it from the file system then.
+AsyncWebServerResponse *assetCacheResponse(AsyncWebServerRequest *request, int fs, const char *path, const char *mime){
+  if(assetBudget == 0) return NULL;
+  xSemaphoreTake(assetMutex, portMAX_DELAY);
+  int i = assetFind(fs, path);
+  if((i < 0) || (assetCache[i].data == NULL)){
+    xSemaphoreGive(assetMutex);
+    return NULL;
+  }
+  assetCache[i].inUse++;                                              // The data must stay put until the response is done
+  assetCache[i].used = ++assetTick;
+  AsyncWebServerResponse *response = request->beginResponse_P(200, mime, assetCache[i].data, assetCache[i].len);
+  xSemaphoreGive(assetMutex);
+  request->onDisconnect([i](){ assetRelease(i); });
+  return response;
+}
+
+// A response sending entry i is done
+void assetRelease(int i){
+  xSemaphoreTake(assetMutex, portMAX_DELAY);
+  if(assetCache[i].inUse > 0) assetCache[i].inUse--;
+  if(assetCache[i].stale && (assetCache[i].inUse == 0)) assetFree(i);
+  xSemaphoreGive(assetMutex);
+}
+
+// Drops a file, or everything below a directory, from the cache. Use staticFileChanged, it takes care of the siblings too
+void assetCacheInvalidate(int fs, const char *path){
+  if((assetMutex == NULL) || (fs < 0)) return;
+  size_t len = strlen(path);
+  xSemaphoreTake(assetMutex, portMAX_DELAY);
+  assetGeneration++;
+  for(int i = 0; i < AssetCacheFiles; i++){
+    if((assetCache[i].path[0] == 0) || (assetCache[i].fs != fs)) continue;
+    if((strcmp(assetCache[i].path, path) == 0) ||
+       ((strncmp(assetCache[i].path, path, len) == 0) && (assetCache[i].path[len] == '/'))){
+      if(assetCache[i].inUse > 0) assetCache[i].stale = true;         // Still being sent, free it when done
+      else assetFree(i);
+    }
+  }
+  xSemaphoreGive(assetMutex);
+}
+
+// Adds the cache statistics to the status
+void assetCacheStatus(Print &out){
+  if(assetBudget == 0){
+    out.print("Asset cache: disabled (no PSRAM)\n");
+    return;
+  }
+  int files = 0;
+  for(int i = 0; i < AssetCacheFiles; i++)
+    if(assetCache[i].data) files++;
+  out.printf("Asset cache: %u hits, %u misses, %uKB of %uKB in %i files\n",
+    assetHits, assetMisses, assetBytes / 1024, assetBudget / 1024, files);
+}
+
+#endif
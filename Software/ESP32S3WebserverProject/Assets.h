@@ -0,0 +1,637 @@
+// Generated by Software/Tools/bundleAssets.py from the HTML directory. Do not edit!
+// Run the bundler again after changing any of these pages.
+
+#if embedMain
+// Main.htm: 2989 bytes, 1306 gzipped
+const uint8_t main_htm_gz[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0xFF,0x95,0x56,0x6D,0x6F,0xDB,0x36,0x10,0xFE,0x1E,0x20,
+  0xFF,0x81,0x55,0x31,0xD8,0x46,0x6C,0x4B,0x76,0x83,0xA2,0xB0,0xEC,0x00,0x5D,0x9B,0x61,0x29,0xD6,0xA6,
+  0x80,0x8B,0x05,0x43,0xD7,0x0F,0xB4,0x78,0xB2,0xD8,0x52,0xA4,0x4B,0xD2,0xD6,0x5C,0xC3,0xFF,0x7D,0x47,
+  0x52,0xB2,0x9D,0x44,0x29,0x36,0xC3,0x80,0xA4,0x23,0xEF,0xB9,0xBB,0xE7,0x5E,0xC8,0xE9,0xB3,0xB7,0xB7,
+  0x6F,0x3E,0xFD,0xF5,0xF1,0x9A,0x14,0xB6,0x14,0x57,0xE7,0x67,0x53,0xF7,0x24,0x82,0xCA,0xE5,0x2C,0x02,
+  0x19,0x65,0x82,0x1A,0x33,0xFB,0x6A,0x06,0xB9,0xCA,0xD6,0x66,0xB0,0xE1,0x86,0x2F,0x04,0xF8,0x7D,0x40,
+  0x99,0x7B,0x5A,0x6E,0x51,0x30,0x8D,0xC3,0x13,0x05,0xC6,0x6E,0x05,0x10,0xBB,0x5D,0xC1,0x2C,0xB2,0xF0,
+  0x8F,0x8D,0x33,0x63,0xA2,0x2B,0x07,0xDB,0x5F,0x28,0xB6,0xDD,0x15,0xC0,0x97,0x85,0x9D,0x8C,0x92,0xE4,
+  0x97,0xB4,0xA4,0x7A,0xC9,0xE5,0x24,0x49,0xF7,0xCF,0x2B,0x4D,0x57,0x2B,0xD0,0xBB,0x92,0xCB,0xC1,0xE9,
+  0x96,0xFD,0x34,0xF6,0x88,0x0E,0x3A,0x6E,0x8C,0x3A,0x20,0xE2,0xC5,0xB3,0x28,0x53,0x42,0xE9,0xC9,0xF3,
+  0xC4,0xFF,0xD2,0x05,0xCD,0xBE,0x2D,0xB5,0x5A,0x4B,0x36,0xA8,0x17,0x7E,0xF3,0xBF,0x28,0xCD,0x95,0xB4,
+  0x83,0x9C,0x96,0x5C,0x6C,0x27,0x9D,0x3F,0x41,0x33,0x2A,0x69,0xA7,0xDF,0x79,0xAD,0x39,0x15,0x9D,0xBE,
+  0xA1,0xD2,0x0C,0x0C,0x68,0x9E,0xA7,0x91,0xB3,0xC0,0xF8,0xA6,0x31,0xC0,0xB8,0x59,0x09,0xBA,0x9D,0x58,
+  0x8A,0xA1,0xA7,0xA7,0xBE,0x55,0x9C,0xD9,0x22,0xBC,0x3A,0x25,0x42,0x9E,0x54,0x1B,0x64,0x20,0x44,0xBA,
+  0x01,0x6D,0x79,0x46,0xC5,0x80,0x0A,0xBE,0x94,0x93,0x92,0x33,0x86,0x88,0x8E,0xA4,0x5A,0x92,0x81,0xB4,
+  0xA0,0x6B,0x30,0x32,0x2D,0x46,0x84,0x33,0x44,0xA2,0x36,0xAA,0x51,0x7D,0x10,0x86,0xFF,0x80,0xC9,0xF8,
+  0x72,0x65,0xD3,0xAB,0x64,0x14,0xE3,0x7F,0x9C,0x8C,0x5F,0x20,0x39,0xE3,0xFB,0x6A,0x96,0x97,0x8F,0xD5,
+  0x2E,0x5F,0x79,0xB5,0x64,0x92,0x24,0xD3,0x78,0x15,0x9C,0x8E,0xD1,0x6B,0x4F,0x6F,0xFD,0x34,0x99,0xE6,
+  0x2B,0x8B,0x6F,0x1B,0xAA,0xC9,0x5C,0x65,0xDF,0xC0,0xF6,0xB9,0xE4,0x16,0x89,0x42,0x08,0x36,0xCB,0xA9,
+  0x30,0x80,0x12,0x74,0x75,0x43,0xC5,0x0D,0x4B,0xCF,0xCF,0xAC,0xDE,0xEE,0x1C,0x16,0x18,0x17,0x2E,0x37,
+  0xC5,0xDD,0xBC,0xDB,0x43,0xF9,0x3E,0xA3,0x36,0x2B,0xBA,0xA0,0x75,0x6F,0x47,0x05,0x86,0xEF,0x5E,0x87,
+  0x25,0x18,0x43,0x97,0xD0,0x4B,0xF7,0xE7,0x67,0xE7,0x67,0x71,0x4C,0xBA,0x1A,0x7A,0x07,0x55,0x52,0xC1,
+  0x82,0x18,0x6F,0x96,0x64,0x4A,0x4A,0xC8,0x2C,0x57,0xF2,0xFC,0x2C,0x5F,0x4B,0xFF,0x76,0xDF,0x88,0x33,
+  0xDB,0x58,0x0F,0xBE,0xCE,0x24,0x54,0xE4,0x0E,0x16,0xE1,0xAB,0x1B,0x55,0x66,0x12,0xC7,0xD1,0x45,0xC5,
+  0x25,0x53,0xD5,0x50,0x28,0x74,0x09,0x51,0x86,0x85,0x32,0x56,0xD2,0x12,0x2E,0xA2,0xB8,0x32,0x91,0x73,
+  0xB6,0x01,0x18,0x2A,0xA9,0x56,0x20,0x67,0x8D,0xC1,0x2E,0x6C,0x6C,0x6F,0x77,0x37,0x57,0xF2,0x16,0xC5,
+  0xFE,0x6B,0x7F,0x7F,0x7B,0x26,0x94,0x81,0x96,0xFD,0x6F,0x9C,0xBC,0x4D,0xA1,0x66,0xA0,0x45,0xE5,0x7D,
+  0x58,0x69,0x53,0x42,0xEA,0x94,0x6E,0x51,0xB9,0x76,0xF2,0xA3,0x02,0x92,0x4A,0x4E,0x68,0x77,0x10,0x2D,
+  0xD4,0x87,0x8D,0x4D,0x02,0xEE,0xCC,0xAD,0x0F,0x8E,0x54,0x5C,0x08,0xB2,0x00,0x04,0x10,0x02,0x18,0xA9,
+  0x0A,0x94,0x51,0x97,0x91,0x47,0x09,0x21,0xDC,0x10,0x47,0x13,0xB0,0x93,0xD4,0xDC,0x23,0xC9,0x99,0xE6,
+  0x79,0xF7,0xD9,0x49,0xED,0x04,0x77,0x34,0x7C,0x5F,0x63,0x12,0x3F,0x40,0xF5,0x96,0x5A,0xF8,0xC4,0x4B,
+  0xE8,0x5A,0xBD,0x0E,0x4E,0x11,0xF4,0xE6,0x8D,0x06,0x94,0x13,0x8A,0x36,0xEA,0x22,0x23,0x58,0xCC,0xA0,
+  0x89,0x55,0xDE,0xB1,0x16,0x00,0x02,0xD8,0x5C,0x38,0x13,0x00,0x1D,0x64,0x0E,0xE6,0x58,0x9E,0x33,0x03,
+  0xF6,0xA6,0xFE,0xEA,0x1E,0xD8,0xEB,0xED,0x9E,0xF4,0x62,0xDF,0xC7,0x96,0x4E,0x82,0x37,0xA7,0x75,0xEF,
+  0x56,0x1F,0xF1,0x56,0x27,0xF9,0x7F,0x12,0xE7,0x0B,0xE6,0x21,0x71,0xC7,0x6A,0xF1,0x2C,0xA1,0xDB,0xCE,
+  0x29,0xB5,0xB6,0xA7,0x5E,0xDF,0xEF,0xB0,0xC6,0x55,0x4F,0xDB,0x1C,0xCD,0xD0,0x23,0x53,0x1A,0x8E,0x2D,
+  0x75,0x6A,0x5D,0x92,0xD1,0x81,0xA7,0x43,0x1C,0xC7,0xCA,0x6B,0x8B,0xC4,0x91,0x1B,0xA2,0x69,0x1A,0xB3,
+  0xAE,0x23,0x17,0x8B,0x86,0x0C,0xF8,0x06,0x77,0xE6,0x5A,0x95,0xC4,0x16,0x80,0xE8,0x1A,0x15,0x1E,0x44,
+  0x77,0x5A,0xD8,0x2E,0x3E,0x37,0x5C,0x0C,0x99,0x61,0xE2,0xEC,0x10,0x27,0x1C,0xED,0x13,0x2B,0xD2,0x50,
+  0x31,0xE6,0x73,0xF2,0x65,0x36,0xEB,0xEC,0x3A,0x81,0x08,0x22,0x9C,0x41,0xB3,0x7C,0x87,0xBB,0xDF,0xCD,
+  0x6F,0x3F,0x0C,0x57,0x54,0x07,0xA2,0xBC,0x62,0x48,0x14,0x6A,0xE3,0xF2,0x67,0xB7,0x6D,0x88,0xB3,0xBC,
+  0x02,0xDD,0xF7,0xEF,0x8E,0x8E,0x1F,0xD8,0x3B,0xE1,0x4B,0xDA,0x55,0x70,0xEE,0xB8,0x18,0xDE,0x32,0x55,
+  0x96,0x38,0x7C,0xBF,0xF8,0xFC,0x02,0xCE,0x37,0x6F,0xD9,0x63,0x9A,0x21,0x0E,0x72,0x8E,0x83,0xE4,0x6F,
+  0x19,0xD5,0x4C,0x5F,0xCF,0x3F,0xBE,0x18,0xE3,0x88,0x09,0x58,0x18,0xAF,0x64,0xA6,0xA1,0xC4,0x10,0x6A,
+  0x88,0x9B,0xE9,0x44,0x70,0x09,0xA6,0x4F,0x18,0x08,0x5E,0x72,0x8B,0x04,0x2D,0xB6,0xC4,0x81,0x0C,0xC9,
+  0xDC,0x01,0x7A,0xAA,0xFC,0x46,0xAC,0x55,0x85,0xF4,0x1A,0xAB,0xB9,0x5C,0x12,0xAA,0x35,0xDD,0xD6,0x7D,
+  0x6C,0x2A,0xEE,0x1A,0xD9,0x0A,0x64,0xA4,0xB7,0x0B,0x59,0xF6,0x22,0xB2,0xA0,0x58,0x40,0x04,0xB9,0x75,
+  0x28,0x39,0xD7,0x26,0xD8,0x23,0x2A,0x0F,0x98,0x5D,0x27,0x8F,0xDC,0x80,0x8B,0x88,0xD2,0x24,0xE2,0x0C,
+  0xC3,0xE3,0x39,0x07,0x1D,0xF9,0x3D,0xB8,0xDA,0xCC,0x02,0x3F,0x2F,0xB0,0x84,0x23,0xAC,0xB8,0xA6,0x15,
+  0xA2,0x89,0xAF,0xFE,0x1C,0x4D,0x0F,0x05,0xC8,0xA5,0x2D,0xAE,0x66,0x97,0xB5,0x07,0xAF,0xB1,0x9C,0x34,
+  0x66,0xDD,0x8A,0x2D,0xC9,0x95,0x2E,0xA9,0x75,0xC1,0x35,0x15,0x51,0xA9,0xB5,0x60,0xA4,0xA0,0x1B,0x20,
+  0x97,0x81,0x82,0xC6,0x27,0x9F,0x26,0xD4,0x77,0x36,0x62,0x47,0x7D,0xAD,0xED,0x8A,0x68,0x8B,0xBF,0xB2,
+  0x64,0xAC,0x28,0x4A,0x6E,0x8C,0xDF,0xC9,0xF0,0xCA,0xE1,0x72,0x32,0x5C,0x82,0xBD,0x16,0xE0,0x5E,0x7F,
+  0xDD,0xDE,0xB0,0xAE,0x3F,0x0F,0x7B,0x43,0x8E,0x15,0xAD,0x7F,0xFF,0xF4,0xFE,0x8F,0x19,0xB2,0xF3,0xE2,
+  0xCB,0xD0,0xAC,0x17,0x81,0xC0,0xEE,0xCB,0x3E,0xB9,0xEC,0x5D,0x74,0xE2,0xCE,0xC5,0xC3,0x95,0x57,0x7D,
+  0xF2,0xB2,0x7D,0x25,0x71,0x3A,0xE9,0xCF,0xED,0xBA,0x03,0xF5,0x67,0x76,0x47,0x08,0xF2,0x0A,0xE1,0x27,
+  0x8F,0xE1,0x47,0xE3,0x3E,0x19,0x25,0x61,0x8D,0x3C,0x5A,0xBC,0xC4,0xC5,0x71,0xB0,0xEE,0x92,0x4E,0x16,
+  0x38,0xFF,0xBE,0xB9,0x4F,0x06,0x39,0x5D,0x0B,0x3B,0x39,0x08,0xF6,0xF7,0x5B,0xD6,0x4F,0xFE,0xFF,0xD6,
+  0xB0,0xFE,0xF0,0x20,0x2A,0xCB,0xD6,0xDA,0x3C,0xE8,0xCC,0xE3,0xF9,0xB1,0x3B,0x82,0x33,0x35,0xC7,0xAA,
+  0xF6,0xB3,0x2A,0xC0,0x62,0x89,0xBA,0x3A,0x6F,0x1F,0x03,0xB8,0xF8,0x44,0xE3,0x07,0x9C,0x2E,0x36,0xD9,
+  0xE1,0xA8,0xAE,0x0F,0x34,0xD3,0xC8,0xD3,0x07,0x27,0x56,0xFB,0x45,0xA1,0x71,0xED,0x80,0xDD,0x72,0x08,
+  0x3C,0x60,0x02,0xEF,0x93,0x5C,0x31,0x77,0xE3,0xC2,0x4A,0x45,0x17,0x97,0x7E,0x40,0xBA,0xEB,0x01,0x3B,
+  0x96,0xE0,0x93,0x43,0xAB,0xE5,0x7C,0xF8,0x8A,0xE3,0xBE,0x39,0xD6,0xC2,0xFB,0x21,0xC0,0x68,0xD7,0xA9,
+  0x15,0x30,0xC7,0xCB,0x63,0x23,0x75,0xF6,0x51,0x08,0xD0,0x0D,0x15,0xAC,0x2E,0x72,0xA2,0x72,0xB2,0x2D,
+  0x6A,0x62,0xC4,0xEB,0x6E,0x73,0xFD,0x9A,0xC6,0xEE,0x9E,0x1B,0x2E,0xBE,0xEE,0x76,0xFE,0x2F,0x9D,0xB2,
+  0x4F,0x0A,0xAD,0x0B,0x00,0x00
+};
+#endif
+
+#if useSerialWS
+#if embedSerialWS
+// SerialWS.htm: 4893 bytes, 1979 gzipped
+const uint8_t serialws_htm_gz[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0xFF,0x9D,0x58,0x6D,0x73,0xDB,0x36,0x12,0xFE,0x9E,0x99,
+  0xFC,0x07,0x98,0x37,0x49,0x89,0x23,0x4D,0x49,0xB6,0x27,0xCD,0x59,0xA2,0x3C,0xAD,0x9D,0x4E,0x3D,0xE3,
+  0xD4,0x37,0xB5,0x7B,0x9E,0x1B,0xC7,0x1F,0x28,0x12,0x14,0x11,0x53,0x00,0x03,0x40,0x92,0x55,0x55,0xFF,
+  0xFD,0x76,0xC1,0x57,0xC9,0xB2,0xDB,0xDE,0x87,0x30,0x78,0xD9,0xF7,0x7D,0xB0,0xBB,0xF2,0xE8,0xE0,0xE2,
+  0xFA,0xFC,0xF6,0xBF,0xFF,0xFE,0x44,0x32,0x33,0xCB,0xC7,0xA3,0xF2,0xAB,0xCD,0x2A,0x67,0x63,0xC3,0x9E,
+  0x4C,0xA4,0x58,0xB4,0x56,0x4C,0xF3,0xDF,0xD9,0xA9,0x90,0x82,0x0D,0x53,0x29,0xCC,0x61,0x1A,0xCD,0x78,
+  0xBE,0x3A,0x75,0xCE,0xE5,0x5C,0x71,0xA6,0x9C,0xF2,0xD4,0x12,0x0D,0x4E,0x0A,0x33,0xDC,0x8C,0x7A,0xA5,
+  0x88,0xB7,0x6F,0x46,0x19,0x8B,0x92,0xF1,0xC8,0x70,0x03,0xDB,0x3B,0xFE,0x13,0xBF,0x61,0x8A,0x47,0x39,
+  0xA9,0xFE,0xBB,0x63,0x13,0xF2,0x59,0x0A,0x6E,0xA4,0x1A,0xF5,0x4A,0xA2,0x51,0xCF,0xB2,0x00,0xEB,0x44,
+  0x26,0x2B,0x22,0x45,0xA9,0x3E,0x74,0x94,0xFE,0xDD,0xA5,0x0E,0x5E,0xD4,0x96,0x11,0x9E,0x84,0x8E,0xB6,
+  0x92,0xAE,0xE7,0xC6,0xB1,0xFC,0xA1,0x73,0x0B,0xB7,0xC4,0x48,0xA2,0x99,0x48,0x1C,0x10,0x57,0x53,0x8F,
+  0x47,0x13,0x85,0xDC,0x5C,0x14,0x73,0x20,0x58,0x15,0x40,0x3B,0x99,0x1B,0x23,0x85,0x23,0xC5,0x79,0xCE,
+  0xE3,0x47,0x14,0x26,0x92,0xD2,0x34,0x50,0xB5,0x88,0xF2,0x39,0xD0,0xDC,0x54,0x72,0x2C,0xDF,0xF8,0xBD,
+  0x98,0xE8,0x62,0xD8,0xFD,0x92,0xB7,0x6F,0x3E,0xCF,0x73,0xC3,0x73,0x2E,0xD8,0x96,0xF0,0x38,0x63,0xF1,
+  0xE3,0x44,0x3E,0x39,0x68,0xE6,0xAC,0x26,0x01,0x65,0x71,0x16,0x89,0x69,0xEB,0xD1,0xAB,0xA2,0x6F,0x32,
+  0xB9,0x24,0x68,0x02,0xF9,0x99,0x6B,0x08,0xD3,0xEA,0x65,0x15,0x1A,0x48,0x2B,0xA2,0xBF,0xA5,0x04,0xB4,
+  0x8C,0x34,0xCB,0x59,0x6C,0x6C,0x40,0x41,0x17,0x17,0xD3,0x8E,0x04,0xCD,0x4C,0x2A,0xE3,0xB9,0xB6,0x62,
+  0x64,0x61,0xB8,0x14,0xA4,0x8A,0x4D,0xDF,0x19,0xFF,0x22,0x09,0xBA,0x45,0x4A,0xB6,0x51,0xAF,0x24,0xD8,
+  0x25,0x1C,0x00,0x21,0x5B,0xDA,0x10,0xD5,0x14,0xA0,0x75,0x9B,0xE6,0xC8,0x19,0x9F,0x47,0x0A,0x82,0x3F,
+  0x65,0x44,0x31,0x33,0x57,0xE2,0x25,0x69,0xC7,0xCE,0xF8,0x47,0x69,0x32,0x72,0xFE,0x2B,0x79,0x4F,0x7E,
+  0xB9,0x6A,0xC9,0x7A,0xA5,0x1F,0x28,0x3B,0xE1,0x0B,0xEB,0x4E,0x66,0x23,0xC2,0xE3,0x28,0x47,0xEC,0x90,
+  0x6D,0xF0,0x64,0x55,0xB8,0x60,0x9F,0x48,0x91,0xAF,0xBA,0x70,0x01,0xE2,0x1F,0xE6,0x46,0xEA,0x58,0xC9,
+  0x3C,0x7F,0x25,0xEA,0xE0,0xF8,0x95,0x8C,0x1F,0xF7,0x07,0xCC,0x92,0xB2,0xA4,0x09,0x3F,0x5A,0xF0,0x1A,
+  0x00,0xE3,0x5C,0xBB,0x83,0x06,0x7A,0xE7,0x39,0x8B,0xD4,0x56,0xF6,0x9D,0x8E,0xA4,0x51,0x0F,0x7C,0x7C,
+  0xE1,0x3D,0x5C,0x8A,0xBD,0x3E,0x95,0x4F,0xE0,0xAF,0xB8,0xA5,0x58,0xBC,0xF8,0x3B,0x6E,0xDD,0xF2,0x19,
+  0xD3,0x26,0x9A,0x15,0xFA,0x95,0x50,0xD9,0xFB,0x97,0x90,0xD5,0x88,0xBA,0x92,0x53,0x92,0xB3,0x05,0xCB,
+  0xBB,0xA8,0xB4,0x07,0xDB,0xAC,0x57,0x78,0xB4,0x1F,0x94,0x9F,0x94,0xC2,0x8A,0xF2,0x22,0x16,0xEF,0x22,
+  0x25,0xBA,0x68,0xDD,0x87,0xC5,0x4B,0x91,0xCA,0x57,0x00,0x78,0xC1,0x26,0xF3,0xE9,0x5E,0xE4,0xFD,0x59,
+  0x7E,0x8F,0x76,0xF2,0xFB,0x2B,0x8B,0x19,0x5F,0xB0,0xBD,0x29,0x86,0x34,0xF1,0x02,0x57,0x0B,0x04,0x02,
+  0xE4,0x83,0x19,0x9F,0x43,0xBD,0x84,0x14,0x43,0x51,0x4C,0xC2,0x34,0xCA,0x35,0x83,0x13,0xC3,0x14,0xC8,
+  0xBC,0x4C,0x7C,0xC0,0x8A,0x0E,0xEF,0x1D,0xC7,0x77,0xBE,0x08,0xFC,0x28,0xFB,0x81,0xF5,0x83,0x9F,0xCE,
+  0x0C,0x5C,0x3D,0x0C,0xDF,0xBE,0x99,0x42,0xF0,0xE4,0xD4,0x75,0x1C,0x0A,0x1B,0x4C,0xDB,0x24,0xE7,0x3A,
+  0xBB,0xBB,0x71,0x71,0x9F,0xCE,0x45,0x6C,0x7D,0x65,0xF9,0xE5,0x85,0xCB,0x72,0xBA,0x2E,0x1F,0x23,0x49,
+  0x20,0x55,0x33,0x26,0x4C,0x00,0xEC,0x9F,0x72,0x86,0xCB,0x1F,0x57,0x97,0x09,0x92,0x0C,0x37,0x5D,0xBE,
+  0xAE,0xC0,0xB5,0x51,0xAB,0x35,0xA0,0xBE,0xB4,0x3D,0x14,0x6C,0x89,0x45,0xBF,0xDC,0xB9,0xCE,0x52,0x9F,
+  0xF6,0x7A,0x8E,0xB7,0xE4,0x22,0x91,0xCB,0x20,0x97,0x71,0x84,0x12,0x82,0x4C,0x6A,0x23,0xA2,0x19,0xF3,
+  0x9C,0x5E,0x59,0x8D,0xEF,0x6E,0xAC,0xA9,0x95,0x94,0x60,0xC2,0x45,0xA4,0x56,0xB7,0x36,0xC2,0x50,0x31,
+  0xA2,0xD5,0x64,0x9E,0xA6,0xD8,0x88,0x5A,0x12,0x29,0x64,0xC1,0x44,0x58,0x1B,0xE5,0xB2,0x85,0xA1,0xEB,
+  0xBB,0x1B,0x29,0xAE,0xE1,0xD8,0xEE,0x36,0x5B,0xD4,0x71,0x2E,0x35,0xDB,0x43,0x7E,0x8E,0xE7,0x7B,0xE8,
+  0x01,0xED,0x1A,0x0A,0xD5,0x1E,0x8E,0xCF,0x7A,0xBA,0x87,0x9E,0x21,0x22,0xF7,0x50,0x03,0x52,0x5B,0xEA,
+  0x0D,0xF8,0x1F,0x67,0x2E,0xD0,0xD2,0x75,0x94,0x33,0x65,0x70,0x19,0x54,0xAA,0x6C,0x90,0xBB,0x71,0xDE,
+  0xF2,0x66,0xCD,0x53,0xF7,0xA0,0x83,0x0C,0x38,0xE8,0xC0,0xC4,0xA8,0x39,0x1B,0x6E,0x76,0x99,0x5B,0xDF,
+  0xD6,0xF0,0x9C,0xF0,0x05,0xCB,0xB9,0x71,0x1B,0x1B,0xE9,0x7A,0x1B,0x1A,0x1B,0x7F,0xD0,0xEF,0xF7,0xB7,
+  0x73,0xDD,0x75,0x78,0x1D,0x15,0x60,0x4D,0x82,0xFD,0xD7,0x75,0x11,0xFE,0x32,0x25,0x70,0x1E,0x24,0x91,
+  0x89,0x42,0x7C,0xFD,0x0A,0xFB,0x0A,0x3D,0xAB,0xCF,0x4E,0x73,0x39,0xB5,0xC4,0x08,0x8A,0x0B,0x38,0xF8,
+  0x0F,0x67,0x4B,0xB7,0xBE,0xA5,0xD4,0xB7,0x00,0x6C,0x0B,0x5A,0x7D,0xD0,0x94,0x26,0xFA,0xDC,0x96,0x3A,
+  0x9C,0xEB,0xEE,0x85,0x6D,0x81,0x08,0x42,0x7C,0x44,0xD2,0xCF,0xC2,0x0A,0x6F,0x5C,0x40,0x5A,0x7E,0x66,
+  0x7C,0x9A,0x99,0xC3,0xC1,0x51,0xDF,0x5F,0x6E,0x5D,0xDC,0xF1,0xC4,0x64,0x87,0xC7,0x7D,0x4C,0x8C,0x0C,
+  0xBB,0xB6,0xE0,0xB0,0x61,0xE1,0x28,0x03,0x3B,0xE7,0x04,0x4B,0x24,0x0D,0x97,0x9E,0x53,0x3C,0x59,0x0C,
+  0x42,0x2E,0x4A,0xFA,0xB6,0xEB,0xD3,0xA0,0xAA,0x99,0xD6,0x10,0x92,0x1D,0x86,0xFF,0xB2,0x92,0x1B,0x19,
+  0x99,0xB5,0x03,0xAA,0xD3,0x51,0xBF,0x92,0xB2,0x61,0xF0,0xB6,0xD7,0xFB,0x68,0x8E,0x1B,0x12,0x6B,0x44,
+  0x55,0x43,0xBB,0x86,0xD6,0x8D,0xED,0xAF,0x99,0xD9,0x9D,0x1C,0x76,0x0C,0xED,0x8A,0xB3,0x4D,0x94,0x56,
+  0xC2,0x12,0xAE,0x8B,0x3C,0x5A,0x41,0x89,0xCB,0x31,0x17,0xD6,0x97,0x2C,0x74,0x21,0x62,0x47,0xB4,0x77,
+  0xB4,0x6D,0xFF,0x9F,0x0B,0xC1,0xE1,0xB2,0xE3,0xD1,0x7E,0x7B,0x77,0xC2,0x90,0xB5,0x17,0xE1,0x2E,0x54,
+  0x86,0xFF,0x87,0x98,0x2E,0x64,0xBA,0x83,0x60,0x83,0x9C,0xE7,0x20,0xF0,0x59,0x58,0x44,0x4A,0xB3,0x4B,
+  0x61,0xAA,0x50,0x56,0xD3,0x13,0x0D,0x6C,0x89,0xB7,0x76,0x20,0xAF,0x79,0x32,0xA1,0x2C,0xCF,0x3C,0x2C,
+  0xD1,0xF7,0xEC,0xA1,0x53,0x1E,0x50,0x9B,0x0B,0x24,0x96,0xBC,0xF3,0x8A,0xE0,0xC8,0xDF,0xC9,0x67,0xF3,
+  0x28,0xAA,0xA9,0x83,0x56,0xAE,0x56,0x1D,0xA5,0x72,0xB0,0x45,0xC4,0xB6,0x53,0x75,0xBB,0x5D,0x3F,0xF3,
+  0xA4,0x61,0x01,0x86,0x5E,0x8F,0x60,0x0F,0x86,0xFA,0x0E,0xE3,0xBD,0x26,0x38,0x93,0x41,0x7B,0x8A,0x34,
+  0x29,0xEB,0x2E,0x49,0x15,0xD4,0x66,0x7D,0x4A,0xBE,0xBB,0xFA,0xCE,0x27,0x26,0x63,0xA2,0x21,0x85,0x17,
+  0xCF,0x13,0x68,0x70,0x64,0xA6,0xDD,0x13,0x0A,0x5D,0x5C,0xE0,0x26,0x52,0x53,0xED,0xC2,0x9A,0xFA,0x30,
+  0x2A,0x1A,0x18,0xD2,0xED,0xB0,0x18,0x89,0xC0,0xAA,0xBA,0x85,0x3C,0x28,0x92,0x4A,0x35,0x8B,0x0C,0x29,
+  0x8B,0x84,0x26,0xB1,0x9C,0x31,0xD0,0x23,0x67,0xA4,0x07,0x55,0x22,0x20,0x37,0xD5,0x39,0x17,0x56,0x1A,
+  0x7C,0xC0,0x20,0x94,0x3F,0x85,0x31,0x70,0xB2,0x32,0xB0,0x83,0x21,0x09,0x6C,0x21,0x30,0x20,0xA8,0x28,
+  0x86,0x7E,0xA8,0x7D,0x82,0x7D,0x71,0x0A,0x2B,0x72,0x62,0x69,0x74,0xD0,0x09,0x46,0xD5,0x03,0xBF,0xD1,
+  0x75,0xCA,0xB0,0xE8,0x3A,0xA8,0xC8,0xF1,0xBE,0xD1,0x00,0x3D,0x6A,0xAB,0xA0,0x2A,0x4B,0xAB,0x0A,0xE4,
+  0x23,0x35,0x99,0x82,0x69,0x5C,0x01,0x7E,0x22,0x33,0xD7,0xC3,0xAA,0x2F,0xAA,0xE0,0xAB,0xC6,0x72,0x39,
+  0xDC,0xEC,0xF2,0x7E,0x05,0xE1,0xD8,0x74,0xBF,0x06,0xA5,0x7B,0x7A,0x58,0xC6,0xBD,0x1C,0x66,0x2A,0x8C,
+  0xC0,0xAD,0xDD,0x23,0x7B,0x59,0xFF,0x3B,0x15,0x18,0x54,0x7F,0xA3,0x9D,0x76,0xBD,0xD9,0x2E,0x79,0xED,
+  0x14,0xB4,0xAE,0x89,0xCE,0xAC,0xB0,0xD0,0xF1,0xF6,0xA8,0xA2,0xC3,0x16,0x02,0x5B,0x72,0xEA,0x4A,0x9C,
+  0x34,0x60,0x87,0x2A,0xE3,0xF8,0x45,0x38,0xF0,0x79,0xE2,0xCF,0xB4,0x0F,0x91,0xAE,0x2A,0x86,0x9B,0x04,
+  0x18,0xCB,0x2B,0x1B,0xFA,0xD1,0x80,0xFE,0xF1,0x07,0x9C,0x80,0xF2,0xDF,0x20,0xD8,0x1F,0xDD,0x3E,0x3D,
+  0x08,0xBF,0xFF,0x40,0x69,0x15,0x1A,0x83,0x4C,0xCB,0x8C,0xE7,0xCC,0x2D,0xBC,0x8F,0xA3,0xB0,0xCB,0x5B,
+  0xD6,0x17,0x98,0xED,0x1A,0xF6,0xC1,0x07,0xB7,0xF0,0xB1,0x55,0xD1,0xE1,0x4C,0xB7,0xC7,0xC7,0x47,0xC0,
+  0x7C,0x54,0x5D,0x80,0x21,0xDB,0x0C,0xDE,0x87,0xEA,0xA6,0xF0,0xC2,0x8F,0xB6,0x0A,0x81,0x91,0x85,0x07,
+  0x74,0xE3,0x2D,0x6D,0x13,0x98,0x7F,0x1F,0xEB,0xFB,0x0A,0xFE,0xE5,0x3C,0xDA,0x56,0x3C,0xE3,0x85,0xEE,
+  0x4C,0xF7,0x6C,0x9B,0x0B,0x8C,0xFC,0x89,0x3F,0xB1,0xC4,0x3D,0xA6,0x9E,0x43,0xCA,0xFA,0x06,0xF7,0x10,
+  0xA9,0x4F,0x00,0xF6,0x95,0x0B,0x71,0xC1,0xBE,0x65,0xDD,0xFE,0x01,0x67,0x10,0x0C,0x8C,0x1D,0x43,0xFC,
+  0x02,0xC3,0x45,0x81,0x0D,0xC6,0x2E,0xCB,0x07,0xA6,0x55,0x01,0xC4,0xF2,0xD6,0x89,0xCD,0x4E,0x0E,0x1A,
+  0xC9,0x51,0x93,0x07,0x11,0xF6,0xFD,0x45,0xB8,0xD5,0x21,0xA3,0x5A,0x4F,0x64,0xFD,0xBB,0x4E,0x53,0xC8,
+  0x6A,0xB5,0xA9,0x9C,0xAD,0x72,0x75,0x80,0xE8,0xBB,0xE7,0xC9,0x43,0x9D,0x0F,0xA7,0x7E,0xD7,0x2B,0xE2,
+  0x78,0x3C,0x19,0xB6,0xD6,0xD4,0x94,0xF7,0x83,0x87,0x40,0x31,0x28,0xCA,0x31,0x73,0x7B,0xEF,0xDC,0xFB,
+  0x43,0x8F,0xFC,0xA3,0xFF,0xF0,0x4F,0xEA,0x7E,0x49,0xF0,0x13,0x7C,0x49,0x3C,0x7A,0xE6,0xDE,0xEB,0x84,
+  0xCF,0x9F,0xDE,0x3D,0xD0,0xDE,0xD4,0x6F,0xD0,0x3A,0xF3,0xD3,0xDC,0x5F,0xFA,0x85,0xF2,0xE3,0x32,0xB7,
+  0x68,0x3F,0x40,0xA7,0x0E,0x7A,0x0C,0x43,0xC0,0x3B,0xA7,0x31,0xE5,0x9D,0xD3,0xBD,0x80,0x34,0x58,0x1E,
+  0xDC,0x8B,0x71,0x18,0x05,0xE5,0xDB,0x6E,0xA8,0x4B,0x62,0x92,0x87,0xD1,0xBD,0x78,0x18,0x6A,0x1B,0x11,
+  0x84,0xEC,0x05,0x8B,0x65,0xC2,0x94,0x4B,0x83,0xC4,0xAE,0x20,0x3A,0x7A,0x3E,0xB1,0x43,0xA1,0x2B,0xBC,
+  0x81,0x0F,0xFF,0xBC,0x1C,0x8A,0xA4,0xF0,0x42,0x58,0x58,0x21,0x6D,0x5F,0xB2,0xCA,0xBC,0x93,0xF1,0x4B,
+  0xDA,0x74,0xE8,0x5A,0xE3,0x12,0x07,0x61,0x8E,0x2B,0x0E,0x05,0xF7,0x6C,0x81,0xF8,0xBB,0xB4,0xC0,0x14,
+  0x25,0xF8,0x4E,0x17,0x1D,0xB0,0x56,0x67,0xA8,0xF2,0xA4,0x91,0x83,0xCC,0x4F,0x30,0xFC,0x68,0xC0,0x55,
+  0x59,0xCC,0xDC,0xC1,0x07,0x7A,0xEA,0x38,0x9E,0x2E,0x8D,0xC2,0xCF,0xB2,0xED,0x26,0x4B,0xD0,0x58,0x0E,
+  0x08,0xE5,0xF3,0xD1,0x95,0x89,0xA3,0x25,0x05,0x69,0x69,0x0E,0x33,0x4A,0xC2,0x9E,0xAE,0x53,0xD7,0x39,
+  0x74,0xE8,0x38,0xEC,0x83,0x64,0x84,0xE9,0xA9,0xEB,0x6E,0x5D,0xF6,0xCB,0xCB,0xF7,0xEF,0xDD,0xF8,0xC0,
+  0x06,0x99,0x9E,0xC1,0x99,0xA7,0x4F,0x81,0xD6,0xD3,0x16,0x27,0x35,0x02,0xAC,0x1D,0x9B,0xDD,0x9E,0xD1,
+  0xED,0x46,0xBE,0x99,0xF8,0x3A,0xB7,0x79,0x32,0x93,0xAA,0x99,0x85,0xA6,0xC2,0x9A,0xCE,0xDB,0xC1,0x01,
+  0x6E,0xCB,0xDF,0x97,0xB7,0xD2,0x6D,0xD6,0x76,0x9E,0xF2,0x9B,0x6D,0x39,0x77,0x3D,0x1B,0x6A,0xF1,0x07,
+  0x52,0x8B,0x7E,0x13,0x55,0xD2,0x61,0x80,0x1C,0x80,0xDC,0xE8,0xD9,0x78,0xB3,0x69,0xEE,0x8F,0x3A,0xF7,
+  0x9D,0x41,0x00,0x09,0x4C,0xD4,0xED,0x8F,0x70,0x62,0x27,0xC2,0x21,0xFE,0x84,0x6E,0x7E,0x60,0x8D,0x7A,
+  0xF8,0xF7,0x26,0xBB,0xB0,0x7F,0x05,0x7B,0xFB,0xE6,0x7F,0x68,0x36,0x3A,0xFA,0x1D,0x13,0x00,0x00
+};
+#endif
+#endif
+
+#if embedAdmin
+// Admin.htm: 8659 bytes, 2435 gzipped
+const uint8_t admin_htm_gz[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0xFF,0xBD,0x1A,0x69,0x53,0xDB,0x48,0xF6,0x7B,0xAA,0xF2,
+  0x1F,0x1A,0x6D,0x0D,0x58,0xE5,0x13,0x03,0x59,0xD6,0xB6,0xBC,0xE5,0x10,0x52,0xA1,0x0A,0x08,0x35,0x64,
+  0x26,0xB5,0x93,0xE4,0x43,0x5B,0x6A,0xDB,0x3D,0x91,0x25,0x8F,0xBA,0x8D,0xE3,0x30,0xFC,0xF7,0x7D,0xAF,
+  0x0F,0x1D,0x46,0x3E,0x08,0xD9,0xA5,0xCA,0x20,0xF7,0xBB,0xEF,0xD7,0x4A,0x7A,0x7B,0x6F,0xDE,0x9F,0x7D,
+  0xF8,0xCF,0xCD,0x39,0x99,0xC8,0x69,0xD8,0x7F,0xF9,0xA2,0x87,0x7F,0x49,0x48,0xA3,0xB1,0xE7,0xB0,0xC8,
+  0xF1,0x43,0x2A,0x84,0xF7,0xA7,0xA8,0x8F,0x62,0x7F,0x2E,0xEA,0x77,0x5C,0xF0,0x61,0xC8,0x10,0x4F,0x72,
+  0x09,0x0F,0x1F,0xD9,0x50,0xB0,0xE4,0x8E,0x25,0xE4,0x2C,0x8E,0x46,0x7C,0x3C,0x4F,0xA8,0xE4,0x71,0xD4,
+  0x6B,0x6A,0x30,0xE0,0x09,0xB9,0x54,0x0F,0x0D,0x9F,0x4A,0x36,0x8E,0x93,0xE5,0xFD,0x28,0x8E,0x64,0x7D,
+  0xC1,0xF8,0x78,0x22,0x3B,0xC3,0x38,0x0C,0xBA,0xEA,0x40,0xF0,0xEF,0xAC,0x73,0xD4,0x9E,0x7D,0xEB,0x4A,
+  0xF6,0x4D,0xD6,0x69,0xC8,0xC7,0x51,0x27,0x64,0x23,0xD9,0x7D,0x78,0xF9,0x42,0x26,0xF7,0x19,0x52,0xFB,
+  0x04,0x90,0xE0,0xB0,0xD7,0xB4,0xBC,0x7B,0xC3,0x38,0x58,0x12,0xF5,0xCD,0x73,0xFC,0x38,0x8C,0x93,0xCE,
+  0x3F,0x5A,0xEA,0xA7,0x3B,0xA4,0xFE,0xD7,0x71,0x12,0xCF,0xA3,0xA0,0x6E,0x00,0x6F,0xD5,0x8F,0xA3,0xA5,
+  0x8E,0xE8,0x94,0x87,0xCB,0xCE,0xC1,0xEF,0x2C,0x09,0x68,0x44,0x0F,0x6A,0x07,0x83,0x84,0xD3,0xF0,0xA0,
+  0x26,0x68,0x24,0xEA,0x60,0x1A,0x1F,0x75,0x1D,0x90,0x40,0x7A,0x33,0xC2,0x03,0xCF,0x79,0xC7,0x68,0xC0,
+  0xA3,0xB1,0x63,0x64,0x4D,0x69,0x32,0xE6,0x51,0xA7,0xD5,0x9D,0xD1,0x00,0xCF,0xE1,0x29,0xD3,0xF3,0xB8,
+  0x05,0x7A,0xAE,0x1A,0xEB,0xAC,0x77,0xD9,0x4C,0xC9,0x99,0x52,0x1E,0xE1,0x03,0xE9,0x05,0xFC,0xCE,0xDA,
+  0x34,0x8C,0x93,0x80,0x25,0xF5,0x04,0x84,0xCF,0x45,0xE7,0x10,0x18,0x93,0x3D,0x3E,0x9D,0xC5,0x89,0xA4,
+  0x91,0xD4,0x0A,0x02,0x81,0xA4,0x10,0x1B,0x4B,0xB2,0xE0,0x81,0x9C,0x00,0x6A,0xEB,0x17,0x03,0x06,0x78,
+  0xD2,0xEF,0xC9,0x09,0x51,0x10,0xAF,0xDD,0xFA,0xA5,0x0F,0x61,0x9A,0xE4,0x8E,0x4E,0xD3,0xA3,0x26,0xA0,
+  0xE6,0x89,0x02,0xA2,0x13,0xC1,0xB1,0x41,0x44,0x2F,0x8B,0x19,0x8D,0x3C,0xA7,0xED,0xF4,0xDF,0xC5,0x42,
+  0x02,0x49,0x50,0x42,0xA7,0x60,0xE4,0x9A,0x4E,0x99,0x46,0xC0,0x0F,0x8F,0x66,0x73,0x49,0xE4,0x72,0x06,
+  0x5A,0x62,0xAC,0x1D,0xE5,0x58,0xC0,0x73,0x02,0x2A,0x69,0x3D,0x99,0xA3,0xFA,0x97,0xB5,0xE3,0xDA,0x51,
+  0xBB,0xFB,0xF6,0xAA,0x76,0x25,0xC6,0xB5,0x94,0x4B,0x87,0x5C,0xB2,0x68,0x0C,0x1A,0x1F,0xD7,0x01,0x7A,
+  0x7E,0xDE,0xBD,0x51,0x08,0x4E,0x1C,0xF9,0x13,0xC8,0x59,0x20,0xBC,0x83,0xCC,0x01,0x3E,0xAC,0x22,0x27,
+  0x5C,0xB8,0x4E,0x7F,0x9D,0x62,0xAF,0x93,0x98,0x06,0x3E,0x05,0xBE,0x83,0x9B,0x72,0xDD,0xFC,0x09,0xF3,
+  0xBF,0x0E,0xE3,0x6F,0x4A,0xBF,0x14,0x7D,0x3D,0xC7,0xC1,0x0D,0xB9,0x01,0x27,0x2D,0x20,0x56,0xE5,0x0C,
+  0x67,0x06,0xAA,0x18,0x0E,0x6E,0x2C,0x72,0xD1,0xEC,0xD3,0xDA,0xE1,0x2B,0x6B,0x76,0x8E,0x63,0x6A,0x78,
+  0x3C,0x22,0xA7,0x75,0x40,0x41,0xDB,0x6B,0x47,0xA5,0x98,0x17,0x91,0x98,0x8F,0x46,0xDC,0xE7,0x0C,0x92,
+  0xE3,0x19,0x3E,0xDA,0x18,0xF4,0x8F,0xFC,0x2D,0x5F,0xE7,0x09,0x84,0xED,0x12,0x74,0xC4,0xBB,0xBD,0xBD,
+  0x78,0xB3,0xDE,0xA7,0x8A,0xD3,0x13,0xBC,0x8A,0xF8,0xA9,0x5F,0x7F,0xC8,0xAE,0x41,0x30,0xE5,0xD1,0xDA,
+  0x10,0x23,0x70,0x17,0xCB,0x14,0x62,0x31,0xB0,0xAF,0xF2,0x81,0x4D,0xF9,0xE4,0xE3,0xFA,0xCA,0xC6,0xF5,
+  0x47,0x73,0x5A,0xB3,0x7D,0x4A,0x12,0x22,0xC1,0xCD,0x62,0x53,0x0A,0x16,0x58,0x6E,0xCB,0xC2,0x15,0xE4,
+  0x67,0x26,0x22,0x3C,0x50,0x3D,0x6D,0xE0,0x79,0x08,0x26,0x0E,0xE7,0x52,0xC6,0x91,0x09,0x9F,0xF9,0x02,
+  0xCC,0x42,0xEE,0x7F,0xF5,0x1C,0x41,0xEF,0xD8,0x1B,0x30,0xA3,0x02,0x7C,0x6E,0xE1,0xD9,0xB4,0xD7,0x5E,
+  0x53,0x23,0x66,0x5C,0x74,0x27,0x47,0x45,0xD6,0x77,0xF1,0x74,0x56,0xA8,0x21,0x92,0xF5,0xF4,0x43,0x98,
+  0x3D,0xA8,0xE6,0xAC,0x8F,0xAC,0x14,0xCB,0x19,0x59,0xCB,0xC6,0xE9,0x9F,0xA1,0xA1,0xF0,0x4C,0xFC,0x7C,
+  0xAF,0x87,0x7E,0x1B,0x86,0xC4,0xA7,0x73,0xC1,0x88,0x9C,0x40,0xCB,0xD6,0xF3,0x40,0xC6,0x24,0x61,0xC3,
+  0x38,0x96,0x05,0xFE,0x9B,0xBB,0xFA,0x8F,0x34,0xF5,0x5D,0xCA,0x00,0x3C,0xC9,0x48,0x93,0x7C,0xE0,0x36,
+  0xD5,0x57,0xA9,0xFB,0x08,0xFA,0x1E,0x47,0x8F,0x2A,0xC1,0x7A,0x83,0x47,0x75,0xAD,0xED,0x71,0x0B,0xE6,
+  0x95,0xB3,0x52,0x20,0x96,0x7A,0xB5,0xE7,0x9F,0xB4,0x4C,0x32,0xB5,0x6B,0x16,0x05,0xF3,0x48,0x25,0x4A,
+  0x96,0x42,0x6D,0xC8,0xA1,0xB3,0xDD,0x8A,0x23,0xAF,0x2E,0xB9,0x55,0x8E,0xDE,0x52,0xBB,0x88,0xA9,0x23,
+  0xB2,0x5A,0x16,0x47,0x27,0x05,0xE5,0x0C,0xBB,0x9F,0xA3,0x1F,0x3A,0xBC,0xA9,0xB8,0x56,0x96,0xF0,0x33,
+  0x9D,0x06,0xC1,0x64,0x32,0x9D,0x0A,0xE1,0x6E,0x51,0x17,0x09,0x91,0x2E,0xAF,0xEC,0x75,0xF7,0xB2,0x76,
+  0x78,0x9C,0x2A,0x9B,0xF2,0x7E,0x96,0xAA,0xC5,0x72,0xDC,0x58,0x8A,0x4C,0x5A,0xAD,0x54,0x35,0x32,0x49,
+  0x52,0x15,0x36,0xD4,0x63,0xFB,0xE7,0x14,0x64,0x13,0x16,0x27,0xB5,0x4A,0x35,0xCD,0x2E,0xD5,0x13,0x7E,
+  0xC2,0x67,0xB2,0x8F,0x7B,0xE4,0xF2,0xFE,0xE5,0x8B,0x3B,0x9A,0x90,0xDB,0xD8,0xFF,0xCA,0x64,0x8D,0x47,
+  0x5C,0xC2,0xBE,0x07,0x9C,0x02,0x6F,0x44,0x43,0xC1,0xBA,0x2F,0x5F,0xCC,0xC6,0x17,0x70,0x5A,0x71,0xE1,
+  0xF1,0x01,0x6A,0xC3,0x9F,0x54,0x58,0x92,0xB8,0xF7,0x34,0x64,0x89,0xC4,0xC7,0x06,0xA4,0x87,0xA0,0x63,
+  0xE6,0xE2,0x12,0x3A,0x9A,0x47,0xBE,0x2A,0x69,0x4B,0x05,0xFC,0x89,0x16,0x43,0x8C,0x10,0x2F,0x62,0x0B,
+  0x02,0x5B,0x9F,0xFE,0x56,0x71,0x16,0xA2,0xD3,0x6C,0x3A,0xD5,0x05,0x8F,0x82,0x78,0xD1,0x08,0x63,0x5F,
+  0xF5,0x84,0xC6,0x04,0x76,0x9C,0x08,0x26,0x42,0xD5,0x69,0x2E,0x84,0x83,0xD2,0x2D,0x83,0x46,0x1C,0xC5,
+  0x33,0x16,0x79,0x56,0x56,0x85,0xDD,0x49,0xF7,0xFE,0xE3,0x6D,0x1C,0xBD,0x87,0x63,0xF5,0xED,0xA1,0x88,
+  0xEE,0x87,0xB1,0x60,0x25,0xF8,0x67,0x78,0x5E,0x46,0x60,0x4C,0x2A,0x21,0xB9,0xD2,0x90,0x32,0x22,0xF0,
+  0x45,0x9C,0x94,0x90,0x9C,0xE3,0x79,0x46,0x00,0x5E,0x22,0x39,0x3F,0x06,0x70,0x93,0x98,0xC2,0x40,0x68,
+  0x8C,0x99,0x3C,0x0F,0x19,0x3E,0xBE,0x5E,0x5E,0x04,0x15,0xD5,0x91,0xDD,0x06,0x8F,0x80,0xEF,0xBB,0x0F,
+  0x57,0x97,0x5E,0xCE,0xD5,0xE8,0x69,0xB2,0x96,0x50,0xED,0x8E,0x6E,0x43,0x5D,0x51,0x74,0xD8,0x72,0x71,
+  0x29,0xB8,0x09,0xA3,0xC2,0x47,0x95,0xBD,0x5C,0xD8,0xD5,0x19,0x60,0x05,0xF1,0x2D,0x8B,0x80,0x19,0x30,
+  0x47,0x7E,0x90,0xB3,0x12,0x32,0xCF,0x06,0xA2,0x00,0x4F,0x2B,0x4E,0xC3,0xF2,0x39,0x24,0x93,0x39,0x33,
+  0x36,0xAF,0x2A,0x91,0xF9,0xFE,0x7E,0x15,0x94,0xF7,0x31,0xAA,0x83,0x09,0x2A,0x3C,0xF8,0xD6,0xC0,0x9A,
+  0xAE,0xC9,0xD0,0x13,0x0D,0x31,0x0B,0x21,0xBD,0x9C,0xCF,0x91,0x96,0x2A,0x16,0x1C,0x3D,0x2A,0xC3,0x4F,
+  0xAD,0x2F,0x8A,0x06,0x76,0x53,0x46,0xB0,0xF2,0x0A,0xDA,0x77,0x94,0x82,0x23,0xC0,0x6B,0x84,0x6A,0x72,
+  0x7B,0xDE,0xA9,0xB6,0x78,0xAB,0x3B,0xA1,0x19,0xCC,0x99,0x07,0x02,0x0E,0xBF,0x74,0x37,0x13,0x64,0xBB,
+  0xB1,0xDB,0x50,0x4B,0x33,0x3A,0x22,0xFC,0xD4,0xFE,0xE2,0x79,0xCE,0xA1,0xB3,0x85,0x38,0xB7,0x07,0xE7,
+  0x64,0x1E,0x6D,0x93,0x99,0xAE,0x8E,0x39,0xA2,0xE3,0x5D,0x88,0xCA,0xA4,0x9D,0x6C,0x23,0xD4,0xEB,0x5C,
+  0x8E,0xE2,0xD5,0x4E,0x14,0xB8,0x59,0xE5,0x88,0xFE,0x69,0x88,0x54,0x3C,0xC0,0xAD,0x7B,0x9E,0xE3,0x98,
+  0x60,0x64,0x8C,0xD4,0xC5,0x59,0xBB,0xBD,0xEA,0x14,0xAF,0x88,0xC6,0x95,0x1B,0x22,0x67,0x6E,0xA7,0xF9,
+  0x2A,0x2A,0x32,0xD6,0x1C,0xB0,0x9A,0xF4,0xAF,0x61,0xC2,0xE8,0xD7,0x6E,0x3E,0x7D,0xD2,0xE4,0x2E,0x49,
+  0x9D,0x93,0x6D,0xA9,0x93,0x4E,0xF5,0xA7,0xA4,0x4F,0x6E,0xDE,0xE6,0xC8,0xDA,0xDB,0xC8,0xB2,0x2A,0x7C,
+  0x94,0x36,0x65,0xA6,0x99,0x1A,0xD3,0x66,0xED,0xDC,0x83,0xA0,0xEE,0xE6,0x43,0x21,0x13,0xF0,0x6A,0xE5,
+  0x54,0x97,0x7B,0x39,0xDF,0xF6,0x76,0xC6,0xED,0x9D,0x39,0x07,0x6C,0x44,0xE7,0xA1,0xEC,0xA4,0x07,0x25,
+  0xED,0x24,0x6B,0xB2,0x2B,0xED,0xC4,0x34,0xAA,0xA9,0x18,0xA7,0xB3,0xC8,0x74,0x6C,0x61,0xCF,0xBB,0x3B,
+  0xB7,0x64,0x6D,0x9C,0xD8,0xD4,0x97,0xF3,0xD2,0xED,0x02,0x31,0x08,0xC3,0x0A,0xBE,0x75,0x99,0xA5,0xED,
+  0x0C,0xAF,0x1D,0xAA,0x3B,0xD6,0x82,0xF8,0x77,0x1A,0xA6,0xC3,0x16,0x17,0x63,0xB8,0x83,0xE3,0xDA,0x72,
+  0x21,0xD9,0x54,0x64,0xF9,0xFA,0xD7,0x9C,0x25,0xCB,0x5B,0x16,0x32,0x5F,0xC6,0x09,0x32,0x3C,0xF8,0x94,
+  0x6E,0x38,0x5F,0x0E,0x94,0xC7,0x52,0x2A,0xE8,0xFD,0xC9,0x39,0x05,0x73,0x2A,0xB0,0x52,0x27,0x78,0xE4,
+  0x7A,0xFD,0x7B,0x1D,0x90,0x82,0x34,0xDB,0x37,0x2D,0x5A,0x83,0x9B,0x01,0xA0,0xA2,0x99,0xE5,0x6F,0x27,
+  0xFD,0xAA,0x77,0x3C,0x73,0x50,0x2C,0x0E,0xCB,0x5D,0x59,0xEA,0x79,0x6D,0x53,0x9E,0x69,0xD4,0x48,0x1A,
+  0xC8,0x12,0xEC,0xC3,0x47,0xD8,0x0F,0xA6,0xE0,0x14,0x9A,0xD1,0x0A,0x87,0x55,0xBA,0x95,0xA5,0xB6,0xD9,
+  0xA6,0xA1,0x9C,0x3A,0xA2,0x3C,0x34,0xBC,0xD8,0x37,0x2E,0x57,0x2A,0xFC,0x41,0x3B,0x8A,0xC9,0x79,0x12,
+  0x29,0xFC,0x95,0xF1,0x98,0xDD,0x9A,0xCC,0x6C,0xCC,0x87,0xF0,0xD0,0x48,0xD2,0xF3,0x68,0x75,0xB8,0x7C,
+  0x36,0x0D,0x49,0x54,0xBD,0x9D,0x66,0x49,0xD5,0xB1,0x14,0xCA,0xC8,0xDD,0x87,0x89,0xAB,0x4C,0xBA,0x07,
+  0x39,0xCE,0x21,0xB2,0x50,0xC6,0x31,0x88,0x68,0x76,0xDE,0x4A,0xCF,0x37,0x69,0xF3,0x78,0xD6,0x64,0x3A,
+  0x6D,0xA2,0x5B,0x1D,0x36,0xBB,0x53,0xFD,0x98,0xBC,0xC2,0xB8,0x79,0x02,0x49,0x6E,0xDE,0x20,0xD5,0xE7,
+  0x96,0x53,0x5C,0x5E,0x84,0x5B,0xD2,0x4C,0x0A,0xCB,0x7A,0x49,0x12,0xB4,0x1F,0x25,0x81,0x45,0xDF,0x45,
+  0x2F,0xC4,0xFB,0x23,0x37,0x11,0x76,0xB3,0x26,0x57,0x78,0x4F,0xA2,0x5B,0x9D,0x09,0xBB,0x7B,0x21,0x2D,
+  0xB2,0x78,0xF8,0x67,0x61,0x87,0x47,0xB3,0x01,0xE8,0xC1,0xB9,0xE6,0x59,0x53,0x57,0x2C,0xFC,0x0A,0xD2,
+  0x07,0x12,0x3A,0x38,0x5C,0x68,0x58,0x25,0xBB,0x7E,0x39,0xAE,0x42,0x11,0x1E,0xFE,0xB6,0x7B,0x5B,0xD7,
+  0x9E,0xE2,0xA5,0xC3,0x6B,0xD5,0x72,0x0D,0x11,0x3A,0x32,0x2C,0x02,0x4A,0x47,0x68,0x63,0x15,0x80,0x76,
+  0x79,0x4F,0xE1,0x9A,0xC1,0xDB,0xE5,0xD5,0xAA,0x29,0x79,0xC3,0x42,0xB1,0x16,0x9F,0xF8,0x17,0xCB,0xBE,
+  0x66,0x76,0x51,0xDB,0xDF,0x0C,0x9E,0x5D,0x0E,0x4D,0x7B,0x1B,0x38,0x70,0xF3,0x78,0x1F,0x85,0x4B,0x32,
+  0x08,0x67,0x13,0x4A,0xFC,0x09,0x4D,0xA8,0x2F,0x59,0x22,0x08,0x0D,0xC3,0x78,0xC1,0x82,0x5C,0x5F,0xC1,
+  0x5F,0x64,0x7F,0x1F,0x21,0x0A,0x1B,0x93,0xC2,0x9A,0x60,0x14,0xEB,0x1F,0x92,0x7F,0x5B,0x95,0x60,0xCE,
+  0x77,0x1C,0xAB,0x45,0xBE,0x07,0x2A,0xC9,0xD7,0xA9,0xE4,0x6B,0x88,0x5C,0xC2,0xFD,0x9D,0x65,0x1B,0xFC,
+  0x67,0x49,0x1F,0x5C,0x17,0x0D,0x7F,0xAA,0x0E,0x79,0xA2,0x67,0x29,0xF2,0xDB,0x19,0x2A,0x02,0x4B,0x1D,
+  0x64,0xB6,0x24,0x2A,0x9D,0xF0,0xAD,0xCF,0x7C,0x36,0x63,0x89,0xC2,0xD0,0x64,0x98,0x6F,0x32,0xBE,0x84,
+  0x9B,0x61,0xC8,0x7E,0x43,0xD8,0x19,0x80,0x50,0xF0,0x1A,0xBE,0xC4,0xB9,0x2C,0x67,0x8C,0x36,0xAD,0x63,
+  0x7C,0x89,0xB0,0x2D,0x8C,0x9D,0x4B,0x64,0x6B,0xDE,0xF9,0x85,0x7C,0xCA,0xA5,0xD0,0x78,0xD0,0x23,0x56,
+  0x7D,0xE0,0xA6,0x5E,0xDB,0xDF,0x07,0x8E,0xF6,0xDC,0xCB,0x1C,0xD3,0x5D,0x47,0xDB,0x2E,0xA7,0xED,0xA5,
+  0xB4,0x76,0x19,0x7C,0xA4,0xDF,0xAF,0xA8,0xDF,0xAF,0xEC,0xAF,0x39,0x4F,0x58,0x40,0xA0,0x0F,0x24,0xCB,
+  0x95,0x10,0x16,0x94,0x69,0xAD,0x61,0x73,0x83,0x6C,0x6C,0xAF,0x26,0xB0,0x95,0x69,0x8B,0x25,0x13,0x72,
+  0x9D,0xCE,0x5E,0xCE,0x60,0x4C,0x13,0xC4,0x85,0xFE,0x9B,0x4F,0x0F,0x30,0x79,0x9D,0x5F,0x6F,0xAE,0xCC,
+  0x46,0xF1,0xF6,0xCA,0x8A,0x6E,0xBE,0x85,0x41,0x4E,0xCC,0x62,0x95,0x4A,0xCD,0x55,0x32,0xDC,0xA6,0x00,
+  0x7B,0x7F,0xBF,0xB2,0x87,0x32,0x5D,0xF7,0xEF,0xBF,0x8B,0xC0,0x1B,0x04,0x6A,0x90,0xD9,0x0F,0xCA,0xD4,
+  0x6E,0xA7,0x40,0xDB,0xD1,0x9D,0xDA,0xD4,0x5B,0xC5,0x3A,0xCA,0x65,0x74,0x1B,0x33,0xBA,0x6B,0x89,0x4A,
+  0x58,0x1E,0xBB,0x16,0x88,0xEC,0xF4,0x9B,0x1A,0xA7,0x6A,0xC9,0xED,0x55,0xAE,0x9C,0xF6,0xC4,0xC5,0xF1,
+  0xFD,0xE8,0x5F,0xE9,0x32,0xF2,0xE3,0x8C,0xDC,0xB6,0xE4,0x15,0x5E,0xE0,0x66,0xB0,0x7E,0xCF,0xB1,0xAF,
+  0x68,0xA6,0xB0,0xDF,0xE2,0x76,0x90,0xE1,0x2A,0x4B,0x61,0x93,0x9C,0xAE,0x9D,0x1C,0x8F,0x23,0xA6,0xF6,
+  0xA9,0x10,0x37,0xC4,0x74,0xF1,0x9D,0xE6,0x40,0x20,0x5E,0xF4,0xA1,0xD0,0x15,0x8A,0x7E,0x6D,0x25,0xF4,
+  0x02,0x82,0x3F,0xF9,0xF7,0x46,0xF6,0xD0,0xFC,0x7D,0x28,0x4F,0x88,0xF3,0x73,0xCC,0x83,0x73,0x9A,0x40,
+  0x8F,0xC2,0x35,0x0E,0x04,0xE8,0x1C,0xD6,0xBB,0x6B,0x9A,0x0F,0x3A,0xF6,0xDC,0xCB,0xCF,0x87,0xEA,0xE3,
+  0x5D,0x32,0xB7,0x00,0x3E,0x63,0xD5,0x27,0x1E,0x59,0x7D,0x09,0xB3,0x7E,0x93,0x2C,0xCC,0x09,0xF6,0x4D,
+  0x26,0x54,0xA4,0xDB,0x3F,0xAF,0xF9,0xA8,0x56,0x36,0xDE,0xB2,0x9A,0xCC,0x86,0x9B,0xEF,0xE1,0x29,0xF6,
+  0xE4,0x81,0xAC,0x70,0xD7,0x6E,0x8A,0x7B,0x95,0x8A,0xDF,0xF7,0x60,0x76,0xED,0xEF,0xFB,0x3D,0xCF,0xF9,
+  0xC3,0xC1,0xC4,0xC7,0x13,0x6A,0x4E,0xBE,0xE3,0x89,0x16,0x08,0xAA,0xFB,0xE1,0x3C,0x60,0xA2,0xE2,0xBB,
+  0xAE,0xCE,0x4A,0xA3,0x70,0x7A,0x03,0xC8,0x19,0x61,0x5E,0xD6,0xAC,0x18,0x91,0xEF,0xF3,0x3F,0xDF,0x8C,
+  0x96,0x51,0xFA,0x5F,0x9B,0x94,0x7E,0xB2,0xCE,0x8F,0x06,0xD4,0xFF,0xDD,0xFF,0xFF,0x2B,0xE3,0xF2,0x6D,
+  0x35,0xBB,0x4D,0x46,0xB0,0x41,0x51,0xF8,0xBC,0x86,0x8F,0x0F,0x1F,0xE1,0x1D,0x1C,0xD4,0xF8,0x76,0x13,
+  0x45,0xB9,0x89,0x5C,0x5C,0xD3,0xEB,0x4A,0xDA,0x37,0xB1,0xED,0x0A,0x63,0xB2,0x48,0x4D,0x16,0xC6,0x64,
+  0xA1,0x4D,0xB6,0x6D,0x14,0x1B,0x81,0x07,0xB7,0x79,0x19,0x67,0x93,0x1A,0x80,0xAF,0xE1,0x82,0xA7,0xBA,
+  0x10,0x59,0x45,0xCB,0xE6,0x2E,0xA0,0x51,0x44,0xD3,0x05,0xAB,0x90,0x7D,0x73,0x2F,0xD4,0x0D,0x2C,0x32,
+  0xD0,0x07,0xED,0x9F,0x0A,0xAD,0xBE,0xAE,0xFA,0xD5,0xC8,0xED,0x7B,0x33,0xED,0xA6,0x5E,0x33,0x7D,0xB5,
+  0xDD,0x6B,0x9A,0xFF,0xC1,0xF1,0x5F,0x15,0x56,0xB4,0xFB,0xD3,0x21,0x00,0x00
+};
+#endif
+
+#if embedFavicon
+// favicon.ico: 15406 bytes, 2374 gzipped
+const uint8_t favicon_ico_gz[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0xFF,0xED,0x9B,0x87,0x73,0x15,0x55,0x14,0x87,0xD7,0x82,
+  0x3A,0x16,0x84,0x51,0xEC,0x25,0x1A,0x4A,0x8C,0xA0,0x51,0x07,0x10,0x11,0x08,0x81,0x24,0x80,0xA0,0x74,
+  0x44,0x08,0x09,0x3D,0x30,0x42,0xA2,0x62,0x88,0xA1,0x05,0x41,0x21,0x48,0x28,0x12,0x21,0x06,0x02,0x82,
+  0x20,0x45,0x40,0x05,0x14,0xEC,0x6D,0xC6,0x51,0xB1,0x63,0x41,0x45,0xC3,0x7F,0x72,0xDD,0xEF,0x6C,0xEE,
+  0xE3,0xEE,0x7B,0xBB,0xEF,0xBD,0x90,0xDD,0x47,0xD4,0x64,0xE6,0xCC,0xEE,0xDD,0x77,0x77,0xEF,0xA9,0xBF,
+  0x73,0x6E,0x89,0x65,0x9D,0x67,0x5D,0x60,0xB5,0x6B,0x67,0xD9,0xD7,0x34,0xAB,0xF8,0x42,0xCB,0xEA,0x61,
+  0x59,0x56,0x5A,0x9A,0xD3,0xCE,0x68,0x6F,0x59,0x5B,0xED,0x67,0x59,0x59,0x8D,0xBF,0x77,0xB6,0xAC,0x2F,
+  0x3A,0x58,0x56,0x86,0xDD,0xA7,0x1D,0xFD,0x2C,0xE7,0xB9,0xDF,0xDF,0x27,0xAF,0x58,0x2A,0x68,0xFA,0x78,
+  0xDB,0xF9,0xAA,0x6A,0x56,0x91,0xDA,0xB3,0x32,0x53,0xDA,0x6F,0xAC,0xBD,0x45,0x4D,0xEE,0xBF,0x53,0x1D,
+  0xAC,0xBE,0x35,0xA9,0xF7,0xDF,0x7E,0xE9,0x2A,0x35,0x20,0xFD,0x4F,0xB5,0xA4,0xF0,0x49,0x69,0xAF,0x2C,
+  0x9E,0xA2,0xB2,0xD3,0x4E,0xAB,0x27,0x46,0xAC,0x4A,0xEA,0xFD,0xDA,0xF2,0x3C,0xE9,0x3F,0xEA,0xDE,0x8F,
+  0xD5,0x47,0x5B,0x2F,0x50,0xE5,0x8F,0x2E,0x96,0xF6,0x90,0xCC,0xEF,0xD4,0x3B,0x1B,0xDB,0x27,0x7C,0x9F,
+  0x71,0xF3,0xBB,0xFC,0xAC,0x72,0x6E,0x3F,0xA5,0xB6,0x2E,0x7E,0x40,0x15,0x65,0xEF,0x51,0x73,0x86,0xAD,
+  0x57,0x03,0x3B,0xFE,0xAE,0x9E,0x9F,0x31,0x2D,0xA1,0xEC,0xE3,0x7B,0x1D,0x52,0x65,0x63,0x97,0xCA,0xF8,
+  0x8F,0x0F,0x5D,0xAF,0x46,0xDE,0xFB,0x89,0x5A,0x5B,0x32,0x5A,0x95,0x3C,0x5C,0x2D,0xCF,0x3E,0xAC,0x6F,
+  0x93,0x50,0x76,0xFA,0x33,0x56,0xFF,0xDB,0xFE,0x16,0xDA,0xBD,0xA2,0xAB,0x2D,0xD7,0x40,0x5B,0x8E,0x06,
+  0xB9,0xFA,0xBD,0xBF,0xB6,0x64,0x8C,0xF0,0x7D,0x70,0xCD,0xAD,0x42,0xDC,0xC3,0xF7,0x07,0x5B,0x2E,0x16,
+  0x1A,0x92,0xF9,0xAD,0x2A,0x79,0x64,0x75,0x5C,0xDE,0xE1,0x17,0xBD,0xD1,0x2E,0xCA,0x7E,0x2D,0xD2,0xA6,
+  0x0F,0xEF,0x7A,0xE9,0x91,0x76,0xFD,0xA2,0x3E,0xC2,0xBB,0x69,0x27,0x7C,0x60,0xD3,0xFC,0xBC,0x48,0x7B,
+  0x63,0x59,0xBE,0xCA,0xED,0xF4,0xAB,0x2D,0xCF,0x9D,0x91,0x67,0xDC,0x17,0x3C,0x78,0x40,0xF4,0x5E,0x3C,
+  0xA8,0xCE,0xF5,0x9B,0x17,0x7D,0xB0,0xE5,0x22,0x57,0x7B,0xD6,0xE0,0x8D,0x6A,0xE1,0xC4,0xA7,0xED,0x71,
+  0x57,0xAA,0xD9,0x43,0x5E,0x52,0x2B,0x66,0x4E,0x6D,0x92,0xBF,0x4E,0xCF,0xDD,0xA6,0x66,0xE4,0xD5,0xAB,
+  0xA5,0x93,0x1F,0x57,0x35,0xF3,0x1E,0x52,0x05,0x7D,0xF6,0x8B,0xAE,0x92,0x7D,0x1F,0xFF,0x2C,0x1E,0x54,
+  0xAB,0x66,0xE6,0x6F,0x56,0x75,0x15,0xD9,0x36,0x0F,0x35,0xA2,0xBB,0x64,0xDF,0x47,0xB7,0x95,0x45,0x73,
+  0xD5,0xB4,0x81,0xDB,0xD5,0x93,0x23,0x57,0xDA,0x3E,0xD0,0x5E,0x85,0x11,0x97,0x5E,0x64,0x35,0xF3,0x2F,
+  0xA3,0x11,0x63,0xB2,0xCF,0x01,0xCE,0xFC,0x97,0x09,0xFF,0x3B,0x56,0xDB,0xD6,0xD3,0x0F,0x8F,0xD5,0x5E,
+  0xA1,0x96,0x4D,0x9D,0x2D,0xC4,0x7D,0x18,0x63,0xCF,0xCC,0xAF,0x53,0x83,0x32,0x7E,0x92,0x6B,0x34,0x0F,
+  0x8C,0x0B,0x0E,0x41,0x95,0x85,0xA5,0xB6,0xAF,0x9F,0x17,0xE8,0xF8,0xC8,0xCD,0xD8,0x60,0x36,0x57,0xDA,
+  0x26,0x6F,0x53,0x07,0x6C,0x97,0xDF,0xA0,0x87,0xEE,0xFC,0x46,0x30,0x33,0xC8,0xF1,0x37,0x2F,0xE8,0x27,
+  0x98,0xC9,0xF7,0xF3,0xBB,0x9C,0x50,0x47,0x6A,0xAE,0xF6,0xE4,0xCD,0xA1,0x06,0xD1,0x47,0x90,0xE3,0x57,
+  0x16,0x95,0xBA,0xBE,0x6F,0xEA,0x38,0x76,0xFC,0xD3,0xA2,0x8F,0xA6,0xE0,0x55,0x22,0xDB,0x9B,0xFA,0xD5,
+  0x3A,0xD6,0x7E,0x66,0xEA,0x46,0x13,0x6D,0x9E,0x07,0x6D,0x7B,0xAF,0xEF,0x6B,0xDD,0xF0,0xAC,0xFC,0xD1,
+  0x45,0x11,0x5E,0x82,0xD2,0x01,0xB6,0xC6,0xE6,0x7C,0x73,0x42,0xEF,0x37,0x62,0xBE,0xAF,0xC7,0x87,0xC7,
+  0x37,0xD7,0xDD,0x28,0xBA,0xF1,0xF2,0x93,0xB3,0x25,0x1D,0x5B,0x8C,0x5B,0x33,0x6F,0xA8,0xEB,0xFB,0x87,
+  0x37,0x74,0xB0,0xF3,0x5C,0x99,0x61,0x93,0xB6,0xE2,0x1B,0x41,0xC5,0xA2,0x69,0x7B,0xE4,0x3B,0xBA,0xE9,
+  0x4A,0xD7,0xF7,0xD1,0xB7,0xE6,0x07,0x3E,0x18,0xCB,0xD4,0x57,0x73,0x63,0xD1,0xB4,0xBD,0xF6,0x39,0xF3,
+  0xFB,0x03,0xD2,0xFF,0x68,0xE4,0xE5,0xB4,0xD8,0x21,0xD6,0x5F,0x9B,0x17,0x8B,0xA6,0x6F,0x6B,0xF9,0xBC,
+  0xE2,0x21,0xDA,0xDF,0xCF,0xE0,0xE1,0xD9,0xFB,0x21,0x63,0x69,0xDB,0x46,0xCB,0x61,0x7E,0xDF,0x0B,0x13,
+  0x4D,0x1D,0x9D,0xAD,0x1F,0x62,0x37,0x3F,0x5F,0x36,0xBF,0x9F,0x18,0x93,0xCF,0xCE,0x06,0xA6,0x8C,0x26,
+  0xDE,0xF8,0x61,0x7E,0x74,0xDE,0x6B,0x8E,0x0D,0xA2,0xBF,0xAF,0x6D,0x9F,0xC8,0x37,0xFC,0x70,0xA3,0xA9,
+  0x78,0xE8,0xC6,0x3C,0x6F,0xFD,0xE9,0x9C,0x8C,0xEC,0x5B,0x16,0xF6,0xF5,0xAC,0x09,0xB4,0xFD,0xCC,0xF8,
+  0x88,0x27,0x33,0x3C,0xD2,0x6F,0xE1,0xC4,0xF9,0x11,0xD9,0xE2,0xC5,0xB0,0x53,0x93,0x5C,0xE1,0x89,0x31,
+  0x3C,0x63,0x5E,0xC2,0xFB,0x7E,0x3C,0x9A,0xBC,0x22,0xCB,0xC0,0x8E,0x27,0x45,0x67,0xC8,0x1E,0x4F,0xB7,
+  0x4D,0x89,0x21,0xBE,0xED,0xC7,0xA3,0xBB,0xB6,0xF9,0x51,0xB0,0x0D,0xBB,0xA1,0x7F,0xAD,0x8B,0x57,0x2A,
+  0x7B,0x86,0x5A,0xD7,0x39,0x7E,0x74,0xD2,0x9E,0xEB,0x3C,0x21,0xF7,0xD8,0x1A,0x1E,0xF4,0xF8,0x5C,0x83,
+  0xCA,0xE5,0x7E,0xB5,0x05,0x3A,0x5F,0x57,0x3A,0x52,0x74,0x90,0xDF,0xE5,0x27,0xD1,0xBF,0x73,0x7F,0x42,
+  0x78,0xAB,0x2C,0x2A,0x09,0xBC,0xA6,0x33,0xC7,0x67,0x3C,0xE6,0xE4,0x8C,0xB7,0xB7,0xAA,0x8B,0xF8,0x0B,
+  0xB9,0xE5,0x48,0x4D,0x07,0x89,0x43,0xAF,0xF8,0x0E,0x8A,0xD0,0x37,0xE3,0xAF,0x2B,0x1D,0x25,0x32,0x33,
+  0x1F,0xC5,0xE7,0x98,0xB3,0x31,0xAF,0xD4,0xFC,0x99,0xF8,0x16,0x24,0x61,0x6B,0xBE,0xBF,0x60,0xC2,0x7C,
+  0x7B,0xCE,0xB9,0x59,0xF4,0x8D,0xCC,0x8C,0x87,0xCC,0xDC,0x07,0x59,0xCF,0xC5,0xF3,0x7F,0x74,0x8E,0x1D,
+  0x88,0x7F,0xE6,0xE8,0x8C,0xCB,0xF3,0x78,0xB1,0x1B,0x4C,0x8D,0xE7,0x15,0xFF,0x27,0xC5,0xEE,0x60,0x48,
+  0x58,0xBE,0xE7,0x87,0x7F,0x10,0x7E,0x01,0xEE,0xA5,0x62,0xEC,0xFF,0x23,0x59,0xFF,0xF3,0x3F,0xD6,0x49,
+  0xB2,0x6C,0x2A,0x6A,0x5D,0x27,0x69,0xA5,0x7F,0x01,0x81,0x83,0x1F,0xD6,0x5F,0x28,0x6B,0xD5,0x7A,0xED,
+  0xD7,0x8F,0xDE,0xDF,0x7C,0x89,0x7A,0x75,0xD9,0x7D,0x76,0xED,0x74,0xBF,0x5C,0x69,0x9F,0x6B,0xDE,0xF7,
+  0xAD,0xEA,0x24,0x98,0x0E,0xB6,0xAF,0x99,0x3B,0xCE,0xB7,0x9E,0x20,0x0F,0x54,0xCD,0x9A,0xA4,0x86,0x75,
+  0xFB,0x52,0xF2,0x10,0x57,0xDA,0x61,0xD6,0x60,0x89,0x88,0xB5,0xF4,0x29,0x39,0xAF,0x4A,0x4E,0x64,0x3D,
+  0x7D,0x68,0xD7,0xAF,0x45,0x06,0x2F,0x3B,0x50,0x37,0x4C,0xC9,0xD9,0x65,0xCC,0x0F,0x1B,0x54,0x61,0xBF,
+  0x7D,0xEA,0xD0,0x8B,0xD7,0x9D,0x33,0xFE,0x0F,0x6F,0xB8,0xD6,0xD6,0xE3,0x57,0x91,0xB9,0x08,0x32,0x60,
+  0x87,0xE8,0x7D,0x0F,0xEC,0xB4,0xB7,0xAA,0xB3,0x1A,0xDF,0xEB,0x88,0x6B,0x7E,0x9D,0xD7,0xF9,0x57,0xB5,
+  0x7C,0x5A,0x71,0xDC,0x7D,0x92,0x30,0x7D,0xE7,0x40,0x75,0x9A,0xE8,0x3C,0x11,0xFF,0xC4,0x07,0x3E,0x86,
+  0x9D,0x4C,0xFE,0xD9,0xAF,0xA1,0x96,0x3A,0xB8,0xE6,0x96,0x94,0xF3,0xFF,0x5E,0xDD,0xA5,0x6A,0xDE,0xE8,
+  0x65,0x8D,0x6B,0x25,0x0E,0x3F,0xEC,0x01,0x55,0x3C,0x56,0x21,0xBF,0xB9,0xF9,0x6F,0x23,0x72,0x21,0x9F,
+  0xC9,0x3F,0x34,0xF8,0x8E,0x1F,0x42,0x9F,0x0B,0xF9,0xCD,0x85,0xD9,0x6F,0x73,0xF3,0xD3,0x20,0x71,0xB9,
+  0x7D,0x69,0x8F,0xA4,0xF9,0xCF,0xEB,0xFC,0x8B,0x5A,0x35,0x7B,0x62,0xCA,0x7D,0x88,0xFA,0x7E,0x52,0xDF,
+  0xD7,0x63,0xF8,0x61,0x7E,0x5B,0x36,0xB6,0x52,0xBD,0xFB,0xF2,0x65,0x2E,0xDC,0x64,0xEE,0x31,0x20,0xFD,
+  0x54,0x4C,0x7F,0x64,0x1E,0x71,0xCF,0xA7,0xB2,0x87,0x97,0xAA,0x9A,0x14,0x7C,0x01,0x67,0xD8,0xDF,0x8B,
+  0xE5,0xE7,0xB4,0x7A,0xE4,0xEE,0x2F,0x24,0xB6,0xCD,0x7D,0xBB,0xB1,0x3D,0xDE,0xB5,0xFD,0xBD,0xC1,0xB3,
+  0x3F,0x3E,0x88,0x2F,0x46,0xFB,0x5D,0x58,0x14,0xCF,0x1F,0xF4,0xFE,0x6F,0xFD,0xA2,0xDE,0x11,0x1C,0x25,
+  0x5F,0xE9,0x75,0x17,0x64,0x18,0x9E,0xF5,0xB9,0x9A,0xF8,0xE0,0x41,0x57,0xEC,0x80,0x4D,0x60,0x54,0x2A,
+  0x6C,0x10,0xCB,0x7F,0x83,0xCA,0xED,0xF4,0x9B,0xE0,0xC9,0x19,0x5C,0xD9,0x11,0x59,0x9F,0x31,0xF9,0xC7,
+  0x87,0x98,0xC7,0xED,0xAD,0xCA,0x70,0x61,0x17,0xD8,0x04,0x46,0x81,0x55,0xA9,0xC0,0x1E,0x70,0x06,0xBC,
+  0xD1,0x31,0xB8,0xA8,0x60,0x9E,0xCB,0x9F,0xB8,0xD7,0xB9,0xCC,0xCD,0xBF,0x83,0xB1,0x6F,0xAD,0xBF,0x5E,
+  0x8D,0xE9,0xFE,0x5E,0x44,0x66,0x3F,0xEC,0x0A,0x83,0xA8,0x5D,0xC0,0x19,0xF4,0x8E,0x3F,0xE0,0xDB,0x75,
+  0x15,0x39,0xE2,0xF7,0x66,0x2E,0x60,0x9F,0x9A,0xB5,0x82,0xAD,0x8B,0x7B,0x1B,0xFC,0xFF,0xA1,0x96,0x4E,
+  0x9E,0x2B,0x75,0x03,0x73,0x69,0xE6,0xD1,0xF1,0xB0,0x2B,0x8C,0xBC,0x55,0x57,0xD1,0xDF,0x58,0x2B,0x3F,
+  0x25,0xD8,0x72,0xA4,0xE6,0x2A,0xC1,0x1D,0xBD,0xBE,0xA6,0x73,0xD3,0xEE,0x15,0x99,0xAE,0xE7,0x60,0x0D,
+  0xF3,0x61,0xF6,0xAD,0xC9,0x5B,0xF4,0xD1,0x36,0xF0,0xC2,0xAE,0x30,0x6A,0x1E,0xCE,0x88,0x68,0xDF,0x31,
+  0x73,0x2E,0xBA,0xD3,0x76,0x71,0xD6,0x9F,0x7F,0xB4,0xB1,0xBD,0x40,0x3D,0x7C,0xD7,0x97,0x11,0xBB,0x14,
+  0xF6,0xDB,0xAB,0x8E,0x6E,0x6A,0xD7,0x18,0x47,0x17,0x89,0x8D,0x4C,0x1C,0xA0,0xEF,0xBE,0x55,0xE1,0xC5,
+  0x71,0x6C,0xCD,0xE3,0xF8,0x03,0xFC,0x47,0xC7,0x05,0x7A,0x45,0x86,0xFE,0xB7,0xFD,0x15,0xE9,0x4F,0xCE,
+  0xD3,0x6B,0x4E,0x5E,0x38,0x4C,0xDF,0xE2,0x41,0x2F,0xDB,0x36,0xB8,0x3C,0x25,0x35,0x8F,0xE9,0x0F,0x7E,
+  0x75,0x8E,0x59,0xEF,0x70,0x86,0xC2,0xAC,0xB1,0xBD,0xF2,0x20,0xED,0x20,0xF6,0xC8,0x92,0xA9,0x79,0x4C,
+  0x7F,0xF0,0xAB,0x33,0xFD,0xF2,0x02,0x84,0x9E,0xD1,0xB7,0x69,0x23,0x13,0xBB,0x82,0xE4,0x1F,0x3E,0xE1,
+  0xD7,0xCC,0xFD,0xD4,0xF4,0xE6,0x1A,0x64,0x6C,0x9D,0x7F,0x86,0xF0,0x3B,0x33,0x2F,0x9B,0x32,0x0F,0xED,
+  0x7A,0x3C,0x06,0xBB,0x88,0x8F,0x20,0xCF,0x7A,0xE1,0x27,0xF8,0x8B,0x1E,0x87,0xB3,0x53,0x55,0xB3,0x0A,
+  0x5D,0x73,0x28,0x67,0x9E,0x55,0x28,0xBF,0x25,0xC3,0xBF,0xE3,0x43,0xD7,0xC8,0xD9,0x23,0x2D,0x73,0x18,
+  0x75,0x35,0xBE,0xB3,0x60,0x42,0xB9,0x0B,0x2B,0xE0,0xE7,0xAD,0xF5,0x37,0xC4,0xF4,0xE5,0x99,0x19,0xE3,
+  0x89,0xF8,0x27,0xF6,0xA9,0x41,0xC9,0x83,0x61,0xD5,0xD5,0x66,0xCE,0xF2,0xAB,0xD3,0xFC,0x30,0x36,0x51,
+  0x7F,0xA7,0xC6,0xE8,0x29,0x3C,0x87,0x51,0x57,0x47,0xE7,0xAC,0x44,0xB9,0x86,0xFE,0xAC,0x4D,0x9B,0xFB,
+  0x5C,0x89,0x72,0x53,0x74,0x2E,0x0B,0xB2,0xAE,0xF6,0xD2,0x27,0xF5,0x00,0x75,0x41,0xBC,0x77,0x38,0xA7,
+  0xA6,0xDF,0x49,0xD4,0xDF,0x2B,0x97,0x05,0x55,0x57,0x47,0xE7,0xAC,0x64,0xFC,0x53,0xE7,0x26,0x72,0x05,
+  0x7C,0x8C,0xEB,0x79,0x34,0xEE,0x79,0x3D,0xFC,0x84,0x3C,0x68,0x62,0x73,0x74,0xBE,0x6B,0x8A,0xBF,0x20,
+  0xB3,0xB3,0x57,0xD2,0x56,0xED,0x5F,0xDD,0xD1,0x95,0xB3,0x92,0xC5,0x07,0xF2,0x14,0x32,0xC0,0x17,0xFE,
+  0x14,0xCF,0x97,0xC1,0x37,0xFA,0x8C,0xED,0x71,0xCC,0x55,0x87,0x47,0xE7,0xBB,0x64,0x6A,0x7B,0x7C,0x0E,
+  0xBB,0x21,0x3B,0x54,0xD0,0xE7,0x80,0x4B,0x2F,0x4D,0x59,0xF7,0xC0,0x0E,0xF4,0x4B,0xE6,0x9C,0x21,0xFD,
+  0x38,0xC7,0x4A,0x5D,0x8D,0xBD,0xB9,0x6E,0x5B,0xD2,0x2B,0xE9,0x3C,0xC6,0x3C,0xB5,0x7A,0xCE,0x38,0x89,
+  0x1B,0xE2,0x0D,0xDF,0xC5,0x1F,0x21,0xD3,0xF7,0x91,0x27,0xAC,0x75,0x27,0xE4,0x64,0x7F,0x10,0x9F,0xE5,
+  0x9A,0xEC,0xF9,0x4A,0x6C,0xB4,0x62,0xE6,0x64,0xC9,0x83,0xD4,0x2F,0x60,0x25,0xB5,0x98,0xDE,0xF7,0x21,
+  0x16,0xC1,0x13,0xE2,0x90,0x33,0xA0,0x61,0xED,0x3B,0x36,0x67,0x3E,0x0E,0xEF,0x9C,0x99,0x7D,0x7A,0xCC,
+  0xB3,0x52,0x0B,0x13,0x03,0xD8,0x14,0x02,0x4F,0x76,0x3C,0xDB,0x5D,0xE6,0x52,0x9C,0xB5,0x0D,0xBA,0x36,
+  0x69,0x2E,0x3E,0x6A,0xAC,0x9B,0xD4,0x77,0x9F,0xED,0xFF,0x37,0x0B,0x56,0x80,0x2F,0xC4,0x28,0xD8,0x66,
+  0xF2,0xCF,0x6F,0xD4,0x09,0x2D,0x65,0x0F,0x0E,0xBE,0xF0,0x0D,0x6A,0x96,0xE7,0xA6,0x4F,0x97,0xB3,0xC1,
+  0xE0,0x1D,0x18,0x09,0xCE,0x80,0xCB,0xA6,0xFF,0x30,0x5F,0x64,0xEF,0xFC,0xCD,0x75,0x37,0xB5,0x08,0xFE,
+  0xF5,0xFC,0x9A,0x98,0xAF,0x2D,0xCF,0xB5,0xF9,0x3B,0xDA,0xB8,0x9E,0x7C,0x5C,0xE6,0x1F,0xDC,0xE3,0x57,
+  0xC3,0xBA,0x7D,0x2D,0xCF,0xB0,0xD3,0x90,0xCC,0xEF,0x65,0xFE,0xDA,0x94,0xF3,0xCB,0xA9,0xE0,0x7F,0xC3,
+  0x53,0xC3,0xE5,0x1E,0x3E,0x77,0x2E,0xCF,0xB2,0x63,0xF8,0x19,0xE1,0x9F,0xF5,0x1A,0xE6,0x75,0xD4,0xBA,
+  0x9C,0x55,0xE7,0x19,0xF8,0x06,0x46,0xB4,0x24,0xFE,0xF5,0x59,0x3E,0x74,0xBD,0x7F,0x75,0xBA,0x5D,0x33,
+  0x67,0x0B,0x9E,0x8E,0xBA,0xEF,0xA3,0x08,0x16,0xEB,0x5A,0xC8,0xAF,0x9E,0x4C,0x35,0xE9,0xDA,0x92,0x1C,
+  0xBB,0x6D,0x49,0x4F,0x39,0xD7,0x8F,0xBF,0x94,0x0E,0xAF,0x52,0xBB,0x9E,0xEB,0x26,0x78,0x39,0x25,0x67,
+  0x87,0x7A,0xFD,0x85,0x74,0x89,0x59,0x53,0xDE,0x96,0xC0,0xBF,0x9E,0x77,0x93,0xB3,0xA6,0xE7,0xD6,0xDB,
+  0x31,0x3C,0xC3,0xB6,0xC1,0x71,0x69,0x8F,0xB8,0xE7,0x33,0xC9,0xB5,0x87,0x5E,0xBC,0x56,0x78,0x27,0xC7,
+  0xB1,0xA6,0x40,0x5C,0x50,0xD3,0x25,0xF3,0x7F,0x22,0xE1,0xAF,0x07,0x9E,0x99,0x77,0xC3,0xEF,0xDA,0x92,
+  0x51,0x36,0xE6,0x94,0x8A,0x7E,0xE1,0x73,0x7C,0xAF,0xC3,0x92,0x6F,0x59,0x0F,0xD4,0x39,0x0E,0xF9,0xA8,
+  0x57,0x5A,0x02,0x86,0xEA,0x7D,0xB8,0xA2,0xEC,0x5D,0x12,0x97,0xC8,0xC0,0xFA,0x65,0xF5,0x9C,0xF1,0x12,
+  0xCF,0x1B,0xCB,0x06,0x8B,0xCF,0xF3,0x8C,0xB9,0x35,0xBE,0x35,0x7F,0xDC,0xE2,0x16,0xA1,0xFB,0xE8,0xB5,
+  0x11,0x64,0xC0,0x0E,0x60,0x24,0x7A,0xC6,0x06,0x10,0x7C,0xF3,0x8C,0xDA,0x8D,0x5C,0x10,0xC6,0xFA,0x46,
+  0x50,0x76,0xE0,0xBC,0x1B,0x39,0xCA,0x39,0xEF,0xE5,0x90,0xCE,0x65,0xC4,0x02,0xBC,0xB7,0xD4,0xF3,0x2F,
+  0xFA,0x2C,0xAE,0x53,0x3F,0xDC,0x6F,0x90,0xAE,0x25,0xDA,0xB4,0x48,0xBE,0x5B,0xA9,0x95,0x5A,0xCF,0x49,
+  0xB5,0xFE,0xA5,0xEA,0xEF,0x1F,0x07,0x54,0x48,0x47,0x2E,0x3C,0x00,0x00
+};
+#endif
+
+#if UseFileManager
+#if embedFileman
+// fileman.htm: 8487 bytes, 3199 gzipped
+const uint8_t fileman_htm_gz[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0xFF,0x9D,0x1A,0x6B,0x73,0xDB,0x36,0xF2,0x7B,0x67,0xFA,
+  0x1F,0x68,0xF4,0xD2,0x90,0x27,0x9A,0xF2,0x23,0x6D,0x53,0x52,0x54,0xE7,0x62,0xC7,0x73,0xE9,0x5C,0x1E,
+  0x53,0x3B,0x93,0xB9,0x49,0xFC,0x01,0x22,0x41,0x09,0x35,0x05,0xB0,0x04,0x64,0x5B,0x96,0xFD,0xDF,0x6F,
+  0x17,0x00,0x29,0x52,0x96,0x9C,0xF4,0xD2,0x36,0x22,0x81,0x5D,0x60,0xDF,0x2F,0x76,0xB4,0x77,0xFA,0xFE,
+  0xE4,0xE2,0xBF,0x1F,0x5E,0x7B,0xFF,0xBE,0x78,0xFB,0x9F,0xF1,0x68,0xA6,0xE7,0x25,0xFC,0xCD,0x68,0x3E,
+  0x1E,0x69,0xAE,0x4B,0x36,0x1E,0x0D,0xED,0xEF,0xF7,0xDF,0x8D,0xE6,0x4C,0x53,0x2F,0x9B,0xD1,0x5A,0x31,
+  0x9D,0x92,0x8F,0x17,0x67,0xFB,0x2F,0xC9,0xD8,0xAE,0x0A,0x3A,0x67,0x29,0xB9,0xE6,0xEC,0xA6,0x92,0xB5,
+  0x26,0x99,0x14,0x9A,0x09,0x00,0xBA,0xE1,0xB9,0x9E,0xA5,0x39,0xBB,0xE6,0x19,0xDB,0x37,0x2F,0x21,0x17,
+  0x5C,0x73,0x5A,0xEE,0xAB,0x8C,0x96,0x2C,0x3D,0x24,0x78,0xB2,0xD2,0x4B,0x73,0x85,0x37,0x91,0xF9,0x72,
+  0x35,0xA1,0xD9,0xD5,0xB4,0x96,0x0B,0x91,0xEF,0x67,0xB2,0x94,0x75,0xFC,0x43,0xF1,0x0B,0xFE,0xF3,0x00,
+  0x00,0x3F,0xA8,0x2A,0x5B,0xCD,0x18,0x9F,0xCE,0x74,0x7C,0x74,0x50,0xDD,0xE2,0x9A,0xA6,0x93,0x92,0x6D,
+  0xC1,0xCA,0xCD,0x9F,0x64,0x22,0xEB,0x9C,0xD5,0xB8,0x58,0xD2,0x4A,0xB1,0xB8,0x79,0x48,0x0C,0x3D,0x31,
+  0x5D,0x68,0x69,0x4E,0xA9,0x63,0xA1,0x67,0xFB,0xD9,0x8C,0x97,0xB9,0xCF,0xAE,0x99,0x08,0xB6,0x11,0x62,
+  0xFE,0x18,0xF0,0x3C,0xD4,0xB3,0x95,0x3D,0x3B,0x3E,0xAC,0x6E,0x3D,0x25,0x4B,0x9E,0x7B,0xCD,0xA5,0x9A,
+  0xDD,0xEA,0x7D,0x5A,0xF2,0xA9,0x88,0x4B,0x56,0xE8,0xA4,0xA2,0x79,0xCE,0xC5,0x34,0x7E,0xE9,0x48,0x9E,
+  0xAD,0xB2,0x45,0xAD,0xE0,0xC8,0x4A,0x72,0x90,0x55,0x9D,0x54,0x52,0x81,0x5C,0xA4,0x88,0x95,0xE6,0xD9,
+  0xD5,0x32,0xD1,0xB2,0x8A,0x0F,0x10,0xB4,0xE0,0xAC,0xCC,0x41,0xE2,0x4F,0x8B,0xE5,0x15,0xAD,0x57,0x96,
+  0x9F,0x9F,0x51,0x2C,0xC9,0x23,0xE0,0x69,0xCD,0x96,0xC9,0x9C,0xD6,0x53,0x2E,0x0C,0xCB,0x49,0xCE,0x55,
+  0x55,0xD2,0x65,0x2C,0xA4,0x60,0xE6,0x88,0x0F,0xB5,0x04,0x20,0xA5,0xDC,0x39,0x07,0xD1,0x4F,0xCF,0x12,
+  0x27,0xE9,0xE3,0x5D,0x47,0x32,0x01,0xA8,0xA3,0x61,0xA3,0xBF,0xD1,0xD0,0x98,0x0E,0x3C,0xA0,0x22,0xC7,
+  0xA3,0x8C,0x21,0x6F,0x60,0x50,0x47,0x1E,0xCF,0x53,0xDC,0xC3,0xB7,0xE1,0xEC,0x68,0x3C,0xCA,0xF9,0x35,
+  0xAE,0x11,0xD0,0x27,0x18,0xD1,0x10,0x5E,0x11,0xAD,0x90,0xF5,0xDC,0x03,0x8B,0x9A,0x49,0xD8,0xFA,0xF0,
+  0xFE,0xFC,0x82,0xD0,0x0C,0xA5,0x92,0x92,0xE1,0xA2,0x2A,0x25,0xCD,0x09,0x13,0x99,0x5E,0x56,0x60,0x6C,
+  0xF3,0x45,0xA9,0x79,0x45,0x6B,0x3D,0x44,0xA4,0xFD,0x9C,0x6A,0x6A,0x6D,0x89,0x95,0x2C,0xD3,0xE6,0xEC,
+  0x42,0x9D,0xB3,0x92,0x58,0xDB,0x2C,0x14,0x91,0xE2,0x64,0x46,0xC5,0x14,0x5E,0xCE,0xDE,0x4E,0x99,0x3E,
+  0x3B,0xF7,0x03,0xBC,0xDA,0x22,0x8C,0x7F,0x14,0x13,0x55,0x25,0xDD,0xBF,0xBF,0xFF,0xEE,0x84,0x56,0x34,
+  0xE3,0x7A,0x19,0x7B,0x23,0x55,0x51,0x61,0x0E,0xCD,0x60,0xCD,0xA0,0xC1,0xC2,0x56,0xA4,0x8F,0x8A,0xE5,
+  0x5D,0x84,0x05,0xBC,0x3F,0x89,0x70,0x06,0x72,0xEC,0x22,0x14,0xF0,0xFE,0x24,0x42,0xC3,0xA3,0x11,0x3B,
+  0x48,0x82,0x0B,0xEB,0x5B,0xF1,0xE1,0xC1,0x81,0x63,0x37,0xE7,0x35,0xC1,0xB3,0xF0,0x77,0x83,0xEF,0x53,
+  0x5E,0xF7,0x18,0x87,0xF3,0x76,0x28,0xC3,0x59,0xDE,0x78,0x54,0xB2,0x29,0x13,0xF9,0xF8,0x8C,0x97,0xCC,
+  0x2B,0xB9,0xD2,0xA3,0xA1,0x5B,0x01,0x28,0xE3,0x7D,0x96,0xEE,0x0B,0x7C,0x84,0x03,0x34,0x28,0x59,0xCF,
+  0x3C,0x29,0xB2,0x12,0x6C,0x19,0x8E,0x85,0x98,0xE0,0x1F,0x9A,0x3B,0xF5,0xCC,0x6C,0x39,0xCA,0x2D,0xD5,
+  0xBF,0xFE,0xFA,0x8C,0x3C,0x86,0xC5,0xCB,0x36,0xE1,0x3B,0x9C,0xBE,0x00,0x93,0xDC,0xC0,0x3A,0x02,0x2C,
+  0xCB,0x69,0xBE,0x1B,0xF1,0x97,0x9F,0x1E,0xE1,0x1D,0x03,0xDE,0x39,0xBF,0x73,0xB7,0x0D,0x91,0xFA,0xA1,
+  0xE1,0x6A,0x87,0x68,0x46,0xC3,0x56,0x32,0x3B,0x65,0xC7,0x45,0xB5,0xD0,0x9E,0xB5,0xD4,0xC9,0x42,0x6B,
+  0x29,0xC8,0x35,0x2D,0x17,0xF0,0xF6,0x8E,0xDD,0x78,0xA7,0x46,0x2B,0x8E,0x86,0xF9,0x95,0xD3,0xC8,0x86,
+  0x92,0xBB,0x47,0xA8,0xC5,0x64,0xCE,0x35,0x41,0x4B,0x6F,0x1D,0x22,0x97,0x37,0xC2,0xB8,0x04,0xAE,0x36,
+  0x3E,0x03,0xFA,0x6D,0x2E,0x3A,0x6D,0xF6,0xDB,0x9B,0x6A,0xA6,0x17,0xB5,0x80,0x88,0x52,0x32,0x70,0x8C,
+  0xAF,0x5C,0xD9,0xA7,0xFA,0x14,0x6C,0x45,0xB3,0xF5,0x51,0x39,0x2B,0x51,0x41,0xDF,0x4E,0xB6,0x86,0xD0,
+  0x83,0x69,0x23,0x9F,0x2F,0x9B,0x33,0x3F,0x56,0x8E,0xBC,0x93,0x1E,0x79,0xB0,0xFB,0xB1,0xFA,0xCA,0xC1,
+  0xC8,0x42,0x63,0xE9,0xE8,0xF8,0x3D,0x7B,0x7A,0x71,0x80,0xB6,0x61,0x5C,0xAF,0x32,0x80,0xA8,0x90,0x92,
+  0x4E,0x58,0xE9,0x99,0x5C,0x96,0x92,0x7F,0x95,0x4A,0x82,0x69,0xC8,0x9A,0x79,0xD4,0x9B,0xDE,0xF1,0xAA,
+  0x62,0xB9,0x97,0xC9,0x6A,0xE9,0xF9,0x88,0x10,0x4D,0xEF,0x02,0x4F,0x16,0x5E,0x04,0xE9,0x30,0xF4,0xA2,
+  0x4C,0x29,0xF8,0xFB,0x4F,0xE5,0x51,0x91,0x7B,0x8A,0xCF,0x79,0x49,0x6B,0x23,0x44,0x15,0x79,0x17,0x33,
+  0xE6,0x29,0x56,0x5F,0xB3,0x1A,0x7E,0x44,0xAE,0x3C,0x0E,0x24,0x4A,0x6F,0x52,0xCB,0x1B,0x58,0x06,0x94,
+  0x2C,0x63,0x95,0x86,0xC8,0x6F,0xAE,0x01,0x03,0xE9,0x72,0x91,0xCD,0x58,0x76,0x35,0x91,0x96,0xD6,0xE9,
+  0xDD,0x47,0xD8,0x1F,0xC0,0xDD,0xE0,0x5D,0x48,0xAC,0x89,0xA7,0x28,0x3A,0xB0,0x2A,0x17,0x48,0x3B,0xE6,
+  0x06,0x01,0x9F,0xAC,0xA3,0x68,0x13,0xBB,0xD7,0x26,0xDA,0xD8,0x61,0x51,0x83,0x94,0x5C,0x7E,0x46,0xD9,
+  0x9B,0xA0,0x00,0xBF,0x4E,0x62,0xDD,0x2C,0x80,0xC8,0x16,0xDE,0xC4,0xD1,0xAC,0xE6,0x15,0x5A,0xF8,0x35,
+  0x70,0x7B,0x2E,0xB3,0x2B,0xA6,0x9B,0xDC,0x0D,0xBE,0x92,0xA7,0x05,0x2D,0x15,0x0B,0x4D,0xF2,0x02,0x8D,
+  0xBD,0xC9,0xC3,0x26,0xB8,0xBC,0x07,0x61,0xD4,0x3C,0x67,0x16,0x22,0x41,0x17,0x83,0xD5,0xF4,0x38,0xC4,
+  0xA7,0x13,0x59,0xA6,0x07,0x89,0x3D,0x74,0x51,0x89,0x79,0xB8,0xA8,0xDE,0x9C,0x86,0x40,0x1E,0x04,0xA3,
+  0x94,0x90,0xB0,0xA4,0x4A,0xFF,0xC1,0xFE,0x4A,0x57,0x0F,0x21,0x84,0xAE,0x0F,0x74,0xCA,0x94,0x81,0xD7,
+  0xF5,0x72,0xC5,0x14,0x7A,0x25,0x57,0xB3,0x4F,0x10,0xB9,0x93,0x87,0x8C,0xEA,0x6C,0xE6,0xC3,0x5D,0xC1,
+  0x0A,0x2A,0x09,0xF0,0x63,0x78,0x8C,0xE6,0x20,0x04,0x40,0x82,0xED,0xEF,0xBF,0x2B,0x16,0xC2,0xF8,0x8A,
+  0xC7,0xCA,0x37,0xA7,0x3E,0x2B,0x83,0x95,0xB3,0xB0,0x5C,0x66,0x8B,0x39,0x48,0x34,0x02,0x82,0x5F,0x97,
+  0x0C,0x1F,0x5F,0x2D,0xDF,0xE4,0x08,0xD2,0xC7,0xEB,0x5E,0xB8,0x32,0x35,0xC2,0x12,0x7F,0x9C,0x38,0x52,
+  0x01,0xAE,0xFC,0x89,0x4D,0xEC,0x9B,0x4F,0x6E,0x54,0x3C,0x1C,0x92,0xC1,0x0D,0x17,0xE0,0x9A,0x51,0x29,
+  0x81,0x40,0x38,0x25,0x9A,0x49,0xA5,0x51,0xFE,0x03,0x32,0xBC,0x51,0x24,0x48,0xD6,0x07,0x44,0x52,0xC8,
+  0x8A,0x89,0xB4,0xB9,0x10,0xCA,0x0E,0x1D,0xAC,0x3E,0x9D,0x4B,0xF1,0x1E,0x96,0xCD,0xDB,0x43,0x1F,0x3C,
+  0x2B,0xA5,0x62,0x5B,0xE0,0x4F,0x70,0x7D,0x1B,0x82,0x93,0xC7,0x16,0x94,0xB7,0x6A,0xBA,0x0D,0x01,0x84,
+  0x28,0xEB,0x2D,0xE0,0xAF,0xEB,0x7A,0x0D,0xFE,0x75,0xD9,0x77,0xC5,0xD8,0x63,0x68,0xC5,0x0B,0x7F,0xAF,
+  0x63,0x47,0xC1,0xCA,0xD8,0xCD,0x2B,0xAA,0x78,0x06,0x5A,0xED,0x5A,0x98,0xAE,0x17,0x2C,0x79,0xD8,0x3C,
+  0x69,0xCD,0xEA,0x0A,0x22,0xF0,0x05,0x9F,0x33,0xB9,0xD0,0x7E,0x4B,0x70,0xB0,0x69,0x26,0x21,0x24,0xC5,
+  0x83,0xBE,0x5E,0xBB,0xEC,0xA3,0x3E,0xD1,0x18,0x55,0x0A,0x6F,0x11,0x06,0x13,0x64,0x10,0x88,0x54,0x9F,
+  0x0F,0x2E,0xD3,0xF4,0xF9,0xEA,0xB9,0x01,0xF1,0x20,0xFC,0x79,0x73,0x35,0xFD,0x3D,0xFD,0xFD,0xFC,0xFD,
+  0xBB,0xA8,0xC2,0x22,0xD8,0x6F,0x30,0xAC,0x4E,0xD5,0x0D,0x47,0xA1,0x20,0x50,0x44,0x85,0xBA,0x61,0xB5,
+  0xC5,0xCC,0xA8,0x62,0x64,0xCD,0x24,0x89,0xE1,0x59,0x3A,0x86,0x11,0x38,0x48,0x26,0x35,0xA3,0x57,0x49,
+  0x1F,0xF6,0xEC,0xDC,0x01,0x42,0x99,0xB2,0x1B,0x0A,0x13,0x89,0x05,0xC3,0x1C,0xB2,0x15,0x0E,0xC3,0x1C,
+  0x68,0xE5,0x9D,0x04,0xBF,0xA2,0xF9,0x92,0xC4,0xDB,0xA5,0x86,0xD1,0x0B,0x59,0xF3,0x9D,0x07,0x7E,0x36,
+  0x7C,0xD4,0xEC,0xAF,0x05,0xC8,0xF3,0x12,0xE5,0xE8,0x16,0xC0,0x07,0xB6,0xD0,0x62,0xAB,0xB3,0x73,0x4D,
+  0xF5,0x42,0x91,0x78,0x51,0xE1,0x93,0xA3,0x07,0xA1,0x72,0x56,0x50,0xA8,0xD7,0xE2,0x35,0x1E,0x96,0x9C,
+  0x5B,0xEC,0xA4,0x31,0xB3,0x55,0x77,0xA3,0xA5,0x4D,0x4E,0xFE,0x0C,0x56,0x0D,0x81,0xF0,0xD2,0xD2,0x97,
+  0xC2,0x4B,0x82,0xDE,0xE9,0xEC,0x18,0x31,0x7C,0xA3,0x29,0xA5,0x6B,0x88,0xBE,0xBC,0x58,0x1A,0xE4,0x01,
+  0xF9,0x72,0x40,0xD6,0xB1,0xA3,0xB5,0xDE,0x8E,0xED,0x76,0x2F,0xEE,0x9A,0xE6,0x5A,0x42,0x2B,0x77,0x6B,
+  0xDC,0xD5,0xEA,0x43,0xDF,0xC4,0x36,0x75,0xBC,0xB2,0x46,0x65,0x64,0xD8,0x04,0x84,0x31,0x21,0xD6,0x42,
+  0xDA,0x78,0x64,0xD3,0x53,0x0F,0x68,0x40,0x3C,0x53,0x76,0xBD,0xA5,0x02,0xE8,0xAB,0x89,0x11,0x9E,0x09,
+  0x68,0xC4,0xD6,0xD3,0x24,0x88,0xB8,0x00,0xB7,0xC5,0x06,0x2E,0xED,0x9F,0x94,0x58,0x19,0x5B,0xFB,0x86,
+  0xF8,0x6A,0xD1,0x6C,0x55,0x6C,0xF4,0x72,0x33,0xC3,0x1C,0x0E,0x5B,0x91,0xAC,0x90,0x6C,0x15,0x95,0x4C,
+  0x4C,0xF5,0x0C,0x99,0x2D,0x41,0xB8,0x73,0x79,0xCD,0x7C,0xEB,0x3C,0x1E,0x64,0x22,0x1F,0x0F,0xE2,0x10,
+  0x8F,0xF9,0xC8,0xD0,0x68,0x72,0xE0,0xB2,0x41,0x4A,0xF8,0x60,0x60,0xF9,0x41,0x30,0x7B,0xE0,0x9A,0xA0,
+  0x0C,0x34,0xAF,0x99,0x8B,0xB6,0x3E,0xB1,0xDB,0x2E,0x1A,0xDA,0x97,0x08,0x7B,0xA6,0xB4,0x7B,0xF0,0x67,
+  0x7E,0x69,0x3D,0x0B,0x88,0x81,0xFE,0xC9,0xB7,0x70,0x41,0xC3,0x56,0x5B,0xC5,0x27,0x7D,0x3B,0x6A,0xD7,
+  0x77,0xAA,0x0C,0x9C,0x2B,0x74,0x77,0xC4,0x3D,0xA1,0x44,0xA6,0x34,0xD9,0xA6,0xCB,0xC6,0x0D,0x91,0x41,
+  0x8B,0x62,0x1A,0x81,0xAE,0xF0,0x0D,0xE9,0x99,0x6B,0x19,0x92,0x16,0xCE,0xD4,0xFF,0x8F,0xE0,0x70,0x75,
+  0x0D,0x63,0x4A,0xFE,0x47,0x30,0xB8,0x9A,0x34,0x8C,0x9A,0x22,0x71,0x83,0x53,0x58,0xFE,0x40,0xF5,0xCC,
+  0x6F,0xA3,0x18,0xE4,0x4C,0xA7,0x65,0x2C,0xFC,0x83,0x10,0xD8,0x49,0xE1,0xC9,0xB2,0xE5,0x02,0x1B,0xAE,
+  0xA5,0x24,0x8A,0xC0,0xF8,0x9A,0x6D,0xA7,0x7D,0x88,0x78,0x0E,0x12,0x37,0xE0,0xBF,0x08,0x0A,0x38,0xEB,
+  0x40,0xFE,0x01,0x9E,0x15,0xA1,0xEF,0xBD,0x11,0x39,0xBB,0x7D,0x5F,0xF8,0x64,0x48,0x02,0x6B,0x1A,0xED,
+  0xA1,0xEE,0x48,0xD8,0x31,0xEB,0xEB,0x82,0x6E,0x83,0x6E,0xB8,0xF3,0x1C,0x2B,0xEF,0x36,0x23,0xFB,0x4D,
+  0x95,0x90,0x1E,0x07,0xBF,0x11,0x12,0x7F,0x86,0x52,0xC0,0xD4,0x77,0xF0,0x03,0x11,0x16,0x7F,0x14,0xE4,
+  0x04,0x72,0xF9,0xD9,0x15,0x11,0x97,0xC9,0x23,0x8D,0x1B,0x01,0x99,0xF4,0xB2,0x59,0x89,0xEC,0x36,0x04,
+  0x8C,0x9F,0x4F,0x59,0x02,0x16,0x21,0x71,0x2B,0x65,0x53,0xC1,0xC4,0x2D,0xF1,0x61,0xCE,0x54,0x16,0xAF,
+  0x49,0x3F,0x0A,0x7E,0x3B,0x8C,0x0F,0x42,0xD7,0xD8,0x13,0x13,0x12,0x1E,0xD9,0x51,0x1B,0xA7,0x5D,0x44,
+  0xF0,0xBB,0x06,0xBF,0x97,0x6E,0xA1,0x21,0xB8,0xBF,0xB7,0x40,0x70,0xF1,0x5E,0xDA,0x12,0xD3,0x2E,0xE3,
+  0xFD,0x7B,0x69,0x4B,0xD5,0x1A,0x1C,0xA8,0xDB,0x4B,0xBB,0xE4,0x05,0x81,0x15,0x77,0xD7,0xA6,0xDA,0x6A,
+  0xCD,0x64,0xDB,0x1D,0x66,0x64,0x3B,0xBB,0x86,0x38,0xDB,0xE6,0x05,0x21,0x4F,0x3A,0x41,0xAD,0xE0,0xB5,
+  0xB2,0xD9,0xD4,0x45,0x95,0x8E,0x5D,0xB5,0x51,0x05,0xD7,0xFA,0x51,0xC5,0x01,0xDB,0x33,0x23,0xAC,0x9A,
+  0x1D,0xF0,0xF8,0x30,0x58,0xB9,0xD5,0xDC,0xF4,0x1E,0x7F,0xC8,0x1B,0xE8,0x0B,0x2D,0x12,0xD2,0x58,0x4B,
+  0xA9,0xBF,0x2D,0xBC,0x20,0x64,0x27,0xB8,0x00,0x11,0x36,0x27,0x01,0x31,0x18,0x55,0x70,0xDB,0x02,0x36,
+  0xBC,0xC0,0xCE,0x18,0xAD,0x7B,0x85,0xF7,0x40,0xAA,0xFF,0xFA,0x35,0x00,0x64,0x6F,0x40,0xBF,0x4A,0x9A,
+  0x93,0x61,0xD5,0x11,0xDC,0xAB,0x65,0x4D,0xF0,0x6A,0x56,0x06,0x83,0xC4,0x05,0xD7,0x4E,0x60,0x85,0xC3,
+  0x6B,0xCE,0xB6,0x07,0xD6,0xDB,0xB4,0x0B,0xD2,0x84,0x48,0x20,0xFD,0xD6,0x1A,0x48,0xBA,0x00,0xFF,0x2C,
+  0xB8,0xC0,0xD2,0x0A,0x77,0xFE,0x76,0x34,0x7E,0x1C,0x8E,0xE1,0xDC,0x41,0x2B,0x99,0x08,0xDB,0x9C,0x4F,
+  0x1C,0x4C,0x10,0x45,0x84,0xCE,0x8A,0xBF,0x83,0xDB,0x56,0xAE,0xAD,0x60,0x3B,0xE1,0xDA,0x7B,0x60,0xD0,
+  0x0B,0xAC,0x60,0x15,0xD5,0x68,0xF5,0x1A,0xDE,0x1A,0xB3,0x87,0x1F,0x74,0x6D,0xF8,0x41,0x47,0xB7,0xF2,
+  0x7A,0xE8,0x18,0x96,0x00,0x32,0xDA,0x4C,0x89,0xBC,0xCC,0xA1,0x6D,0x4B,0x9F,0xF2,0xE3,0xAE,0x47,0x19,
+  0x07,0x6E,0x48,0xB7,0xFE,0xDB,0x3A,0x8D,0xF5,0xDF,0xD6,0x57,0xBA,0xCE,0xDB,0xDE,0x6C,0xAB,0xE3,0xE1,
+  0x10,0x5B,0x76,0x96,0x41,0x29,0xB5,0xF4,0xCC,0xC8,0x0F,0xCC,0x02,0x94,0xE7,0x51,0xE8,0x20,0xA1,0x8B,
+  0xA3,0x55,0xE4,0xA1,0xF7,0x41,0x17,0x09,0x15,0xB4,0x82,0xC0,0x47,0x73,0x4F,0x43,0x6B,0x78,0x33,0x93,
+  0x90,0xBB,0xF3,0x16,0x97,0x81,0xB7,0x2D,0xBD,0x97,0x16,0x3B,0xF4,0xA0,0x0B,0x2D,0x16,0x35,0x00,0x76,
+  0xCF,0xA3,0xEA,0x0A,0xCE,0x01,0x8B,0x70,0x7A,0x5D,0x7B,0xB9,0x89,0xB0,0xE0,0xDE,0x8D,0xED,0x3C,0x7B,
+  0x19,0x74,0x42,0x1B,0xCA,0xC5,0x99,0x9B,0x11,0x76,0xAB,0x7C,0xF0,0xAA,0xD4,0xB9,0x12,0x17,0xD0,0x95,
+  0x6A,0xD4,0xC1,0xFE,0x61,0x10,0x4E,0xF4,0x6E,0x93,0x30,0x7D,0x6A,0x63,0x11,0x00,0x18,0xF5,0xA6,0x02,
+  0x09,0xAE,0xB8,0x36,0xFE,0x2D,0xB6,0xD1,0x46,0xDC,0x64,0x0D,0xDD,0x0C,0x0A,0x3A,0x15,0xE6,0x23,0x6F,
+  0x06,0xBA,0xD0,0xE3,0x4D,0x3E,0x09,0x92,0x4D,0x3E,0xEC,0x59,0x08,0x63,0x89,0x3E,0x61,0x65,0x09,0x51,
+  0x23,0xCA,0x64,0x79,0x5E,0x51,0x91,0xBE,0x48,0x70,0x2F,0x83,0x55,0x93,0xB7,0x28,0xF4,0xF0,0x22,0x3F,
+  0x31,0xD3,0x5B,0x20,0x20,0xE8,0x16,0x99,0xDE,0x8E,0xD6,0xB4,0x9F,0x94,0xFA,0xC6,0x59,0x84,0x60,0x3B,
+  0x6D,0x5E,0xDD,0x29,0x42,0xBC,0xFF,0x20,0x7D,0x44,0x25,0xDE,0xBE,0xB1,0x78,0xD8,0x4D,0xEF,0x45,0xB2,
+  0xB1,0x7B,0xD4,0xAB,0xE2,0x36,0x77,0x8F,0xBB,0xBB,0xAA,0x89,0xD2,0xA0,0xA2,0x6F,0x51,0x1F,0x3C,0x3A,
+  0xE5,0xD5,0x34,0xE7,0x92,0x24,0xB8,0xE0,0x86,0xA2,0x26,0xC5,0x9A,0x05,0xAB,0xCC,0x02,0x11,0x0C,0x4F,
+  0x3D,0x81,0x02,0xC0,0x66,0xE9,0x61,0x26,0x67,0x62,0x2D,0xA0,0x8D,0xE4,0x60,0x42,0x39,0x3A,0x18,0x9F,
+  0x82,0xD1,0xBA,0x44,0x21,0xD2,0xD4,0xA5,0x6F,0x30,0x5B,0x9B,0x96,0x20,0xFC,0x61,0xAF,0x65,0x5F,0xC6,
+  0xC7,0x41,0x93,0xAD,0x0E,0x4D,0x9C,0x44,0x3B,0xF6,0xD6,0x4B,0xCD,0x00,0x41,0x34,0x2D,0x5A,0x93,0xDA,
+  0x0E,0x03,0x77,0xD3,0x8F,0x3F,0xDC,0x1E,0xBD,0x3A,0xF9,0x89,0x24,0xDD,0xDD,0xA3,0xFE,0xEE,0xCF,0x86,
+  0x9C,0x1A,0x8D,0xC6,0x5A,0xCF,0xE1,0x65,0x47,0xBA,0x04,0xAB,0x6D,0x92,0x74,0xB6,0x8F,0x7A,0xDB,0x6E,
+  0xC0,0xD8,0x83,0x38,0xEE,0x41,0xE0,0x28,0x71,0xF3,0x8A,0xA6,0x6A,0x59,0xC3,0x0D,0x52,0x43,0xD4,0x93,
+  0xE5,0x5D,0x3B,0xA8,0x6B,0xA4,0xCC,0x43,0xA3,0x31,0x95,0x6E,0x99,0x60,0xA8,0x57,0xCB,0x77,0xB0,0xE7,
+  0x3B,0xA5,0x1A,0xD5,0xC3,0xD3,0xB9,0x99,0xAB,0xF4,0x73,0x8C,0x3D,0xE4,0x51,0x76,0x01,0x99,0xD9,0x1D,
+  0x48,0x2A,0x91,0x99,0x4D,0x61,0x0E,0x71,0x67,0xAC,0x77,0x6C,0x85,0x68,0x3B,0xB9,0x4E,0xB0,0x76,0x70,
+  0xA6,0x08,0xAC,0x14,0x2D,0x80,0x9B,0x66,0xDE,0x68,0x9C,0xAD,0x53,0x10,0xBA,0x52,0xA3,0xCB,0xAA,0xC5,
+  0x70,0xED,0x18,0xF9,0x50,0x32,0x8A,0x9A,0xB7,0x63,0x6E,0x6A,0x04,0x41,0xFA,0x45,0x79,0x3B,0x80,0xC4,
+  0x8A,0xAF,0x15,0xD4,0x8E,0x4A,0xCF,0xC6,0x9C,0xAF,0x57,0x7A,0x9D,0x9A,0xC7,0xAD,0x1A,0xB6,0x63,0xCB,
+  0xDB,0x37,0x95,0x7F,0x58,0xF4,0x75,0xD9,0xEC,0xD2,0xEC,0x26,0xBD,0xAB,0xA6,0xC4,0xAA,0x6A,0x39,0xAF,
+  0x80,0x5D,0x37,0x12,0xB6,0x39,0x02,0x4A,0x5D,0xE7,0xB7,0x50,0xC9,0x62,0xA8,0x4F,0x53,0xB1,0x28,0xCB,
+  0xFB,0x7B,0xF3,0x48,0x48,0xF3,0x80,0xD5,0xF7,0x76,0x6E,0xCD,0x35,0xFF,0x0F,0xB3,0xB9,0x61,0xB6,0x4D,
+  0x94,0x7F,0x93,0xD3,0xBE,0x42,0xDD,0x14,0xB7,0xB1,0x5C,0xE1,0xE2,0x83,0x9B,0xC8,0xB6,0x37,0xA6,0x8F,
+  0xA8,0x68,0xA2,0x9B,0xBA,0xDB,0x44,0x31,0x0C,0xA1,0x4F,0x61,0xBD,0xB0,0x0E,0x29,0x4F,0x19,0x9C,0x48,
+  0x05,0x14,0x9C,0x55,0x49,0x33,0xE6,0x0F,0xA3,0x7F,0x7E,0xFE,0x32,0xFC,0xF2,0xE5,0x72,0x18,0x7A,0xCF,
+  0x9F,0x37,0x22,0xCE,0xAD,0x28,0x73,0xE7,0x24,0x38,0x93,0xDC,0x56,0x84,0x0F,0xF2,0x01,0x80,0x0D,0x4C,
+  0xE4,0xD9,0x2A,0x74,0x3B,0x00,0x79,0xC5,0xA6,0x5C,0x90,0xB0,0x82,0x0A,0x3D,0x36,0xE3,0x4D,0x24,0x35,
+  0x56,0x77,0x0F,0xCD,0x75,0xEA,0x6E,0x7C,0x8C,0xF3,0xA8,0x95,0xBD,0xA3,0x9D,0xDB,0x06,0x91,0x19,0xC8,
+  0x46,0xF6,0x83,0x29,0xC1,0x8F,0x6F,0x24,0xB1,0x30,0x38,0xE9,0x6D,0xB6,0xDD,0xB8,0x16,0xF2,0x70,0x29,
+  0xB3,0x2B,0xDB,0x65,0xE1,0x04,0x35,0x55,0x0C,0xFA,0x32,0x3B,0x8A,0xF5,0x2B,0xC0,0x70,0x53,0xAF,0xA7,
+  0x7D,0x0E,0xE0,0x76,0x35,0xC9,0xBD,0x79,0xCE,0x9A,0x9F,0x8D,0xCE,0xB8,0x3B,0xE7,0x59,0x37,0xC6,0x3B,
+  0x98,0x32,0x65,0x4C,0xC5,0x6A,0x9C,0x65,0x0F,0xC8,0x33,0xD2,0xED,0x1E,0x94,0xB9,0x08,0x54,0xF1,0xC2,
+  0x15,0x7A,0x19,0x44,0x80,0xBA,0xE5,0x08,0x59,0x74,0x43,0xB6,0xDD,0xC4,0xBE,0x16,0x79,0x9F,0xD2,0xF5,
+  0xA4,0x64,0xAB,0x08,0xCD,0xC8,0xDB,0x00,0xF5,0x02,0xB0,0xE7,0x4D,0xEF,0xCE,0xF9,0xC4,0x6F,0xC6,0x0C,
+  0xBD,0x7E,0xDB,0xEE,0x34,0x46,0x5D,0xEC,0xB2,0xD0,0xB0,0xC8,0xCD,0x70,0xF8,0x4C,0xD6,0xF3,0x53,0xAA,
+  0xA9,0xDF,0x3A,0xB4,0x45,0x30,0xB3,0xFE,0xA0,0x89,0xB1,0xF7,0xF7,0x7B,0xC3,0x2F,0x91,0x3F,0xD3,0xF3,
+  0x7B,0xFC,0xFE,0x7E,0x9F,0x29,0x75,0xFF,0x27,0xFE,0x2B,0xC5,0xBD,0xBA,0x9E,0xDE,0xEB,0x5B,0x7D,0x7F,
+  0x3B,0x2F,0x83,0x7F,0x0C,0x39,0x14,0xE5,0x4A,0xFB,0x85,0x49,0xDF,0x50,0x09,0x62,0x5A,0x97,0x85,0x77,
+  0x02,0x61,0x04,0x05,0x0E,0x24,0x9E,0x6B,0x88,0xCB,0x73,0x10,0x64,0xDB,0x05,0x90,0x4E,0xD3,0x57,0xE4,
+  0x2E,0xAD,0xA3,0x75,0x93,0x70,0x5B,0xB3,0x99,0x74,0x60,0xD0,0x2B,0xC3,0x47,0x0E,0x6A,0x33,0x0B,0x70,
+  0xF7,0x07,0x53,0x15,0x74,0x77,0xD0,0xBD,0xE1,0x94,0x0D,0xAE,0xF5,0x83,0xA8,0xE2,0x15,0xBB,0x98,0xD5,
+  0x72,0x31,0x9D,0xF9,0x08,0xF3,0x88,0x34,0x64,0x9E,0x03,0xF3,0x41,0x10,0x81,0x0D,0x83,0x30,0x23,0x28,
+  0x7F,0xC5,0x7A,0x12,0x39,0xB1,0xFA,0xEF,0x52,0x81,0x1F,0x78,0xC2,0x49,0x68,0xB9,0x1E,0x90,0x68,0x7A,
+  0xE7,0xEA,0xD2,0x82,0xE1,0x14,0xAF,0xFD,0x34,0x1C,0xAE,0xEC,0x57,0xB0,0xD8,0x7E,0x39,0x0E,0xF1,0x1B,
+  0x74,0x5C,0xE4,0x0F,0x9B,0x57,0xB8,0x91,0xB3,0x55,0xB8,0xB5,0x93,0x07,0x97,0x7A,0x47,0x43,0xF7,0xD9,
+  0x63,0x34,0xB4,0x5F,0xB0,0x87,0xE6,0xFF,0x88,0xF8,0x1F,0xFE,0x65,0xE1,0xA7,0x27,0x21,0x00,0x00
+};
+#endif
+#endif
+
+// Sorted by url, required for the binary search in findAsset
+constexpr EmbeddedAsset embeddedAssets[] = {
+#if embedMain
+  {"/Main.htm", "/Main.htm", "text/html", main_htm_gz, sizeof(main_htm_gz), "\"84c632a3521293db\"", 0},
+#else
+  {"/Main.htm", "/Main.htm", "text/html", NULL, 0, NULL, 0},
+#endif
+#if useSerialWS
+#if embedSerialWS
+  {"/SerialWS", SerialHTM, "text/html", serialws_htm_gz, sizeof(serialws_htm_gz), "\"b7be81d493cede4f\"", AssetAdmin},
+#else
+  {"/SerialWS", SerialHTM, "text/html", NULL, 0, NULL, AssetAdmin},
+#endif
+#endif
+#if embedAdmin
+  {"/admin", AdminHTM, "text/html", admin_htm_gz, sizeof(admin_htm_gz), "\"883303e8e2191cf9\"", AssetAdmin},
+#else
+  {"/admin", AdminHTM, "text/html", NULL, 0, NULL, AssetAdmin},
+#endif
+#if embedFavicon
+  {"/favicon.ico", FavIcon, "image/x-icon", favicon_ico_gz, sizeof(favicon_ico_gz), "\"ab5d9c497cedef84\"", 0},
+#else
+  {"/favicon.ico", FavIcon, "image/x-icon", NULL, 0, NULL, 0},
+#endif
+#if UseFileManager
+#if embedFileman
+  {"/fileman", FilAdminHTM, "text/html", fileman_htm_gz, sizeof(fileman_htm_gz), "\"84aae9e20ae99b73\"", AssetAdmin},
+#else
+  {"/fileman", FilAdminHTM, "text/html", NULL, 0, NULL, AssetAdmin},
+#endif
+#endif
+};
+constexpr size_t numEmbeddedAssets = sizeof(embeddedAssets) / sizeof(EmbeddedAsset);
+static_assert(assetsSorted(embeddedAssets, numEmbeddedAssets), "embeddedAssets must be sorted by url");
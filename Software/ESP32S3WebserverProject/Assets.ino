@@ -0,0 +1,61 @@
+// Core webpages (main page, admin, file manager, SerialWS, favicon) are served by a single handler from the
+// table embeddedAssets[] in Assets.h, which is generated by Software/Tools/bundleAssets.py from the HTML directory.
+// Embedded pages are sent gzipped straight from flash with an ETag, so a browser revalidating gets a 304.
+// Pages that are not embedded (see embedMain, embedAdmin, ... in customize.h) are served from the file system.
+
+class EmbeddedAssetHandler : public AsyncWebHandler {
+  public:
+    virtual bool canHandle(AsyncWebServerRequest *request) override {
+      if((request->method() != HTTP_GET) || (assetFor(request) == NULL)) return false;
+      request->addInterestingHeader("If-None-Match");             // Other headers are dropped once the handler is chosen
+      request->addInterestingHeader("If-Modified-Since");         // (Pages that aren't embedded need these too, see sendStaticFile)
+      request->addInterestingHeader("Accept-Encoding");
+      return true;
+    }
+    virtual void handleRequest(AsyncWebServerRequest *request) override {
+      metricsScope(MetricAssets);
+      metricsBytes(sendAsset(request, assetFor(request)));
+    }
+  private:
+    const EmbeddedAsset *assetFor(AsyncWebServerRequest *request){
+      const char *url = request->url().c_str();
+      if(strcmp(url, "/") == 0) url = DefaultHTM;                  // The default page may be one of them
+      return findAsset(url);
+    }
+};
+
+// Adds the handler for all core webpages. Must be added before addStaticFiles!
+void addEmbeddedAssets(){
+  server.addHandler(new EmbeddedAssetHandler());
+}
+
+// Binary search of embeddedAssets[] by url. NULL if there is no such page
+const EmbeddedAsset *findAsset(const char *url){
+  int lo = 0;
+  int hi = numEmbeddedAssets - 1;
+  while(lo <= hi){
+    int mid = (lo + hi) / 2;
+    int cmp = strcmp(url, embeddedAssets[mid].url);
+    if(cmp == 0) return &embeddedAssets[mid];
+    if(cmp < 0) hi = mid - 1;
+    else lo = mid + 1;
+  }
+  return NULL;
+}
+
+// Sends a core webpage. Embedded from flash, otherwise from the file system. Returns the bytes of the body sent
+size_t sendAsset(AsyncWebServerRequest *request, const EmbeddedAsset *asset){
+  if((asset->flags & AssetAdmin) && !adminAllowed(request)) return 0;
+  if(asset->data == NULL)
+    return sendStaticFile(request, (StandardFiles == onSD) ? FSUsageSD : FSUsageLittleFS, asset->file);
+  if(request->hasHeader("If-None-Match") && (strcmp(request->header("If-None-Match").c_str(), asset->etag) == 0)){
+    request->send(304);                                            // Browser already has this version
+    return 0;
+  }
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset->mime, asset->data, asset->len);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset->etag);
+  response->addHeader("Cache-Control", cacheRule);
+  request->send(response);
+  return asset->len;
+}
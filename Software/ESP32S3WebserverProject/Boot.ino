@@ -0,0 +1,155 @@
+// Staged boot
+// setup() only does what is needed to answer requests: parameters, access point, routes and server.begin().
+// Everything that may take long is finished in the background by two tasks, so the server is reachable right away:
+// - bootStorage mounts LittleFS and the SD/MMC card (retrying until they are there), computes file system usage,
+//   loads the asset cache and validates the standard files.
+// - bootNetwork starts mDNS, waits for the WiFi connection (3 attempts of 5 seconds) and synchronizes the time.
+//   Once storage is ready too, it reports the server online (Serial and Telegram).
+// Their progress is signalled in the bootEvents event group. Until BootStorageBit is set, routes that need the file
+// systems answer 503 with Retry-After (see storageAvailable). Each phase is recorded in a timeline (milliseconds
+// since reset), shown in /status.
+
+#define BootStorageBit  (1 << 0)                        // File systems mounted, usage computed, files validated
+#define BootWiFiBit     (1 << 1)                        // Connected to WiFi (got an IP address)
+#define BootDoneBit     (1 << 2)                        // All phases finished
+
+#define BootPhases 16                                   // Entries in the timeline. Further phases aren't recorded
+
+typedef struct {const char *phase;                      // What happened
+                uint32_t ms;                            // Milliseconds since reset
+               } BootPhase;
+BootPhase bootTimeline[BootPhases];
+int bootNumPhases = 0;
+portMUX_TYPE bootMux = portMUX_INITIALIZER_UNLOCKED;
+EventGroupHandle_t bootEvents = NULL;
+
+// Creates the event group. Call first thing in setup(), before anything records a phase or checks for storage
+void initBoot(){
+  bootEvents = xEventGroupCreate();
+  bootMark("Setup started");
+}
+
+// Starts the background stages. Call from setup() once the server is running
+void startBoot(){
+  xTaskCreate(bootStorage, "bootStorage", 8192, NULL, 1, NULL);
+  xTaskCreate(bootNetwork, "bootNetwork", 8192, NULL, 1, NULL);
+}
+
+// Records a phase in the timeline
+void bootMark(const char *phase){
+  uint32_t ms = esp_timer_get_time() / 1000;
+  portENTER_CRITICAL(&bootMux);
+  if(bootNumPhases < BootPhases) bootTimeline[bootNumPhases++] = {phase, ms};
+  portEXIT_CRITICAL(&bootMux);
+  logEvent(LogBootPhase, phase, ms);
+}
+
+bool bootStorageReady(){
+  return bootEvents && (xEventGroupGetBits(bootEvents) & BootStorageBit);
+}
+
+bool bootDone(){
+  return bootEvents && (xEventGroupGetBits(bootEvents) & BootDoneBit);
+}
+
+// Answers 503 if the file systems aren't ready yet. Returns true if they are and the request may go on
+bool storageAvailable(AsyncWebServerRequest *request){
+  if(bootStorageReady()) return true;
+  AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "Starting up, storage is not ready yet");
+  response->addHeader("Retry-After", "2");
+  request->send(response);
+  return false;
+}
+
+// Called by the WiFi driver when the connection got an IP address, on the first connect as well as reconnects
+void bootWiFiConnected(WiFiEvent_t event, WiFiEventInfo_t info){
+  if(!(xEventGroupGetBits(bootEvents) & BootWiFiBit)) bootMark("WiFi connected");
+  xEventGroupSetBits(bootEvents, BootWiFiBit);
+}
+
+// Task mounting the file systems and preparing everything that needs them
+void bootStorage(void *parameter){
+#if UseLittleFS
+  initLittleFS();                                       // Initialize LittleFS (files in flash)
+  bootMark("LittleFS mounted");
+#endif
+#if ((SDType == TypeSD)  || (SDType == TypeMMC))
+  initSDCard();                                         // Start the SD or SD_MMC card and library
+  bootMark("SD card mounted");
+#endif
+  initFSUsage();                                        // Compute file system capacity and usage once. It is cached from here on
+#if UseAssetCache
+  initAssetCache();                                     // Set up the PSRAM file cache and preload files listed in AssetCachePreload
+#endif
+  validateFiles();
+  xEventGroupSetBits(bootEvents, BootStorageBit);       // Storage routes answer from here on
+  bootMark("Storage ready");
+  vTaskDelete(NULL);
+}
+
+// Task connecting to the network, then reporting the server online
+void bootNetwork(void *parameter){
+  initMDNS();                                           // Initiate MDNS so the webserver is available in the local network under its name
+  bootMark("mDNS started");
+  if(ssid[0] > 0){                                      // startWiFi began the first attempt
+    for(int i = 0; i < 3; i++){
+      if(xEventGroupWaitBits(bootEvents, BootWiFiBit, pdFALSE, pdTRUE, pdMS_TO_TICKS(5000)) & BootWiFiBit) break;
+      if(i < 2){
+        WiFi.disconnect();                              // Start over with a clean WiFi stack
+        WiFi.begin((char*)ssid, (char*)password);
+      }
+    }
+#if serialEnabled && setupVerbose
+    if(WiFi.isConnected()){                             // Show the user the WiFi connected to and the server IP.
+      char buff[1000];
+      snprintf(buff, 1000, "Connected to %s on %s\n", WiFi.SSID(), WiFi.localIP().toString());
+      serialPrint(buff,true);
+    } else {
+      serialPrint("WiFi not connected (yet)\n",true);
+    }
+#endif
+  }
+  if(WiFi.isConnected()){
+#if serialEnabled && setupVerbose
+    {  char buff[200];
+       snprintf(buff,200,"Synchronizing time to: %s\n", ntpserver);
+       serialPrint(buff,true);
+    }
+#endif
+    int count = 0;
+    while(!synchDateTime()){                            // Synchronize date & time to NTP server. Configure timezone and DST
+      if(++count > 9) break;
+    }
+    bootMark(count > 9 ? "Time synchronization failed" : "Time synchronized");
+  }
+
+  xEventGroupWaitBits(bootEvents, BootStorageBit, pdFALSE, pdTRUE, portMAX_DELAY);
+  xEventGroupSetBits(bootEvents, BootDoneBit);
+  bootMark("Boot complete");
+  char stat[1000];
+#if serialEnabled && setupVerbose
+  serialPrint("Server is online\n",false);
+  serverStatus(stat);
+  serialPrint(stat,false);
+  serialPrint("\n",true);
+#endif
+#if (((UseTelegram == TelegramSend) || (UseTelegram == TelegramSendReceive)) && TelegramOnBoot)
+  sprintf(stat, "%s started", hostname);
+  serverStatus(stat);
+  sendTelegramMsg(0, tgChatID, stat);
+  if(TelegramAltOnBoot)sendTelegramMsg(0, tgAltChatID, stat);
+#endif
+  vTaskDelete(NULL);
+}
+
+// Adds the boot timeline to the status
+void bootStatus(Print &out){
+  BootPhase timeline[BootPhases];
+  portENTER_CRITICAL(&bootMux);
+  int n = bootNumPhases;
+  memcpy(timeline, bootTimeline, n * sizeof(BootPhase));
+  portEXIT_CRITICAL(&bootMux);
+  out.print("Boot timeline (ms since reset):\n");
+  for(int i = 0; i < n; i++)
+    out.printf("%6u %s\n", timeline[i].ms, timeline[i].phase);
+}
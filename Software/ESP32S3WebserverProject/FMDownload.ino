@@ -0,0 +1,316 @@
+// File manager downloads
+// /download supports a single byte range (Range, 206 Partial Content, If-Range), so an interrupted download of a big
+// file can be resumed by the browser instead of starting over.
+// Files are read by the FMreader task into two large buffers per download (in PSRAM if available) while the async
+// TCP task sends the other one, so SD reads overlap with sending.
+// At most FMmaxDownloads files are open for downloads at any time. Further downloads wait their turn in a queue of
+// FMdownloadQueue (their headers are sent, their data follows once a slot is free). More than that get a 503.
+// Empty files need no slot and don't wait.
+
+#if(UseFileManager)
+
+#define FMdlFree    0                                  // Slot is available
+#define FMdlOpening 1                                  // Assigned to a download, FMreader has to open the file
+#define FMdlActive  2                                  // FMreader fills the buffers, the response sends them
+#define FMdlFailed  3                                  // File couldn't be read
+#define FMdlClosing 4                                  // Download is done, FMreader has to close the file
+
+#define FMdlPatienceMs 500                             // A waiting download that didn't ask for a slot this long doesn't hold up those behind it
+
+// A download slot. It owns an open file and the read-ahead buffers. Only FMreader opens, reads and closes the file.
+// If the file can't be opened, FMreader frees the slot right away. The download notices by the changed ticket
+typedef struct {volatile int state;                    // FMdlFree, FMdlOpening, ...
+                volatile uint32_t ticket;              // Download the slot is assigned to. 0 if none
+                File file;
+                int fsNum;                             // File system (index into fmFS) and
+                char path[256];                        // path of the file
+                size_t pos;                            // Next byte to read
+                size_t end;                            // Last byte to read
+                uint8_t *buf[2];                       // Read-ahead buffers
+                size_t len[2];                         // Bytes in each buffer
+                volatile bool full[2];                 // Buffer was filled by FMreader and not yet sent completely
+                int fill;                              // Buffer FMreader fills next
+                int send;                              // Buffer the response sends from
+                size_t sendOff;                        // Bytes of that buffer already sent
+               } FMdlSlot;
+FMdlSlot FMdlSlots[FMmaxDownloads];
+
+// A download waiting for a slot
+typedef struct {uint32_t ticket;
+                unsigned long asked;                   // millis() when it last asked for a slot
+               } FMdlWaiter;
+FMdlWaiter FMdlQueue[FMdownloadQueue];                 // Downloads waiting for a slot, oldest first
+int FMdlWaiting = 0;
+uint32_t FMdlNextTicket = 1;
+portMUX_TYPE FMdlMux = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t FMreaderTask = NULL;
+
+void FMdownloadInit(){
+  xTaskCreate(FMreader, "FMreader", 4096, NULL, 2, &FMreaderTask);   // Below the async TCP task, above loop()
+}
+
+// Sends fName (path within file system fsNum), honoring Range and If-Range
+void FMsendDownload(AsyncWebServerRequest *request, int fsNum, const char *path, const char *fName){
+  char full[300];
+  struct stat st;
+  snprintf(full, sizeof(full), "%s%s", fmFS[fsNum].mount, path);
+  if((stat(full, &st) != 0) || S_ISDIR(st.st_mode)){
+    request->send(404);
+    return;
+  }
+  size_t total = st.st_size;
+  char etag[40];                                        // Same as for static files (see sendStaticFile)
+  snprintf(etag, sizeof(etag), "\"%x-%lx\"", total, (unsigned long)st.st_mtime);
+  char lastModified[32] = "";
+  if(st.st_mtime > 0){
+    struct tm t;
+    gmtime_r(&st.st_mtime, &t);
+    strftime(lastModified, sizeof(lastModified), "%a, %d %b %Y %H:%M:%S GMT", &t);
+  }
+
+  size_t start = 0;
+  size_t end = (total > 0) ? total - 1 : 0;
+  int range = 0;                                        // 0 = whole file, 1 = partial, -1 = not satisfiable
+  if(request->hasHeader("Range")){
+    bool current = true;                                // If-Range: only send a part if the file didn't change since
+    if(request->hasHeader("If-Range")){
+      const char *ifRange = request->header("If-Range").c_str();
+      current = (strcmp(ifRange, etag) == 0) || (lastModified[0] && (strcmp(ifRange, lastModified) == 0));
+    }
+    if(current) range = FMparseRange(request->header("Range").c_str(), total, start, end);
+  }
+  if(range < 0){
+    char contentRange[40];
+    snprintf(contentRange, sizeof(contentRange), "bytes */%u", total);
+    AsyncWebServerResponse *response = request->beginResponse(416);
+    response->addHeader("Content-Range", contentRange);
+    request->send(response);
+    return;
+  }
+
+  FMdlRequest *d = new FMdlRequest;
+  d->slot = -1;
+  d->fsNum = fsNum;
+  strlcpy(d->path, path, sizeof(d->path));
+  d->start = start;
+  d->length = (total > 0) ? end - start + 1 : 0;
+  d->ticket = 0;
+  bool queued = true;
+  if(d->length == 0) d->slot = -2;                      // Nothing to read: no slot, no place in the queue
+  else {
+    portENTER_CRITICAL(&FMdlMux);
+    queued = (FMdlWaiting < FMdownloadQueue);
+    if(queued){
+      d->ticket = FMdlNextTicket++;
+      FMdlQueue[FMdlWaiting++] = {d->ticket, millis()};
+    }
+    portEXIT_CRITICAL(&FMdlMux);
+  }
+  if(!queued){                                          // Too many downloads already
+    delete d;
+    AsyncWebServerResponse *response = request->beginResponse(503);
+    response->addHeader("Retry-After", "10");
+    request->send(response);
+    return;
+  }
+
+  AsyncWebServerResponse *response = request->beginResponse(staticContentType(path), d->length,
+    [d](uint8_t *buffer, size_t maxLen, size_t index) -> size_t { return FMdlFillResponse(d, buffer, maxLen, index); });
+  if(range > 0){
+    char contentRange[60];
+    snprintf(contentRange, sizeof(contentRange), "bytes %u-%u/%u", start, end, total);
+    response->setCode(206);
+    response->addHeader("Content-Range", contentRange);
+  }
+  char disposition[300];
+  snprintf(disposition, sizeof(disposition), "attachment; filename=\"%s\"", fName);
+  response->addHeader("Content-Disposition", disposition);
+  response->addHeader("Accept-Ranges", "bytes");
+  response->addHeader("ETag", etag);
+  if(lastModified[0]) response->addHeader("Last-Modified", lastModified);
+  response->addHeader("Server", hostname);
+  request->onDisconnect([d](){ FMdlDone(d); delete d; });
+  request->send(response);
+}
+
+// Parses a Range header such as bytes=100-199, bytes=100- or bytes=-100 (the last 100 bytes).
+// Returns 1 and sets start and end for a single satisfiable range, -1 if it can't be satisfied,
+// 0 if it should be ignored (malformed, or several ranges) and the whole file is sent.
+int FMparseRange(const char *range, size_t total, size_t &start, size_t &end){
+  if((strncmp(range, "bytes=", 6) != 0) || strchr(range, ',')) return 0;
+  const char *p = range + 6;
+  char *e;
+  if(*p == '-'){                                        // Suffix range
+    unsigned long n = strtoul(p + 1, &e, 10);
+    if((e == p + 1) || (*e != 0)) return 0;
+    if((n == 0) || (total == 0)) return -1;
+    start = (n >= total) ? 0 : total - n;
+    end = total - 1;
+    return 1;
+  }
+  unsigned long a = strtoul(p, &e, 10);
+  if((e == p) || (*e != '-')) return 0;
+  p = e + 1;
+  unsigned long b = total - 1;
+  if(*p){
+    b = strtoul(p, &e, 10);
+    if((e == p) || (*e != 0) || (b < a)) return 0;
+  }
+  if(a >= total) return -1;
+  start = a;
+  end = (b >= total) ? total - 1 : b;
+  return 1;
+}
+
+// Fills the response buffer. Called by the async TCP task whenever it can send more.
+// RESPONSE_TRY_AGAIN makes it call again later: while waiting in the queue, or if FMreader is behind.
+size_t FMdlFillResponse(FMdlRequest *d, uint8_t *buffer, size_t maxLen, size_t index){
+  if(d->slot == -1){
+    d->slot = FMdlAcquire(d);
+    if(d->slot < 0) return RESPONSE_TRY_AGAIN;
+  }
+  if(d->slot < 0) return 0;
+  FMdlSlot &s = FMdlSlots[d->slot];
+  portENTER_CRITICAL(&FMdlMux);
+  int state = (s.ticket == d->ticket) ? s.state : FMdlFree;
+  portEXIT_CRITICAL(&FMdlMux);
+  if(state == FMdlFree){                                // Open failed and FMreader gave the slot back. Sends nothing
+    d->slot = -2;
+    return 0;
+  }
+  if(state == FMdlFailed){                              // Read failed. Ends the (now incomplete) response and gives up
+    FMdlDone(d);                                        // the slot right away, not only once the client disconnects
+    return 0;
+  }
+  if(state == FMdlOpening) return RESPONSE_TRY_AGAIN;
+  if(!s.full[s.send]) return RESPONSE_TRY_AGAIN;
+  size_t n = min(maxLen, s.len[s.send] - s.sendOff);
+  memcpy(buffer, s.buf[s.send] + s.sendOff, n);
+  s.sendOff += n;
+  if(s.sendOff == s.len[s.send]){                       // Buffer sent, FMreader may fill it again
+    s.sendOff = 0;
+    s.full[s.send] = false;
+    s.send ^= 1;
+    xTaskNotifyGive(FMreaderTask);
+  }
+  if(index + n >= d->length) FMdlDone(d);               // All read, close the file right away
+  return n;
+}
+
+// Gets a free slot for a waiting download. -1 if this download has to wait.
+// Any waiting download may take a free slot, unless older ones that are still asking need all the free slots.
+// So slots go in the order downloads came, but an older one whose client doesn't take data holds up nobody.
+int FMdlAcquire(FMdlRequest *d){
+  int slot = -1;
+  unsigned long now = millis();
+  portENTER_CRITICAL(&FMdlMux);
+  int pos = -1, ahead = 0, freeSlots = 0;
+  for(int i = 0; (i < FMdlWaiting) && (pos < 0); i++){
+    if(FMdlQueue[i].ticket == d->ticket){
+      pos = i;
+      FMdlQueue[i].asked = now;
+    } else if(now - FMdlQueue[i].asked < FMdlPatienceMs) ahead++;
+  }
+  for(int i = 0; i < FMmaxDownloads; i++){
+    if(FMdlSlots[i].state != FMdlFree) continue;
+    if(slot < 0) slot = i;
+    freeSlots++;
+  }
+  if((pos < 0) || (ahead >= freeSlots)) slot = -1;     // Not waiting (any more), or the older ones need all free slots
+  else {
+    FMdlSlot &s = FMdlSlots[slot];
+    s.ticket = d->ticket;
+    s.fsNum = d->fsNum;
+    strcpy(s.path, d->path);
+    s.pos = d->start;
+    s.end = d->start + d->length - 1;
+    s.full[0] = s.full[1] = false;
+    s.fill = s.send = 0;
+    s.sendOff = 0;
+    s.state = FMdlOpening;
+    memmove(FMdlQueue + pos, FMdlQueue + pos + 1, (--FMdlWaiting - pos) * sizeof(FMdlWaiter));
+  }
+  portEXIT_CRITICAL(&FMdlMux);
+  if(slot >= 0) xTaskNotifyGive(FMreaderTask);
+  return slot;
+}
+
+// Download finished or client went away: give up the slot, or the place in the queue
+void FMdlDone(FMdlRequest *d){
+  portENTER_CRITICAL(&FMdlMux);
+  if(d->slot >= 0){
+    if(FMdlSlots[d->slot].ticket == d->ticket) FMdlSlots[d->slot].state = FMdlClosing;  // Unless FMreader gave it back already
+  } else if(d->slot == -1){
+    for(int i = 0; i < FMdlWaiting; i++){
+      if(FMdlQueue[i].ticket == d->ticket){
+        memmove(FMdlQueue + i, FMdlQueue + i + 1, (FMdlWaiting - i - 1) * sizeof(FMdlWaiter));
+        FMdlWaiting--;
+        break;
+      }
+    }
+  }
+  d->slot = -2;
+  portEXIT_CRITICAL(&FMdlMux);
+  xTaskNotifyGive(FMreaderTask);
+}
+
+// Closes the file of a slot, releases its buffers and makes it available. Only called by FMreader
+void FMdlRelease(int slot){
+  FMdlSlot &s = FMdlSlots[slot];
+  if(s.file) s.file.close();
+  free(s.buf[0]);
+  free(s.buf[1]);
+  s.buf[0] = s.buf[1] = NULL;
+  portENTER_CRITICAL(&FMdlMux);
+  s.ticket = 0;
+  s.state = FMdlFree;
+  portEXIT_CRITICAL(&FMdlMux);
+}
+
+// Task opening, reading ahead and closing the files of all downloads
+void FMreader(void *parameter){
+  const size_t bufSize = FMdownloadBufKB * 1024;
+  while(true){
+    bool work = false;
+    for(int i = 0; i < FMmaxDownloads; i++){
+      FMdlSlot &s = FMdlSlots[i];
+      int state = s.state;
+      if(state == FMdlOpening){
+        bool ok = false;
+        s.file = fmFS[s.fsNum].fileSys.open(s.path, "r");
+        if(s.file && s.file.seek(s.pos)){
+          for(int b = 0; b < 2; b++){
+            s.buf[b] = (uint8_t *)heap_caps_malloc(bufSize, MALLOC_CAP_SPIRAM);
+            if(s.buf[b] == NULL) s.buf[b] = (uint8_t *)malloc(bufSize);
+          }
+          ok = s.buf[0] && s.buf[1];
+        }
+        if(!ok) FMdlRelease(i);                         // Free for the next download right away
+        else {
+          portENTER_CRITICAL(&FMdlMux);
+          if(s.state == FMdlOpening) s.state = FMdlActive;  // Unless the download was given up meanwhile
+          portEXIT_CRITICAL(&FMdlMux);
+        }
+        work = true;
+      } else if((state == FMdlActive) && !s.full[s.fill] && (s.pos <= s.end)){
+        size_t n = s.file.read(s.buf[s.fill], min(bufSize, s.end - s.pos + 1));
+        if(n == 0){                                     // The response may still be sending the other buffer: it gives up the slot
+          portENTER_CRITICAL(&FMdlMux);
+          if(s.state == FMdlActive) s.state = FMdlFailed;
+          portEXIT_CRITICAL(&FMdlMux);
+        } else {
+          s.len[s.fill] = n;
+          s.pos += n;
+          s.full[s.fill] = true;                        // Only now the response may send it
+          s.fill ^= 1;
+        }
+        work = true;
+      } else if(state == FMdlClosing){
+        FMdlRelease(i);
+        work = true;
+      }
+    }
+    if(!work) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);  // Nothing to do until a response sent a buffer or a download started/ended
+  }
+}
+#endif   // UseFileManager
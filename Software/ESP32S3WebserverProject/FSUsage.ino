@@ -0,0 +1,103 @@
+// File system usage accounting
+// SD.usedBytes() walks the whole allocation table of the card, which takes hundreds of milliseconds on large cards.
+// So capacity and usage are computed once when the file systems are mounted and cached here.
+// File manager uploads, deletes and new directories adjust the cached values as they happen.
+// Because file sizes don't exactly match the space allocated on the file system (clusters, blocks, directory entries),
+// the cached value is reconciled with the real one from loop() once things have been quiet for a while.
+// Anything that needs capacity, used or free bytes reads the cache in O(1) with fsUsageBytes.
+
+typedef struct {bool mounted;           // Only file systems that are in use are accounted for
+                uint64_t total;         // Capacity in bytes. Doesn't change while mounted
+                int64_t used;           // Bytes used, as last reconciled plus adjustments since
+                bool dirty;             // Adjustments were made since the last reconcile
+                unsigned long changed;  // millis() of the last adjustment
+                unsigned long reconciled; // millis() of the last reconcile
+                uint32_t adjustments;   // Number of adjustments so far. Tells if any were made while reconciling
+               } FSUsage;
+FSUsage fsUsage[2] = {{false,0,0,false,0,0,0},{false,0,0,false,0,0,0}};
+portMUX_TYPE fsUsageMux = portMUX_INITIALIZER_UNLOCKED;   // Adjustments come from the async web server task, reads from loop() too
+
+// Computes capacity and usage once. Call after the file systems have been mounted.
+void initFSUsage(){
+#if UseLittleFS
+  fsUsage[FSUsageLittleFS].mounted = true;
+  fsUsage[FSUsageLittleFS].total = LittleFS.totalBytes();
+  fsUsage[FSUsageLittleFS].used = LittleFS.usedBytes();
+  fsUsage[FSUsageLittleFS].reconciled = millis();
+#endif
+#if ((SDType == TypeSD) || (SDType == TypeMMC))
+  fsUsage[FSUsageSD].mounted = true;
+  fsUsage[FSUsageSD].total = SD.totalBytes();
+  fsUsage[FSUsageSD].used = SD.usedBytes();
+  fsUsage[FSUsageSD].reconciled = millis();
+#endif
+}
+
+// Gets the fsUsage index of a file system by name ("SD" or "LittleFS"). -1 if unknown
+int fsUsageNum(const char fsName[]){
+  if(strcmp(fsName,"LittleFS") == 0) return FSUsageLittleFS;
+  if(strcmp(fsName,"SD") == 0) return FSUsageSD;
+  return -1;
+}
+
+// Returns cached bytes for a file system. x: 1 = capacity, 2 = used, 3 = free
+uint64_t fsUsageBytes(int fs, int x){
+  if((fs < 0) || !fsUsage[fs].mounted) return 0;
+  portENTER_CRITICAL(&fsUsageMux);
+  uint64_t total = fsUsage[fs].total;
+  int64_t used = fsUsage[fs].used;
+  portEXIT_CRITICAL(&fsUsageMux);
+  if(used < 0) used = 0;                                  // Adjustments may overshoot until the next reconcile
+  if((uint64_t)used > total) used = total;
+  switch(x){
+    case 1: return total;
+    case 2: return used;
+    case 3: return total - used;
+  }
+  return 0;
+}
+
+// Adjusts the used bytes of a file system by delta (positive when files grow, negative when they are deleted)
+// and schedules a reconcile with the real value.
+void fsUsageAdjust(int fs, int64_t delta){
+  if((fs < 0) || !fsUsage[fs].mounted) return;
+  portENTER_CRITICAL(&fsUsageMux);
+  fsUsage[fs].used += delta;
+  fsUsage[fs].dirty = true;
+  fsUsage[fs].changed = millis();
+  fsUsage[fs].adjustments++;
+  portEXIT_CRITICAL(&fsUsageMux);
+}
+
+// Called from loop(). Reconciles at most one file system per call with its real usage:
+// once it has been quiet (no adjustments) for FSreconcileQuietSec seconds after a change,
+// and in any case every FSreconcileMaxMin minutes. Returns true if it did so.
+// The real usage takes a while to compute. If an adjustment came in meanwhile, the result may or may not include it,
+// so it is dropped: the cache keeps its adjusted value and stays dirty, to be reconciled once quiet again.
+bool fsUsageReconcile(){
+  for(int fs = 0; fs < 2; fs++){
+    if(!fsUsage[fs].mounted) continue;
+    bool due = (fsUsage[fs].dirty && ((millis() - fsUsage[fs].changed) >= (FSreconcileQuietSec * 1000UL)))
+            || ((millis() - fsUsage[fs].reconciled) >= (FSreconcileMaxMin * 60UL * 1000UL));
+    if(!due) continue;
+    portENTER_CRITICAL(&fsUsageMux);
+    uint32_t adjustments = fsUsage[fs].adjustments;
+    portEXIT_CRITICAL(&fsUsageMux);
+    int64_t used = 0;
+#if UseLittleFS
+    if(fs == FSUsageLittleFS) used = LittleFS.usedBytes();
+#endif
+#if ((SDType == TypeSD) || (SDType == TypeMMC))
+    if(fs == FSUsageSD) used = SD.usedBytes();
+#endif
+    portENTER_CRITICAL(&fsUsageMux);
+    if(fsUsage[fs].adjustments == adjustments){
+      fsUsage[fs].used = used;
+      fsUsage[fs].dirty = false;
+    }
+    fsUsage[fs].reconciled = millis();
+    portEXIT_CRITICAL(&fsUsageMux);
+    return true;
+  }
+  return false;
+}
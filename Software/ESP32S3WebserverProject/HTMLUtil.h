@@ -0,0 +1,201 @@
+// HTML escaping of plain UTF-8 text in a single pass, without using the heap (see HTMLUtil.ino)
+#ifndef HTMLUtil_h
+#define HTMLUtil_h
+
+#include <Print.h>                      // Only needs Print. No other ESP32 or webserver dependencies
+
+typedef struct{
+  uint32_t code;                        // Unicode code point
+  const char *entity;                   // What it is replaced with
+}HTMLEntity;
+
+// Characters replaced when text is turned into HTML. MUST be sorted by code point! This is verified at compile time.
+constexpr HTMLEntity htmlEntities[] = {
+  {0x0009, "&#09;"},      // Horizontal Tab
+  {0x000A, "<br>"},       // Line Feed
+  {0x0022, "&quot;"},     // "
+  {0x0026, "&amp;"},      // &
+  {0x007E, "&tilde;"},    // ~
+  {0x00A0, "&nbsp;"},     // Non-Breaking Space
+  {0x00A1, "&iexcl;"},    // ¡
+  {0x00A3, "&#0163;"},    // £
+  {0x00A5, "&#165;"},     // ¥
+  {0x00A6, "&brvbar;"},   // ¦
+  {0x00A7, "&sect;"},     // §
+  {0x00A9, "&copy;"},     // ©
+  {0x00AA, "&ordf;"},     // ª
+  {0x00AB, "&laquo;"},    // «
+  {0x00AC, "&not;"},      // ¬
+  {0x00AD, "&shy;"},      // Soft Hyphen
+  {0x00AE, "&reg;"},      // ®
+  {0x00B0, "&deg;"},      // °
+  {0x00B2, "&sup2;"},     // ²
+  {0x00B3, "&sup3;"},     // ³
+  {0x00B5, "&micro;"},    // µ
+  {0x00B6, "&para;"},     // ¶
+  {0x00B7, "&middot;"},   // ·
+  {0x00B9, "&sup1;"},     // ¹
+  {0x00BA, "&ordm;"},     // º
+  {0x00BB, "&raquo;"},    // »
+  {0x00BF, "&iquest;"},   // ¿
+  {0x00C0, "&Agrave;"},   // À
+  {0x00C1, "&Aacute;"},   // Á
+  {0x00C2, "&Acirc;"},    // Â
+  {0x00C4, "&Auml;"},     // Ä
+  {0x00C7, "&Ccedil;"},   // Ç
+  {0x00C8, "&Egrave;"},   // È
+  {0x00C9, "&Eacute;"},   // É
+  {0x00CA, "&Ecirc;"},    // Ê
+  {0x00CB, "&Euml;"},     // Ë
+  {0x00CF, "&Iuml;"},     // Ï
+  {0x00D1, "&Ntilde;"},   // Ñ
+  {0x00D2, "&Ograve;"},   // Ò
+  {0x00D3, "&Oacute;"},   // Ó
+  {0x00D4, "&Ocirc;"},    // Ô
+  {0x00D6, "&Ouml;"},     // Ö
+  {0x00DC, "&Uuml;"},     // Ü
+  {0x00DF, "&szlig;"},    // ß
+  {0x00E0, "&agrave;"},   // à
+  {0x00E1, "&aacute;"},   // á
+  {0x00E2, "&acirc;"},    // â
+  {0x00E4, "&auml;"},     // ä
+  {0x00E7, "&ccedil;"},   // ç
+  {0x00E8, "&egrave;"},   // è
+  {0x00E9, "&eacute;"},   // é
+  {0x00EA, "&ecirc;"},    // ê
+  {0x00EB, "&euml;"},     // ë
+  {0x00EF, "&iuml;"},     // ï
+  {0x00F1, "&ntilde;"},   // ñ
+  {0x00F2, "&ograve;"},   // ò
+  {0x00F3, "&oacute;"},   // ó
+  {0x00F4, "&ocirc;"},    // ô
+  {0x00F5, "&otilde;"},   // õ
+  {0x00F6, "&ouml;"},     // ö
+  {0x00FC, "&uuml;"},     // ü
+  {0x00FF, "&yuml;"},     // ÿ
+  {0x0178, "&Yuml;"},     // Ÿ
+  {0x2013, "&ndash;"},    // –
+  {0x2014, "&mdash;"},    // —
+  {0x2015, "&#8213;"},    // ―
+  {0x2018, "&lsquo;"},    // ‘
+  {0x2019, "&rsquo;"},    // ’
+  {0x201A, "&sbquo;"},    // ‚
+  {0x201C, "&ldquo;"},    // “
+  {0x201D, "&rdquo;"},    // ”
+  {0x201E, "&dbquo;"},    // „
+  {0x2020, "&dagger;"},   // †
+  {0x2021, "&Dagger;"},   // ‡
+  {0x2022, "&#149;"},     // •
+  {0x2023, "&#8227;"},    // ‣
+  {0x2026, "&#133;"},     // …
+  {0x2039, "&lsaquo;"},   // ‹
+  {0x203A, "&rsaquo;"},   // ›
+  {0x203C, "&#8252;"},    // ‼
+  {0x207F, "&#8319;"},    // ⁿ
+  {0x20AC, "&#8364;"},    // €
+  {0x2105, "&#8453;"},    // ℅
+  {0x2116, "&#8470;"},    // №
+  {0x2122, "&trade;"}     // ™
+};
+constexpr size_t numHTMLEntities = sizeof(htmlEntities) / sizeof(HTMLEntity);
+constexpr bool htmlSorted(const HTMLEntity *e, size_t n){
+  return (n < 2) || ((e[0].code < e[1].code) && htmlSorted(e + 1, n - 1));
+}
+static_assert(htmlSorted(htmlEntities, numHTMLEntities), "htmlEntities must be sorted by code point");
+
+// ASCII characters that are replaced, one bit per character. Anything else below 0x80 is copied without a lookup
+constexpr uint32_t htmlAsciiBits(const HTMLEntity *e, size_t n, uint32_t word){
+  return (n == 0) ? 0 : ((((e->code >> 5) == word) ? (1UL << (e->code & 31)) : 0) | htmlAsciiBits(e + 1, n - 1, word));
+}
+constexpr uint32_t htmlAscii[4] = {htmlAsciiBits(htmlEntities, numHTMLEntities, 0), htmlAsciiBits(htmlEntities, numHTMLEntities, 1),
+                                   htmlAsciiBits(htmlEntities, numHTMLEntities, 2), htmlAsciiBits(htmlEntities, numHTMLEntities, 3)};
+
+// Binary search of htmlEntities. NULL if the character is sent as it is
+inline const char *htmlEntity(uint32_t code){
+  int lo = 0;
+  int hi = numHTMLEntities - 1;
+  while(lo <= hi){
+    int mid = (lo + hi) / 2;
+    if(htmlEntities[mid].code == code) return htmlEntities[mid].entity;
+    if(htmlEntities[mid].code < code) lo = mid + 1;
+    else hi = mid - 1;
+  }
+  return NULL;
+}
+
+// Smallest code point of a UTF-8 sequence of 2, 3 and 4 bytes. Anything below is an overlong (invalid) form
+constexpr uint32_t htmlMinCode[5] = {0, 0, 0x80, 0x800, 0x10000};
+
+// Prints to another Print (a response stream, a CharPrint, ...) replacing characters with their HTML entities.
+// UTF-8 sequences are put together byte by byte, so they may be split across writes. Invalid ones pass unchanged.
+// Call flush() at the end.
+class HTMLEscaper : public Print {
+  public:
+    HTMLEscaper(Print &out) : written(0), _out(out), _len(0), _need(0), _code(0) {}
+    size_t write(uint8_t c) override {
+      if(_need > 0){
+        if((c & 0xC0) == 0x80){                 // Continuation byte
+          _seq[_len++] = c;
+          _code = (_code << 6) | (c & 0x3F);
+          if(--_need == 0) send(_code >= htmlMinCode[_len] ? htmlEntity(_code) : NULL);  // Overlong forms pass unchanged
+          return 1;
+        }
+        flush();                                // Sequence broken off. Send what there is as it is
+      }
+      if(c < 0x80){
+        if(htmlAscii[c >> 5] & (1UL << (c & 31))){
+          const char *entity = htmlEntity(c);
+          written += _out.write((const uint8_t *)entity, strlen(entity));
+        } else {
+          written += _out.write(c);
+        }
+        return 1;
+      }
+      if((c & 0xE0) == 0xC0){ _need = 1; _code = c & 0x1F; }
+      else if((c & 0xF0) == 0xE0){ _need = 2; _code = c & 0x0F; }
+      else if((c & 0xF8) == 0xF0){ _need = 3; _code = c & 0x07; }
+      else {                                    // Not a lead byte
+        written += _out.write(c);
+        return 1;
+      }
+      _seq[0] = c;
+      _len = 1;
+      return 1;
+    }
+    // Sends an incomplete UTF-8 sequence as it is
+    void flush() override {
+      send(NULL);
+    }
+    size_t written;                             // Bytes written to out
+  private:
+    Print &_out;
+    uint8_t _seq[4];                            // UTF-8 sequence collected so far
+    uint8_t _len;
+    uint8_t _need;                              // Continuation bytes still missing
+    uint32_t _code;                             // Code point collected so far
+    void send(const char *entity){
+      if(entity) written += _out.write((const uint8_t *)entity, strlen(entity));
+      else if(_len) written += _out.write(_seq, _len);
+      _len = 0;
+      _need = 0;
+    }
+};
+
+// Prints into a char buffer of size bytes. It is always zero terminated, whatever doesn't fit is dropped
+class CharPrint : public Print {
+  public:
+    CharPrint(char *buf, size_t size) : _buf(buf), _size(size), _len(0) { if(size) buf[0] = 0; }
+    size_t write(uint8_t c) override {
+      if(_len + 1 >= _size) return 0;
+      _buf[_len++] = c;
+      _buf[_len] = 0;
+      return 1;
+    }
+    size_t length(){ return _len; }
+  private:
+    char *_buf;
+    size_t _size;
+    size_t _len;
+};
+
+#endif
@@ -0,0 +1,38 @@
+// Log: entries recorded as a format ID plus raw arguments, formatted later (see Log.ino)
+// logEvent(id, ...) only copies the arguments into a lock-free ring. It may be called from any task, but not from an ISR
+// (it runs from flash and calls millis() and string functions).
+// loop() turns the entries into text for Serial and sends them to SerialWS as binary frames, which SerialWS.htm formats.
+#ifndef Log_h
+#define Log_h
+
+// Levels. An entry is only recorded if its level is at most logLevel
+enum {LogError, LogWarn, LogInfo, LogDebug};
+
+// Format IDs. Levels and format strings are in logFormats (Log.ino), in the same order!
+// Formats may only use %s (copied, cut short if the entry gets too long) and %d, %i, %u, %x (32 bit) with flags and width.
+enum {LogDropped,                       // Entries lost because the ring was full
+      LogBootPhase,                     // Boot timeline (see Boot.ino)
+      LogNotFound,                      // Request nobody handles (404)
+      LogNotFoundContent,               // and its content type and length,
+      LogNotFoundHeader,                // headers,
+      LogNotFoundFile,                  // file,
+      LogNotFoundPost,                  // post
+      LogNotFoundGet,                   // and query parameters
+      LogNotFoundSuppressed,            // 404s not logged because of LogNotFoundPerSec
+      LogFormatCount};
+
+#define LogSlotBytes 128                // Size of one entry in the ring, header included
+
+// One entry. seq tells producers and loop() whose turn it is (see logEvent and logHandle)
+typedef struct {volatile uint32_t seq;
+                uint16_t id;                      // Format ID
+                uint16_t len;                     // Bytes of args used
+                uint32_t ms;                      // millis() when it was recorded
+                uint8_t args[LogSlotBytes - 12];  // Integers as 4 bytes, strings as length byte and characters. Little endian
+               } LogSlot;
+
+// Binary SerialWS frames: the byte 'L', then any number of entries of
+//   id (2 bytes), ms (4 bytes), len (2 bytes), len bytes of args
+// all little endian, with args as in LogSlot. The browser gets the format strings from /log.
+
+#endif
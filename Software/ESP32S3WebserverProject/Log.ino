@@ -0,0 +1,251 @@
+// Log
+// Formatting text is expensive, and most log entries are never read. So logEvent doesn't format anything: it copies the
+// format ID, millis() and the raw arguments into a slot of a ring (LogSlots entries of LogSlotBytes) and returns.
+// The ring is lock-free (a bounded queue where each slot carries a sequence number), so logEvent can be used from
+// the async TCP task and other tasks alike without waiting. If the ring is full, the entry is dropped and counted.
+// Not from ISRs: logEvent isn't in IRAM and calls functions in flash.
+// loop() takes the entries out (logHandle), formats them for Serial and sends them to SerialWS as binary frames,
+// which SerialWS.htm formats in the browser with the format strings it gets from /log.
+// Only entries up to logLevel are recorded. It starts at LogLevel (customize.h) and can be changed with /log?level=n.
+
+typedef struct {int level;                      // LogError, LogWarn, LogInfo or LogDebug
+                const char *format;             // printf style, see Log.h for what may be used
+               } LogFormat;
+
+// Level and format of each ID, in the order of the enum in Log.h
+const LogFormat logFormats[LogFormatCount] = {
+  {LogWarn,  "%u log entries dropped, the log was full"},
+  {LogInfo,  "Boot: %s after %ums"},
+  {LogInfo,  "NOT_FOUND: %s http://%s%s"},
+  {LogDebug, "_CONTENT_TYPE: %s\n_CONTENT_LENGTH: %u"},
+  {LogDebug, "_HEADER[%s]: %s"},
+  {LogDebug, "_FILE[%s]: %s, size: %u"},
+  {LogDebug, "_POST[%s]: %s"},
+  {LogDebug, "_GET[%s]: %s"},
+  {LogWarn,  "%u NOT_FOUND requests not logged (more than %u per second)"}};
+
+static_assert((LogSlots & (LogSlots - 1)) == 0, "LogSlots must be a power of 2");
+
+volatile int logLevel = LogLevel;
+LogSlot logRing[LogSlots];
+volatile uint32_t logHead = 0;                  // Next position a producer claims
+uint32_t logTail = 0;                           // Next position loop() takes out. Only changed by logHandle
+volatile uint32_t logDropped = 0;               // Entries dropped since logHandle last reported them
+
+// Prepares the ring. Call first thing in setup(), before anything is logged
+void initLog(){
+  for(uint32_t i = 0; i < LogSlots; i++) logRing[i].seq = i;   // Slot i is free for position i
+}
+
+bool logEnabled(int level){
+  return level <= logLevel;
+}
+
+// Records an entry. The arguments must match the format of id (see logFormats)
+void logEvent(int id, ...){
+  if(logFormats[id].level > logLevel) return;
+  uint32_t pos = __atomic_load_n(&logHead, __ATOMIC_RELAXED);
+  LogSlot *s;
+  while(true){
+    s = &logRing[pos & (LogSlots - 1)];
+    int32_t dif = (int32_t)(__atomic_load_n(&s->seq, __ATOMIC_ACQUIRE) - pos);
+    if(dif == 0){                               // Free. Claim it, unless another producer was quicker
+      if(__atomic_compare_exchange_n(&logHead, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    } else if(dif < 0){                         // Still holds an entry loop() hasn't taken out: the ring is full
+      __atomic_fetch_add(&logDropped, 1, __ATOMIC_RELAXED);
+      return;
+    } else {
+      pos = __atomic_load_n(&logHead, __ATOMIC_RELAXED);
+    }
+  }
+  s->id = id;
+  s->ms = millis();
+  va_list ap;
+  va_start(ap, id);
+  s->len = logPack(logFormats[id].format, s->args, sizeof(s->args), ap);
+  va_end(ap);
+  __atomic_store_n(&s->seq, pos + 1, __ATOMIC_RELEASE);  // Now loop() may take it out
+}
+
+// Gets the conversion character of the next format specification, skipping %%. NULL if there is none
+const char *logNextSpec(const char *f){
+  while((f = strchr(f, '%')) != NULL){
+    f++;
+    if(*f == '%'){
+      f++;
+      continue;
+    }
+    while(*f && strchr("-+ #0123456789.", *f)) f++;       // Flags, width and precision
+    return *f ? f : NULL;
+  }
+  return NULL;
+}
+
+// Copies the arguments of a format into args. Strings are cut short so everything that follows still fits:
+// each gets at most an equal share of the room left for the strings still to come
+size_t logPack(const char *format, uint8_t *args, size_t size, va_list ap){
+  int ints = 0;
+  int strs = 0;
+  for(const char *f = format; (f = logNextSpec(f)) != NULL; f++)
+    if(*f == 's') strs++; else ints++;
+  size_t n = 0;
+  for(const char *f = format; (f = logNextSpec(f)) != NULL; f++){
+    if(*f == 's'){
+      strs--;
+      const char *str = va_arg(ap, const char *);
+      if(str == NULL) str = "";
+      int room = ((int)size - (int)n - 1 - strs - 4 * ints) / (strs + 1);
+      size_t len = strnlen(str, 255);
+      if((int)len > room) len = (room > 0) ? room : 0;
+      args[n++] = len;
+      memcpy(args + n, str, len);
+      n += len;
+    } else {
+      ints--;
+      uint32_t v = va_arg(ap, int);
+      memcpy(args + n, &v, 4);
+      n += 4;
+    }
+  }
+  return n;
+}
+
+// Writes an entry as text, followed by a new line
+void logFormat(Print &out, int id, const uint8_t *args, size_t len){
+  const char *f = logFormats[id].format;
+  size_t n = 0;
+  while(*f){
+    const char *pct = strchr(f, '%');
+    if(pct == NULL){
+      out.print(f);
+      break;
+    }
+    out.write((const uint8_t *)f, pct - f);
+    if(pct[1] == '%'){
+      out.write('%');
+      f = pct + 2;
+      continue;
+    }
+    const char *c = logNextSpec(pct);
+    if(c == NULL) break;
+    if(*c == 's'){
+      if(n < len){
+        size_t l = min((size_t)args[n], len - n - 1);
+        out.write(args + n + 1, l);
+        n += 1 + l;
+      }
+    } else if(n + 4 <= len){
+      char spec[12];
+      size_t l = c - pct + 1;
+      uint32_t v;
+      memcpy(&v, args + n, 4);
+      n += 4;
+      if(l < sizeof(spec)){
+        memcpy(spec, pct, l);
+        spec[l] = 0;
+        out.printf(spec, v);
+      }
+    }
+    f = c + 1;
+  }
+  out.write('\n');
+}
+
+// Takes the recorded entries out of the ring: as text to Serial, as binary frames to SerialWS. Call from loop()
+void logHandle(){
+  uint32_t dropped = __atomic_exchange_n(&logDropped, 0, __ATOMIC_RELAXED);
+  if(dropped) logEvent(LogDropped, dropped);
+#if useSerialWS
+  static uint8_t frame[1024];                   // Entries are sent together, up to this many bytes per frame
+  size_t n = 0;
+#endif
+  for(int i = 0; i < LogSlots; i++){            // At most one ring full, so loop() isn't held up for long
+    LogSlot &s = logRing[logTail & (LogSlots - 1)];
+    if(__atomic_load_n(&s.seq, __ATOMIC_ACQUIRE) != logTail + 1) break;   // Empty, or still being written
+#if serialEnabled
+    logFormat(Serial, s.id, s.args, s.len);
+#endif
+#if useSerialWS
+    if(n + 8 + s.len > sizeof(frame)){
+      serialWS.binary(frame, n);
+      n = 0;
+    }
+    if(n == 0) frame[n++] = 'L';
+    memcpy(frame + n, &s.id, 2);
+    memcpy(frame + n + 2, &s.ms, 4);
+    memcpy(frame + n + 6, &s.len, 2);
+    memcpy(frame + n + 8, s.args, s.len);
+    n += 8 + s.len;
+#endif
+    __atomic_store_n(&s.seq, logTail + LogSlots, __ATOMIC_RELEASE);  // Free for the producer of the next round
+    logTail++;
+  }
+#if useSerialWS
+  if(n) serialWS.binary(frame, n);
+#endif
+}
+
+// Name of an HTTP method, for the log
+const char *logMethod(int method){
+  switch(method){
+    case HTTP_GET:     return "GET";
+    case HTTP_POST:    return "POST";
+    case HTTP_DELETE:  return "DELETE";
+    case HTTP_PUT:     return "PUT";
+    case HTTP_PATCH:   return "PATCH";
+    case HTTP_HEAD:    return "HEAD";
+    case HTTP_OPTIONS: return "OPTIONS";
+  }
+  return "UNKNOWN";
+}
+
+// Tells if a 404 may be logged: at most LogNotFoundPerSec per second, so scanners don't flood the log.
+// How many were left out is logged with the next one that is. Only called by the async TCP task (onNotFound)
+bool logNotFoundAllowed(){
+#if LogNotFoundPerSec > 0
+  static unsigned long second = 0;
+  static uint32_t count = 0;
+  static uint32_t suppressed = 0;
+  if(millis() - second >= 1000){
+    second = millis();
+    count = 0;
+  }
+  if(count >= LogNotFoundPerSec){
+    suppressed++;
+    return false;
+  }
+  count++;
+  if(suppressed){
+    logEvent(LogNotFoundSuppressed, suppressed, LogNotFoundPerSec);
+    suppressed = 0;
+  }
+#endif
+  return true;
+}
+
+// /log gets the level and the format strings (for SerialWS.htm). /log?level=n changes the level (admin only, see adminAllowed)
+void setupLog(){
+  server.on("/log", HTTP_GET, [](AsyncWebServerRequest *request){
+    metricsScope(MetricLog);
+    if(request->hasParam("level")){
+      if(!adminAllowed(request)) return;           // Answered with 403 or a login request
+      long level = request->getParam("level")->value().toInt();
+      if((level >= LogError) && (level <= LogDebug)) logLevel = level;
+    }
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->printf("{\"level\":%d,\"formats\":[", logLevel);
+    for(int i = 0; i < LogFormatCount; i++){
+      response->printf("%s[%d,\"", i ? "," : "", logFormats[i].level);
+      for(const char *c = logFormats[i].format; *c; c++){
+        if(*c == '\n') response->print("\\n");
+        else {
+          if((*c == '"') || (*c == '\\')) response->write('\\');
+          response->write(*c);
+        }
+      }
+      response->print("\"]");
+    }
+    response->print("]}");
+    request->send(response);
+  });
+}
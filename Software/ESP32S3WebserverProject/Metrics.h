@@ -0,0 +1,59 @@
+// Metrics: timing of routes, websocket events and loop() branches (see Metrics.ino)
+// Put metricsScope(id) at the top of a block to time it, metricsBytes(n) to add the bytes it handled.
+// The ids below are fixed. Websocket requests and custom code get theirs from metricsRegister.
+// With UseMetrics false in customize.h these compile to nothing at all.
+#ifndef Metrics_h
+#define Metrics_h
+
+// What is measured. Names and kinds are in metricInfo (Metrics.ino), in the same order!
+enum {MetricAssets,                     // Core webpages (EmbeddedAssetHandler)
+      MetricStatic,                     // Static files (StaticFileHandler)
+      MetricStatus,                     // /status
+      MetricMetrics,                    // /metrics
+      MetricDownload,                   // /download
+      MetricUpload,                     // /upload, every chunk received
+      MetricNotFound,                   // Requests nobody handles
+      MetricLog,                        // /log
+      MetricWS,                         // onWsEvent
+      MetricLoopClients,                // loop(): websocket client cleanup
+      MetricLoopSerialWS,               // loop(): SerialWS client cleanup
+      MetricLoopTime,                   // loop(): currentTime update
+      MetricLoopTelegram,               // loop(): Telegram poll
+      MetricLoopCustom,                 // loop(): customLoop
+      MetricLoopReconcile,              // loop(): file system usage reconcile
+      MetricLoopNTP,                    // loop(): NTP synchronization check
+      MetricLoopSafety,                 // loop(): safety net check
+      MetricCount};
+
+#define MetricBuckets 20                // Histogram buckets: up to 16us, 32us, ... 2^23us (8.4s). One more for anything longer
+
+typedef struct {uint32_t count;                   // Number of times measured
+                uint64_t us;                      // Total microseconds
+                uint32_t maxUs;                   // Longest one
+                uint64_t bytes;                   // Total bytes handled
+                uint32_t buckets[MetricBuckets + 1];  // Durations up to 16us, 32us, ... and longer
+               } MetricHist;
+
+#if UseMetrics
+void metricsRecord(int id, int64_t start, size_t bytes);
+int metricsRegister(const char *name, const char *kind);
+
+// Times the enclosing block. Records when it goes out of scope, whichever way the block is left
+class MetricsTimer {
+  public:
+    MetricsTimer(int id) : bytes(0), _id(id), _start(esp_timer_get_time()) {}
+    ~MetricsTimer(){ metricsRecord(_id, _start, bytes); }
+    size_t bytes;
+  private:
+    int _id;
+    int64_t _start;
+};
+  #define metricsScope(id)  MetricsTimer _metricsTimer(id)
+  #define metricsBytes(n)   _metricsTimer.bytes += (n)
+#else
+  #define metricsScope(id)
+  #define metricsBytes(n)
+  #define metricsRegister(name, kind) (-1)
+#endif
+
+#endif
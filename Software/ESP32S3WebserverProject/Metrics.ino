@@ -0,0 +1,165 @@
+// Metrics
+// Routes, websocket events and the branches of loop() are timed with esp_timer, in microseconds (see metricsScope in Metrics.h).
+// Each gets a log scale histogram of its duration, plus count, total time, longest time and bytes handled.
+// Every websocket request has its own (see wsSetupMetrics), and custom code can add more with metricsRegister.
+// The heap is sampled once a second for the lowest largest free block. (The lowest free heap is tracked by the allocator.)
+// Everything is available at /metrics in Prometheus text format, and as websocket request getMetrics (JSON).
+// With UseMetrics false in customize.h none of this is compiled.
+
+#if UseMetrics
+
+MetricHist metrics[MetricCount + MetricsRegistered];
+int metricsNum = MetricCount;                     // Metrics in use: the fixed ones, then those registered
+portMUX_TYPE metricsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Name and kind of each metric, in the order of the enum in Metrics.h. Registered ones follow
+const char *metricInfo[MetricCount + MetricsRegistered][2] = {
+  {"assets", "route"}, {"static", "route"}, {"/status", "route"}, {"/metrics", "route"},
+  {"/download", "route"}, {"/upload", "route"}, {"notFound", "route"}, {"/log", "route"}, {"ws", "websocket"},
+  {"clients", "loop"}, {"serialWSclients", "loop"}, {"time", "loop"}, {"telegram", "loop"},
+  {"custom", "loop"}, {"reconcile", "loop"}, {"ntp", "loop"}, {"safetyNet", "loop"}};
+
+uint32_t metricsMinMaxAlloc = UINT32_MAX;         // Lowest largest free heap block seen
+uint32_t metricsMinMaxAllocPsram = UINT32_MAX;    // Lowest largest free PSRAM block seen
+
+// Records one measurement. Called by MetricsTimer
+// esp_timer is the same on both cores, so a task moved to the other core meanwhile is timed right, however long it took
+void metricsRecord(int id, int64_t start, size_t bytes){
+  if((id < 0) || (id >= metricsNum)) return;                          // Registering failed (-1)
+  int64_t elapsed = esp_timer_get_time() - start;
+  uint32_t us = (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed;   // Over 71 minutes: counts as 71 minutes
+  int b = (us <= 16) ? 0 : (32 - __builtin_clz(us - 1)) - 4;
+  if(b > MetricBuckets) b = MetricBuckets;
+  portENTER_CRITICAL(&metricsMux);
+  MetricHist &m = metrics[id];
+  m.count++;
+  m.us += us;
+  if(us > m.maxUs) m.maxUs = us;
+  m.bytes += bytes;
+  m.buckets[b]++;
+  portEXIT_CRITICAL(&metricsMux);
+}
+
+// Adds a metric, for instance for a route set up in customPages():
+//   static int sensorMetric = metricsRegister("/sensor", "route");
+//   server.on("/sensor", HTTP_GET, [](AsyncWebServerRequest *request){ metricsScope(sensorMetric); ... });
+// name and kind are kept as they are, so pass string literals. Registering the same name and kind again returns
+// the same id. Returns -1 once MetricsRegistered are taken; metricsScope(-1) measures nothing.
+int metricsRegister(const char *name, const char *kind){
+  int id = -1;
+  portENTER_CRITICAL(&metricsMux);
+  for(int i = MetricCount; (i < metricsNum) && (id < 0); i++)
+    if((strcmp(metricInfo[i][0], name) == 0) && (strcmp(metricInfo[i][1], kind) == 0)) id = i;
+  if((id < 0) && (metricsNum < MetricCount + MetricsRegistered)){
+    id = metricsNum;
+    metricInfo[id][0] = name;
+    metricInfo[id][1] = kind;
+    metricsNum++;                                 // Only now metricsRecord takes it
+  }
+  portEXIT_CRITICAL(&metricsMux);
+  return id;
+}
+
+// Samples the largest free blocks. Call from loop(), it only does so once a second
+void metricsSample(){
+  static unsigned long lastSample = 0;
+  if(millis() - lastSample < 1000) return;
+  lastSample = millis();
+  uint32_t x = ESP.getMaxAllocHeap();
+  if(x < metricsMinMaxAlloc) metricsMinMaxAlloc = x;
+  if(psramFound()){
+    x = ESP.getMaxAllocPsram();
+    if(x < metricsMinMaxAllocPsram) metricsMinMaxAllocPsram = x;
+  }
+}
+
+// Gets a consistent copy of a metric
+void metricsGet(int id, MetricHist &m){
+  portENTER_CRITICAL(&metricsMux);
+  m = metrics[id];
+  portEXIT_CRITICAL(&metricsMux);
+}
+
+void setupMetrics(){
+  wsSetupMetrics();                               // One per websocket request
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+    metricsScope(MetricMetrics);
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+    sendMetrics(response);
+    request->send(response);
+  });
+}
+
+// Writes all metrics in Prometheus text format
+void sendMetrics(Print *out){
+  out->printf("# HELP webserver_duration_seconds Time spent in routes, websocket events and loop() branches\n");
+  out->printf("# TYPE webserver_duration_seconds histogram\n");
+  for(int i = 0; i < metricsNum; i++){
+    MetricHist m;
+    metricsGet(i, m);
+    if(m.count == 0) continue;                    // Never happened (yet). Keeps the output short
+    uint32_t cumulative = 0;
+    for(int b = 0; b < MetricBuckets; b++){
+      cumulative += m.buckets[b];
+      out->printf("webserver_duration_seconds_bucket{kind=\"%s\",name=\"%s\",le=\"%g\"} %u\n",
+        metricInfo[i][1], metricInfo[i][0], (1UL << (b + 4)) / 1e6, cumulative);
+    }
+    out->printf("webserver_duration_seconds_bucket{kind=\"%s\",name=\"%s\",le=\"+Inf\"} %u\n", metricInfo[i][1], metricInfo[i][0], m.count);
+    out->printf("webserver_duration_seconds_sum{kind=\"%s\",name=\"%s\"} %.6f\n", metricInfo[i][1], metricInfo[i][0], m.us / 1e6);
+    out->printf("webserver_duration_seconds_count{kind=\"%s\",name=\"%s\"} %u\n", metricInfo[i][1], metricInfo[i][0], m.count);
+  }
+  out->printf("# HELP webserver_duration_max_seconds Longest time spent\n# TYPE webserver_duration_max_seconds gauge\n");
+  for(int i = 0; i < metricsNum; i++){
+    MetricHist m;
+    metricsGet(i, m);
+    if(m.count) out->printf("webserver_duration_max_seconds{kind=\"%s\",name=\"%s\"} %.6f\n", metricInfo[i][1], metricInfo[i][0], m.maxUs / 1e6);
+  }
+  out->printf("# HELP webserver_bytes_total Bytes handled (request and response bodies, websocket messages)\n# TYPE webserver_bytes_total counter\n");
+  for(int i = 0; i < metricsNum; i++){
+    MetricHist m;
+    metricsGet(i, m);
+    if(m.count) out->printf("webserver_bytes_total{kind=\"%s\",name=\"%s\"} %llu\n", metricInfo[i][1], metricInfo[i][0], m.bytes);
+  }
+  out->printf("# TYPE webserver_heap_free_bytes gauge\nwebserver_heap_free_bytes %u\n", ESP.getFreeHeap());
+  out->printf("# TYPE webserver_heap_min_free_bytes gauge\nwebserver_heap_min_free_bytes %u\n", ESP.getMinFreeHeap());
+  out->printf("# TYPE webserver_heap_max_alloc_bytes gauge\nwebserver_heap_max_alloc_bytes %u\n", ESP.getMaxAllocHeap());
+  if(metricsMinMaxAlloc != UINT32_MAX)
+    out->printf("# TYPE webserver_heap_min_max_alloc_bytes gauge\nwebserver_heap_min_max_alloc_bytes %u\n", metricsMinMaxAlloc);
+  if(psramFound()){
+    out->printf("# TYPE webserver_psram_free_bytes gauge\nwebserver_psram_free_bytes %u\n", ESP.getFreePsram());
+    out->printf("# TYPE webserver_psram_min_free_bytes gauge\nwebserver_psram_min_free_bytes %u\n", ESP.getMinFreePsram());
+    if(metricsMinMaxAllocPsram != UINT32_MAX)
+      out->printf("# TYPE webserver_psram_min_max_alloc_bytes gauge\nwebserver_psram_min_max_alloc_bytes %u\n", metricsMinMaxAllocPsram);
+  }
+  out->printf("# TYPE webserver_uptime_seconds counter\nwebserver_uptime_seconds %llu\n", (esp_timer_get_time() - lastReboot) / 1000000);
+}
+
+// Websocket request getMetrics: the same as /metrics, as JSON. Times are in microseconds
+void wsGetMetrics(AsyncWebSocketClient *client, WSRequest &req){
+  const size_t size = 600 + metricsNum * (160 + MetricBuckets * 11);
+  char *rsvp = (char *)malloc(size);
+  if(rsvp == NULL) return;
+  size_t n = snprintf(rsvp, size,
+    "{\"answer\":\"setMetrics\",\"uptime\":%llu,\"heap\":{\"free\":%u,\"minFree\":%u,\"maxAlloc\":%u,\"minMaxAlloc\":%u},"
+    "\"psram\":{\"free\":%u,\"minFree\":%u,\"minMaxAlloc\":%u},\"bucketsUs\":[",
+    (esp_timer_get_time() - lastReboot) / 1000000, ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap(),
+    metricsMinMaxAlloc == UINT32_MAX ? 0 : metricsMinMaxAlloc,
+    ESP.getFreePsram(), ESP.getMinFreePsram(), metricsMinMaxAllocPsram == UINT32_MAX ? 0 : metricsMinMaxAllocPsram);
+  for(int b = 0; (b < MetricBuckets) && (n < size); b++)
+    n += snprintf(rsvp + n, size - n, "%s%lu", b ? "," : "", 1UL << (b + 4));
+  if(n < size) n += snprintf(rsvp + n, size - n, "],\"metrics\":[");
+  for(int i = 0; (i < metricsNum) && (n < size); i++){
+    MetricHist m;
+    metricsGet(i, m);
+    n += snprintf(rsvp + n, size - n, "%s{\"name\":\"%s\",\"kind\":\"%s\",\"count\":%u,\"sumUs\":%llu,\"maxUs\":%u,\"bytes\":%llu,\"buckets\":[",
+      i ? "," : "", metricInfo[i][0], metricInfo[i][1], m.count, m.us, m.maxUs, m.bytes);
+    for(int b = 0; (b <= MetricBuckets) && (n < size); b++)
+      n += snprintf(rsvp + n, size - n, "%s%u", b ? "," : "", m.buckets[b]);
+    if(n < size) n += snprintf(rsvp + n, size - n, "]}");
+  }
+  if(n < size) snprintf(rsvp + n, size - n, "]}");
+  client->text(rsvp);
+  free(rsvp);
+}
+
+#endif
@@ -0,0 +1,290 @@
+// Static files
+// Files on LittleFS and SD are served by StaticFileHandler (replacing server.serveStatic), which
+// - picks the precompressed sibling the browser accepts (Accept-Encoding): file.br, file.gz or the file itself
+// - sends a strong ETag (size, modification time and encoding of the file sent) and Last-Modified
+// - answers If-None-Match/If-Modified-Since with 304 without opening the file
+// - sends the file from the PSRAM cache if possible (see AssetCache)
+// Whether a file and its siblings exist, their sizes and modification times are kept in staticMeta, so a revalidation
+// doesn't touch the file system at all. Code that changes files should call staticFileChanged(fs, path) (file manager does).
+// Anything else is noticed within StaticMetaSec. Missing paths are kept for a short time in staticMiss, which is small, so
+// requests for files that don't exist (scanners) can't push the real files out of staticMeta.
+// The file manager can create .gz siblings when uploading (see fileman.htm).
+
+typedef struct {int fs;                                     // File system (FSUsageLittleFS or FSUsageSD)
+                char path[StaticPathLen];                   // Path within the file system. Empty if the slot is free
+                StaticInfo info;                            // Which variants exist, their sizes and modification times
+                uint32_t used;                              // Tick of the last use, for LRU replacement
+                uint32_t checked;                           // millis() when info was read from the file system
+               } StaticMeta;
+StaticMeta staticMeta[StaticMetaFiles];
+uint32_t staticTick = 0;
+typedef struct {int fs;                                     // File system
+                char path[StaticPathLen];                   // Path that doesn't exist (or is a directory). Empty if the slot is free
+                bool dir;                                   // It is a directory
+                uint32_t checked;                           // millis() when it was found missing
+               } StaticMiss;
+StaticMiss staticMiss[StaticMissFiles];
+int staticMissNext = 0;                                     // Slot the next miss goes into, round robin
+uint32_t static304 = 0;                                     // Requests answered with 304 Not Modified
+portMUX_TYPE staticMux = portMUX_INITIALIZER_UNLOCKED;
+
+class StaticFileHandler : public AsyncWebHandler {
+  public:
+    StaticFileHandler(const char *uri, int fs, const char *defaultFile) : _fs(fs), _defaultFile(defaultFile) {
+      strlcpy(_uri, uri, sizeof(_uri));
+      _uriLen = strlen(_uri);
+      if((_uriLen > 0) && (_uri[_uriLen - 1] == '/')) _uriLen--;  // "/s/" matches "/s/file.htm" which is "/file.htm" on SD
+    }
+    virtual bool canHandle(AsyncWebServerRequest *request) override {
+      char path[256];
+      StaticInfo m;
+      if(request->method() != HTTP_GET) return false;
+      if(!bootStorageReady()) return underUri(request);     // Not mounted yet. Claimed to answer 503 instead of 404
+      if(!getPath(request, path, m)) return false;
+      request->addInterestingHeader("Accept-Encoding");     // Other headers are dropped once the handler is chosen
+      request->addInterestingHeader("If-None-Match");
+      request->addInterestingHeader("If-Modified-Since");
+      return true;
+    }
+    virtual void handleRequest(AsyncWebServerRequest *request) override {
+      metricsScope(MetricStatic);
+      char path[256];
+      StaticInfo m;
+      if(!storageAvailable(request)) return;
+      if(getPath(request, path, m)) metricsBytes(sendStaticFile(request, _fs, path));
+      else request->send(404);                              // Deleted since canHandle
+    }
+  private:
+    char _uri[8];
+    size_t _uriLen;
+    int _fs;
+    const char *_defaultFile;
+    // Is the URL below uri?
+    bool underUri(AsyncWebServerRequest *request){
+      const char *url = request->url().c_str();
+      return (strncmp(url, _uri, _uriLen) == 0) && (url[_uriLen] == '/');
+    }
+    // Gets the path within the file system. Like serveStatic, a directory is served by its default file
+    bool getPath(AsyncWebServerRequest *request, char path[], StaticInfo &m){
+      if(!underUri(request)) return false;
+      const char *url = request->url().c_str();
+      url += _uriLen;
+      size_t len = strlen(url);
+      if(len >= 256) return false;
+      strcpy(path, url);
+      if(path[len - 1] != '/'){
+        if(staticLookup(_fs, path, m)) return true;
+        if((_defaultFile == NULL) || !m.dir) return false;  // Only a directory has a default file
+        strcat(path, "/");                                  // Maybe a directory, try its default file
+      }
+      if((_defaultFile == NULL) || (strlen(path) + strlen(_defaultFile) >= 256)) return false;
+      strcat(path, _defaultFile + 1);                       // DefaultHTM starts with a slash
+      return staticLookup(_fs, path, m);
+    }
+};
+
+// Serves files below uri from file system fs. defaultFile (or NULL) is served for directories.
+// Replaces server.serveStatic(uri, fs, "/").setDefaultFile(defaultFile).setCacheControl(cacheRule)
+void addStaticFiles(const char *uri, int fs, const char *defaultFile){
+  server.addHandler(new StaticFileHandler(uri, fs, defaultFile));
+}
+
+// Gets the file system by its index
+FS *staticFS(int fs){
+#if UseLittleFS
+  if(fs == FSUsageLittleFS) return &LittleFS;
+#endif
+#if ((SDType == TypeSD) || (SDType == TypeMMC))
+  if(fs == FSUsageSD) return &SD;
+#endif
+  return NULL;
+}
+
+// Gets where a file system is mounted in the ESP32 virtual file system (see initSDCard and initLittleFS)
+const char *staticMount(int fs){
+  if(fs == FSUsageLittleFS) return "/littlefs";
+#if (SDType == TypeMMC)
+  return "/sdcard";
+#else
+  return "/sd";
+#endif
+}
+
+// Gets existence, size and modification time of a file and its .gz and .br siblings, from staticMeta (or staticMiss)
+// if known and checked recently. Returns true if any of them exist. Paths of StaticPathLen or longer are never kept.
+bool staticLookup(int fs, const char *path, StaticInfo &m){
+  bool keep = (strlen(path) < StaticPathLen);
+  uint32_t now = millis();
+  portENTER_CRITICAL(&staticMux);
+  for(int i = 0; keep && (i < StaticMissFiles); i++){
+    StaticMiss &x = staticMiss[i];
+    if((x.path[0] != 0) && (x.fs == fs) && (now - x.checked < StaticMissSec * 1000UL) && (strcmp(x.path, path) == 0)){
+      memset(&m, 0, sizeof(m));
+      m.dir = x.dir;
+      portEXIT_CRITICAL(&staticMux);
+      return false;
+    }
+  }
+  for(int i = 0; keep && (i < StaticMetaFiles); i++){
+    if((staticMeta[i].path[0] != 0) && (staticMeta[i].fs == fs) && (strcmp(staticMeta[i].path, path) == 0)){
+      if(now - staticMeta[i].checked >= StaticMetaSec * 1000UL) break;   // Time to look again
+      staticMeta[i].used = ++staticTick;
+      m = staticMeta[i].info;
+      portEXIT_CRITICAL(&staticMux);
+      return true;                                          // Only files that exist are kept in staticMeta
+    }
+  }
+  portEXIT_CRITICAL(&staticMux);
+  const char *suffix[3] = {"", ".gz", ".br"};
+  memset(&m, 0, sizeof(m));
+  for(int v = StaticPlain; v <= StaticBr; v++){             // stat() doesn't open the file
+    char full[300];
+    struct stat st;
+    snprintf(full, sizeof(full), "%s%s%s", staticMount(fs), path, suffix[v]);
+    if(stat(full, &st) != 0) continue;
+    if(S_ISDIR(st.st_mode)){
+      if(v == StaticPlain) m.dir = true;
+      continue;
+    }
+    m.exists[v] = true;
+    m.size[v] = st.st_size;
+    m.mtime[v] = st.st_mtime;
+  }
+  bool found = m.exists[StaticPlain] || m.exists[StaticGz] || m.exists[StaticBr];
+  if(!keep) return found;
+  bool changed = false;                                     // Was known, but differs now
+  portENTER_CRITICAL(&staticMux);
+  int victim = 0;
+  int slot = -1;
+  for(int i = 0; (i < StaticMetaFiles) && (slot < 0); i++){ // Look again, the table may have changed meanwhile
+    if((staticMeta[i].path[0] != 0) && (staticMeta[i].fs == fs) && (strcmp(staticMeta[i].path, path) == 0)) slot = i;
+    else if(staticMeta[i].used < staticMeta[victim].used) victim = i;  // Free slots have used = 0
+  }
+  if(slot >= 0){
+    changed = (memcmp(&staticMeta[slot].info, &m, sizeof(m)) != 0);
+    if(!found) memset(&staticMeta[slot], 0, sizeof(StaticMeta));
+  } else if(found){
+    slot = victim;
+  }
+  if(found){
+    staticMeta[slot].fs = fs;
+    strcpy(staticMeta[slot].path, path);
+    staticMeta[slot].info = m;
+    staticMeta[slot].used = ++staticTick;
+    staticMeta[slot].checked = now;
+  } else {
+    StaticMiss &x = staticMiss[staticMissNext];
+    staticMissNext = (staticMissNext + 1) % StaticMissFiles;
+    x.fs = fs;
+    strcpy(x.path, path);
+    x.dir = m.dir;
+    x.checked = now;
+  }
+  portEXIT_CRITICAL(&staticMux);
+  if(changed) staticDropAssets(fs, path);                   // Changed by someone who didn't tell: the cached copy is old
+  return found;
+}
+
+// Forgets what is known about a file (any of its variants) or everything below a directory, in staticMeta and the PSRAM cache.
+void staticFileChanged(int fs, const char *path){
+  if(fs < 0) return;
+  char base[300];
+  strlcpy(base, path, sizeof(base));
+  size_t len = strlen(base);
+  if((len > 3) && ((strcmp(base + len - 3, ".gz") == 0) || (strcmp(base + len - 3, ".br") == 0))) base[len -= 3] = 0;
+  portENTER_CRITICAL(&staticMux);
+  for(int i = 0; i < StaticMetaFiles; i++){
+    if((staticMeta[i].path[0] == 0) || (staticMeta[i].fs != fs)) continue;
+    if((strcmp(staticMeta[i].path, base) == 0) ||
+       ((strncmp(staticMeta[i].path, base, len) == 0) && (staticMeta[i].path[len] == '/')))
+      memset(&staticMeta[i], 0, sizeof(StaticMeta));
+  }
+  memset(staticMiss, 0, sizeof(staticMiss));                // It may have created what was missing, or its directory
+  portEXIT_CRITICAL(&staticMux);
+  staticDropAssets(fs, base);
+}
+
+// Drops a file and its siblings, or everything below a directory, from the PSRAM cache
+void staticDropAssets(int fs, const char *base){
+#if UseAssetCache
+  char name[304];
+  size_t len = strlcpy(name, base, 300);
+  assetCacheInvalidate(fs, name);                           // Also drops everything below it, if it is a directory
+  strcpy(name + len, ".gz");
+  assetCacheInvalidate(fs, name);
+  strcpy(name + len, ".br");
+  assetCacheInvalidate(fs, name);
+#endif
+}
+
+// Sends a static file: negotiates the encoding, answers conditional requests, sends from cache or file system.
+// Returns the bytes of the body sent
+size_t sendStaticFile(AsyncWebServerRequest *request, int fs, const char *path){
+  if(!storageAvailable(request)) return 0;             // 503 until the file systems are mounted (see Boot.ino)
+  StaticInfo m;
+  FS *fileSys = staticFS(fs);
+  if((fileSys == NULL) || !staticLookup(fs, path, m)){
+    request->send(404);
+    return 0;
+  }
+  const char *accept = request->hasHeader("Accept-Encoding") ? request->header("Accept-Encoding").c_str() : "";
+  int v = StaticPlain;
+  if(m.exists[StaticBr] && strstr(accept, "br")) v = StaticBr;
+  else if(m.exists[StaticGz] && (strstr(accept, "gzip") || !m.exists[StaticPlain])) v = StaticGz;  // Only a .gz? Send it anyway, like serveStatic
+  else if(!m.exists[StaticPlain]) v = StaticBr;
+  const char *suffix[3] = {"", ".gz", ".br"};
+
+  char etag[40];
+  snprintf(etag, sizeof(etag), "\"%x-%lx%s\"", m.size[v], (unsigned long)m.mtime[v], suffix[v]);
+  char lastModified[32] = "";
+  if(m.mtime[v] > 0){
+    struct tm t;
+    gmtime_r(&m.mtime[v], &t);
+    strftime(lastModified, sizeof(lastModified), "%a, %d %b %Y %H:%M:%S GMT", &t);
+  }
+
+  AsyncWebServerResponse *response = NULL;
+  bool notModified;
+  if(request->hasHeader("If-None-Match")){                  // If-None-Match wins over If-Modified-Since
+    const char *inm = request->header("If-None-Match").c_str();
+    notModified = (strstr(inm, etag) != NULL) || (strcmp(inm, "*") == 0);
+  } else {
+    notModified = lastModified[0] && request->hasHeader("If-Modified-Since") &&
+                  (strcmp(request->header("If-Modified-Since").c_str(), lastModified) == 0);
+  }
+  if(notModified){
+    static304++;
+    response = request->beginResponse(304);
+  } else {
+    char file[300];
+    sprintf(file, "%s%s", path, suffix[v]);
+    const char *mime = staticContentType(path);
+#if UseAssetCache
+    if(assetCacheLoad(fs, file)) response = assetCacheResponse(request, fs, file, mime);
+#endif
+    if(response == NULL) response = request->beginResponse(*fileSys, file, mime);
+    if(v == StaticGz) response->addHeader("Content-Encoding", "gzip");
+    if(v == StaticBr) response->addHeader("Content-Encoding", "br");
+  }
+  if(m.exists[StaticGz] || m.exists[StaticBr]) response->addHeader("Vary", "Accept-Encoding");
+  response->addHeader("ETag", etag);
+  if(lastModified[0]) response->addHeader("Last-Modified", lastModified);
+  response->addHeader("Cache-Control", cacheRule);
+  request->send(response);
+  return notModified ? 0 : m.size[v];
+}
+
+// Content type by file extension (the same types serveStatic uses)
+const char *staticContentType(const char *path){
+  static const char *types[][2] = {
+    {".htm","text/html"}, {".html","text/html"}, {".css","text/css"}, {".json","application/json"},
+    {".js","application/javascript"}, {".png","image/png"}, {".gif","image/gif"}, {".jpg","image/jpeg"},
+    {".ico","image/x-icon"}, {".svg","image/svg+xml"}, {".eot","font/eot"}, {".woff","font/woff"},
+    {".woff2","font/woff2"}, {".ttf","font/ttf"}, {".xml","text/xml"}, {".pdf","application/pdf"},
+    {".zip","application/zip"}, {".gz","application/x-gzip"}};
+  const char *ext = strrchr(path, '.');
+  if(ext)
+    for(int i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+      if(strcasecmp(ext, types[i][0]) == 0) return types[i][1];
+  return "text/plain";
+}
@@ -1,91 +1,306 @@
-// This is the structure of a Telegram Message as defined by the UniversalTelegramBot library:
-/*struct telegramMessage{
-  String text;
-  String chat_id;
-  String chat_title;
-  String from_id;
-  String from_name;
-  String date;
-  String type;
-  String file_caption;
-  String file_path;
-  String file_name;
-  bool hasDocument;
-  long file_size;
-  float longitude;
-  float latitude;
-  int update_id;
-  int message_id;  
-  int reply_to_message_id;
-  String reply_to_text;
-  String query_id;
-};*/
-
-#if (UseTelegram == TelegramReceive) || (UseTelegram == TelegramSendReceive)
-bool getTelegramMsgs(){
-  WiFiClientSecure secured_client;
-  UniversalTelegramBot bot("", secured_client);
-  bool msgReceived = false;
-  secured_client.setCACert(TELEGRAM_CERTIFICATE_ROOT);      // Add root certificate for api.telegram.org
-  for(int b = 0; b < numBots; b++){
-    if(Bots[b].receives){
-      bot.updateToken(Bots[b].token);
-      int numNewMessages = bot.getUpdates(Bots[b].lastReceived + 1);
-      Bots[b].lastReceived = bot.last_message_received;
-      while(numNewMessages){
-        msgReceived = true;
-        for(int m = 0; m < numNewMessages; m++){
-          if((bot.messages[m].from_id == tgChatID)          // Primary Telegram user.
-          || (bot.messages[m].from_id == tgAltChatID))      // Alternate Telegram user.
-            handleTelegramMessage(b, bot, m);
-        }
-        numNewMessages = bot.getUpdates(bot.last_message_received + 1);
-      }
-    }
-  }
-  return msgReceived;
-}
-
-bool handleTelegramMessage(int botNum, UniversalTelegramBot bot, int msgNum){
-  bool msgHandled = false;
-  if((botNum == 0) && (bot.messages[msgNum].text == "/status")){
-      char stat[1000];
-      serverStatus(stat);
-      bot.sendMessage(bot.messages[msgNum].from_id, stat, "");
-      msgHandled = true;
-  }
-  if(!msgHandled){
-    msgHandled = customTelegramRcvd(botNum, bot, bot.messages[msgNum]);
-  }
-  return msgHandled;
-}
-#endif
-
-#if (UseTelegram == TelegramSend) || (UseTelegram == TelegramSendReceive)
-
-void sendTelegramMsg(int botNum, char chatId[], char msg[]){
-  WiFiClientSecure secured_client;
-  UniversalTelegramBot bot("", secured_client);
-  secured_client.setCACert(TELEGRAM_CERTIFICATE_ROOT);      // Add root certificate for api.telegram.org
-  bot.updateToken(Bots[botNum].token);
-  bot.sendMessage(chatId, msg, "");                         // Send the message to the designated chatId
-}
-
-void sendTelegramMsgKbd(int botNum, char chatId[], char msg[], TelegramBtn btns[], int numBtns){
-  WiFiClientSecure secured_client;
-  UniversalTelegramBot bot("", secured_client);
-  String kbd = "[";
-  secured_client.setCACert(TELEGRAM_CERTIFICATE_ROOT);      // Add root certificate for api.telegram.org
-  bot.updateToken(Bots[botNum].token);
-  for(int i = 0; i < numBtns; i++){
-    kbd += "[{\"text\":\"";
-    kbd += btns[i].label;
-    kbd += "\",\"callback_data\":\"";
-    kbd += btns[i].response;
-    kbd += "\"}]";
-    if(i < numBtns -1) kbd += ",";
-  }
-  kbd += "]";
-  bot.sendMessageWithInlineKeyboard((String)chatId, msg, "", kbd);  // Send the message with the keyboard in a JSON String
-}
-#endif
+// This is the structure of a Telegram Message as defined by the UniversalTelegramBot library:
+/*struct telegramMessage{
+  String text;
+  String chat_id;
+  String chat_title;
+  String from_id;
+  String from_name;
+  String date;
+  String type;
+  String file_caption;
+  String file_path;
+  String file_name;
+  bool hasDocument;
+  long file_size;
+  float longitude;
+  float latitude;
+  int update_id;
+  int message_id;  
+  int reply_to_message_id;
+  String reply_to_text;
+  String query_id;
+};*/
+
+#if (UseTelegram == TelegramSend) || (UseTelegram == TelegramReceive) || (UseTelegram == TelegramSendReceive)
+// Telegram is handled by tasks of its own, so the webserver never waits for api.telegram.org:
+// - Messages to send are put into the outbox (TelegramOutbox entries) and return at once. The tgSender task sends them
+//   over one TLS connection that is kept open, so a burst of messages needs one handshake instead of one each.
+//   Consecutive messages to the same chat are sent as one (up to TelegramMaxMsg characters).
+//   A message that can't be sent is retried with growing pauses (1, 2, 4, ... seconds), TelegramRetries times.
+//   It stays in its place meanwhile, but newer messages are sent while it waits for its next try.
+// - The tgReceiver task long-polls for received messages on a connection of its own (the request waits at Telegram
+//   until a message arrives, up to TelegramLongPoll seconds). Received messages are handed over to loop(), so
+//   handleTelegramMessage and customTelegramRcvd run in loop() just as before.
+// The connections are verified with TelegramCACert (customize.h). To test against a local stand-in for
+// api.telegram.org, resolve the name to the stand-in and set TelegramCACert to the certificate that signed it.
+
+typedef struct {int bot;                                    // Index into Bots
+                char chatId[16];                            // Recipient
+                char *text;                                 // Message
+                char *kbd;                                  // Inline keyboard (JSON) or NULL
+                uint32_t queued;                            // millis() when queued, for the latency
+                uint32_t retryAt;                           // millis() of the next try, if tries > 0
+                int tries;                                  // Failed tries thus far
+               } TGOutMsg;
+TGOutMsg tgOutbox[TelegramOutbox];                          // Ring buffer. Entries are only removed by tgSender, once sent or dropped
+int tgHead = 0;
+int tgCount = 0;
+portMUX_TYPE tgMux = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t tgSenderTask = NULL;
+uint32_t tgSent = 0;                                        // Messages sent
+uint32_t tgCoalesced = 0;                                   // Messages sent together with the one before
+uint32_t tgDropped = 0;                                     // Messages dropped (outbox full or retries used up). Atomic, both tasks add
+uint32_t tgLatencyLast = 0;                                 // Milliseconds from queuing to sent, last message
+uint32_t tgLatencyMax = 0;                                  // and longest
+#if (UseTelegram == TelegramReceive) || (UseTelegram == TelegramSendReceive)
+typedef struct {int bot;                                    // Index into Bots of the bot that received it
+                telegramMessage msg;
+               } TGInMsg;
+QueueHandle_t tgInbox = NULL;                               // Received messages (TGInMsg *) waiting for loop()
+#endif
+
+void initTelegram(){
+  xTaskCreate(tgSender, "tgSender", 8192, NULL, 1, &tgSenderTask);
+#if (UseTelegram == TelegramReceive) || (UseTelegram == TelegramSendReceive)
+  tgInbox = xQueueCreate(TelegramInbox, sizeof(TGInMsg *));
+  xTaskCreate(tgReceiver, "tgReceiver", 8192, NULL, 1, NULL);
+#endif
+}
+
+// Allocates a copy of a string, in PSRAM if available
+char *tgCopy(const char *str){
+  size_t len = strlen(str) + 1;
+  char *copy = (char *)heap_caps_malloc(len, MALLOC_CAP_SPIRAM);
+  if(copy == NULL) copy = (char *)malloc(len);
+  if(copy) memcpy(copy, str, len);
+  return copy;
+}
+
+// Puts a message into the outbox. Returns false if it was dropped because the outbox is full
+bool telegramQueue(int botNum, const char *chatId, const char *msg, const char *kbd){
+  TGOutMsg m = {botNum, "", tgCopy(msg), kbd ? tgCopy(kbd) : NULL, millis(), 0, 0};
+  strlcpy(m.chatId, chatId, sizeof(m.chatId));
+  bool queued = false;
+  if(m.text && (m.kbd || !kbd)){
+    portENTER_CRITICAL(&tgMux);
+    if(tgCount < TelegramOutbox){
+      tgOutbox[(tgHead + tgCount) % TelegramOutbox] = m;
+      tgCount++;
+      queued = true;
+    }
+    portEXIT_CRITICAL(&tgMux);
+  }
+  if(!queued){
+    free(m.text);
+    free(m.kbd);
+    __atomic_fetch_add(&tgDropped, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+  if(tgSenderTask) xTaskNotifyGive(tgSenderTask);
+  return true;
+}
+
+// The entry of the outbox that is sent next: the oldest one not waiting for a retry. Returns -1 if all of them wait,
+// with wait set to the milliseconds until the first of them may be tried again
+int tgNextDue(int count, uint32_t &wait){
+  uint32_t now = millis();
+  wait = UINT32_MAX;
+  for(int i = 0; i < count; i++){
+    TGOutMsg &m = tgOutbox[(tgHead + i) % TelegramOutbox];
+    int32_t left = (int32_t)(m.retryAt - now);
+    if((m.tries == 0) || (left <= 0)) return i;
+    if((uint32_t)left < wait) wait = left;
+  }
+  return -1;
+}
+
+// Task sending the outbox
+void tgSender(void *parameter){
+  WiFiClientSecure client;
+  client.setCACert(TelegramCACert);
+  UniversalTelegramBot bot("", client);
+  while(true){
+    portENTER_CRITICAL(&tgMux);
+    int count = tgCount;
+    portEXIT_CRITICAL(&tgMux);
+    if(count == 0){
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);              // Until something is queued
+      continue;
+    }
+    if(!WiFi.isConnected()){
+      vTaskDelay(pdMS_TO_TICKS(1000));
+      continue;
+    }
+    // Entries don't change once queued and only this task moves or removes them, so they can be read without the lock
+    uint32_t wait;
+    int first = tgNextDue(count, wait);                     // Position in the outbox, counted from tgHead
+    if(first < 0){
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));        // Until the next retry, or something new is queued
+      continue;
+    }
+    TGOutMsg &m = tgOutbox[(tgHead + first) % TelegramOutbox];
+    int take = 1;                                           // The first, plus any following ones to the same chat
+    size_t len = strlen(m.text);
+    while((m.kbd == NULL) && (first + take < count)){
+      TGOutMsg &next = tgOutbox[(tgHead + first + take) % TelegramOutbox];
+      if((next.kbd != NULL) || (next.bot != m.bot) || (strcmp(next.chatId, m.chatId) != 0) ||
+         (len + 1 + strlen(next.text) > TelegramMaxMsg)) break;
+      len += 1 + strlen(next.text);
+      take++;
+    }
+    String text = m.text;
+    if(take > 1){
+      text.reserve(len);
+      for(int i = 1; i < take; i++){
+        text += "\n";
+        text += tgOutbox[(tgHead + first + i) % TelegramOutbox].text;
+      }
+    }
+    bot.updateToken(Bots[m.bot].token);
+    bool sent = m.kbd ? bot.sendMessageWithInlineKeyboard(m.chatId, text, "", m.kbd) : bot.sendMessage(m.chatId, text, "");
+    if(!sent){
+      client.stop();                                        // Start over with a new connection
+      if(++m.tries <= TelegramRetries){                     // Try again later. Newer messages go first meanwhile
+        uint32_t retryAt = millis() + (1000UL << (m.tries - 1));
+        for(int i = 0; i < take; i++){
+          TGOutMsg &again = tgOutbox[(tgHead + first + i) % TelegramOutbox];
+          again.tries = m.tries;
+          again.retryAt = retryAt;
+        }
+        continue;
+      }
+      __atomic_fetch_add(&tgDropped, take, __ATOMIC_RELAXED);  // Give up on these
+    }
+    uint32_t now = millis();
+    for(int i = 0; i < take; i++){
+      TGOutMsg &done = tgOutbox[(tgHead + first + i) % TelegramOutbox];
+      if(sent){
+        tgLatencyLast = now - done.queued;
+        if(tgLatencyLast > tgLatencyMax) tgLatencyMax = tgLatencyLast;
+      }
+      free(done.text);
+      free(done.kbd);
+    }
+    if(sent){
+      tgSent += take;
+      tgCoalesced += take - 1;
+    }
+    portENTER_CRITICAL(&tgMux);
+    for(int i = first - 1; i >= 0; i--)                     // Close the gap: the older ones (waiting for a retry) move up
+      tgOutbox[(tgHead + i + take) % TelegramOutbox] = tgOutbox[(tgHead + i) % TelegramOutbox];
+    tgHead = (tgHead + take) % TelegramOutbox;
+    tgCount -= take;
+    portEXIT_CRITICAL(&tgMux);
+  }
+}
+
+// Adds the outbox statistics to the status
+void telegramStatus(Print &out){
+  portENTER_CRITICAL(&tgMux);
+  int count = tgCount;
+  portEXIT_CRITICAL(&tgMux);
+  out.printf("Telegram: %i queued, %u sent (%u coalesced), %u dropped, latency %ums (max %ums)\n",
+    count, tgSent, tgCoalesced, __atomic_load_n(&tgDropped, __ATOMIC_RELAXED), tgLatencyLast, tgLatencyMax);
+}
+#endif
+
+#if (UseTelegram == TelegramReceive) || (UseTelegram == TelegramSendReceive)
+// Task long-polling for received messages
+void tgReceiver(void *parameter){
+  WiFiClientSecure client;
+  client.setCACert(TelegramCACert);
+  UniversalTelegramBot bot("", client);
+  int receivers = 0;
+  for(int b = 0; b < numBots; b++)
+    if(Bots[b].receives) receivers++;
+  if(receivers == 0) vTaskDelete(NULL);
+  bot.longPoll = max(1, TelegramLongPoll / receivers);     // Each receiving bot gets its share of the time
+  int failures = 0;
+  while(true){
+    if(!WiFi.isConnected()){
+      vTaskDelay(pdMS_TO_TICKS(1000));
+      continue;
+    }
+    for(int b = 0; b < numBots; b++){
+      if(!Bots[b].receives) continue;
+      bot.updateToken(Bots[b].token);
+      unsigned long start = millis();
+      int numNewMessages = bot.getUpdates(Bots[b].lastReceived + 1);
+      if((numNewMessages == 0) && (millis() - start < 1000)){ // Answered at once without messages: something is wrong
+        client.stop();
+        failures++;
+        vTaskDelay(pdMS_TO_TICKS(1000 << min(failures - 1, 6)));  // 1, 2, 4, ... 64 seconds
+        continue;
+      }
+      failures = 0;
+      Bots[b].lastReceived = bot.last_message_received;
+      for(int m = 0; m < numNewMessages; m++){
+        if((bot.messages[m].from_id == tgChatID)            // Primary Telegram user.
+        || (bot.messages[m].from_id == tgAltChatID)){       // Alternate Telegram user.
+          TGInMsg *in = new TGInMsg{b, bot.messages[m]};
+          if(xQueueSend(tgInbox, &in, 0) != pdTRUE) delete in;  // loop() is way behind. Drop it
+        }
+      }
+    }
+  }
+}
+
+// Handles one received message, if there is any. Called by loop(). Returns true if it did
+bool getTelegramMsgs(){
+  TGInMsg *in;
+  if((tgInbox == NULL) || (xQueueReceive(tgInbox, &in, 0) != pdTRUE)) return false;
+  handleTelegramMessage(in->bot, in->msg);
+  delete in;
+  return true;
+}
+
+bool handleTelegramMessage(int botNum, telegramMessage &msg){
+  bool msgHandled = false;
+  if((botNum == 0) && (msg.text == "/status")){
+      char stat[1000];
+      serverStatus(stat);
+      telegramQueue(botNum, msg.from_id.c_str(), stat, NULL);
+      msgHandled = true;
+  }
+  if(!msgHandled){
+    msgHandled = customTelegramRcvd(botNum, tgLoopBot(botNum), msg);
+  }
+  return msgHandled;
+}
+
+// The bot passed to customTelegramRcvd. Messages it sends directly are sent right away, in loop()
+UniversalTelegramBot &tgLoopBot(int botNum){
+  static WiFiClientSecure client;
+  static UniversalTelegramBot bot("", client);
+  static bool ready = false;
+  if(!ready){
+    client.setCACert(TelegramCACert);
+    ready = true;
+  }
+  bot.updateToken(Bots[botNum].token);
+  return bot;
+}
+#endif
+
+#if (UseTelegram == TelegramSend) || (UseTelegram == TelegramSendReceive)
+
+// Queues a message. It is sent by tgSender in the background
+void sendTelegramMsg(int botNum, char chatId[], char msg[]){
+  telegramQueue(botNum, chatId, msg, NULL);
+}
+
+// Queues a message with an inline keyboard. It is sent by tgSender in the background
+void sendTelegramMsgKbd(int botNum, char chatId[], char msg[], TelegramBtn btns[], int numBtns){
+  String kbd = "[";
+  for(int i = 0; i < numBtns; i++){
+    kbd += "[{\"text\":\"";
+    kbd += btns[i].label;
+    kbd += "\",\"callback_data\":\"";
+    kbd += btns[i].response;
+    kbd += "\"}]";
+    if(i < numBtns -1) kbd += ",";
+  }
+  kbd += "]";
+  telegramQueue(botNum, chatId, msg, kbd.c_str());
+}
+#endif
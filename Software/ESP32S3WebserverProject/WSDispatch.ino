@@ -0,0 +1,453 @@
+// Websocket request dispatching
+// Each request is looked up by name in a sorted table (binary search) instead of a chain of strcmp.
+// The core requests are in coreWSRoutes below. Custom requests are registered with registerWSRequest,
+// typically from customLateSetup(). Requests not found in either table are passed on to customWS_EVT.
+// JSON requests are indexed once, in place, so no JsonDocument is built on the heap.
+// Messages that arrive in several fragments are put back together before they are dispatched.
+
+// ------------------------- Core request handlers -------------------------
+void wsGetDateTime(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested date and time settings   This event is used in /admin.htm. Could be used in custom pages as well.
+  char rsvp[500];
+  getDateTimeSettings(rsvp,req.json);
+  client->text(rsvp);
+}
+
+void wsGetHostSettings(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested host settings.   This event is used within /admin.htm
+  char rsvp[1000] = "";                         // Buffer to hold host settings
+  getHostSettings(rsvp);
+  client->text(rsvp);
+}
+
+void wsSetHostSettings(AsyncWebSocketClient *client, WSRequest &req){
+  // Client wishes to change host settings   This event is used within /admin.htm
+  char rsvp[200] = "";                          // Buffer to hold response for client
+  if(setHostSettings(req.data,rsvp)){           // If errors, messages will be returned in rsvp.
+    sprintf(rsvp,"Message\nConfiguration changed. Rebooting. You will be disconnected.");
+    client->text(rsvp);
+    serialPrint("Rebooting after admin configuration change\n",true);
+#if useSerialWS
+    serialWS.send();                            // Don't wait for the flush policy, we are about to reboot
+#endif
+    delay(1000);
+    ESP.restart();
+  }else{
+    strcat(rsvp,"\nConfiguration changes ignored");
+    client->text(rsvp);
+  }
+}
+
+void wsSetDateTime(AsyncWebSocketClient *client, WSRequest &req){
+  // Client wishes to change date and time settings  This event is used in /admin.htm
+  char rsvp[200] = "";
+  if(setDateTimeSettings(req.data,rsvp)){       // If errors, messages will be returned in rsvp
+    sprintf(rsvp,"Message2\nDate and Time configuration changed.");
+  }else{
+    strcat(rsvp,"\nDate and Time changes ignored");
+  }
+  client->text(rsvp);
+}
+
+#if(UseFileManager)
+void wsFMgetBasic(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested basic data for the file manager. This event is used in /FileMan.htm.
+  // Return a JSON string containing hostname, file extensions allowed for edit, and a list of available file systems (SD, LittleFS,...)
+  char rsvp[400] = "";
+  FMgetBasic(rsvp);
+  client->text(rsvp);
+}
+
+void wsFMgetFS(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested data for a specific file system for the file manager. This event is used in /FileMan.htm.
+  // Return a JSON string containing the file system, capacity, used, free.
+  char filesys[12];
+  char rsvp[400] = "";
+  wsField(req, "filesys", filesys, sizeof(filesys));
+  FMgetFS(rsvp,filesys);
+  client->text(rsvp);
+}
+
+void wsFMgetDir(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested a page of the list of directories and files in a specific path on a specific file system
+  char filesys[12];
+  char dir[256];
+  char sort[8];
+  char cursor[300];
+  wsField(req, "filesys", filesys, sizeof(filesys));
+  wsField(req, "dir", dir, sizeof(dir));
+  wsField(req, "sort", sort, sizeof(sort));
+  wsField(req, "cursor", cursor, sizeof(cursor));
+  FMsendDir(client, filesys, dir, sort, wsFieldLong(req, "desc", 0) != 0, cursor);
+}
+
+void wsFMmkDir(AsyncWebSocketClient *client, WSRequest &req){
+  // Client has requested to create a new directory. The listing is sent again, in the order the client shows it
+  char filesys[12];
+  char dir[256];
+  char dname[256];
+  char sort[8];
+  wsField(req, "filesys", filesys, sizeof(filesys));
+  wsField(req, "dir", dir, sizeof(dir));
+  wsField(req, "dname", dname, sizeof(dname));
+  wsField(req, "sort", sort, sizeof(sort));
+  FMmkDir(getFMfsNum(filesys), dir, dname);
+  FMsendDir(client, filesys, dir, sort, wsFieldLong(req, "desc", 0) != 0, "");
+}
+
+void wsFMdelete(AsyncWebSocketClient *client, WSRequest &req){
+  char filesys[12];
+  char dir[256];
+  char fname[256];
+  char sort[8];
+  wsField(req, "filesys", filesys, sizeof(filesys));
+  wsField(req, "dir", dir, sizeof(dir));
+  wsField(req, "fname", fname, sizeof(fname));
+  wsField(req, "sort", sort, sizeof(sort));
+  int fsNum = getFMfsNum(filesys);
+  if((fsNum>=0) && dir[0] && fname[0]){
+    char fullPath[520];
+    snprintf(fullPath,sizeof(fullPath),"%s%s%s",dir,dir[strlen(dir)-1]=='/' ? "" : "/", fname);
+    FMdelete(fsNum,fullPath);
+    FMsendDir(client, filesys, dir, sort, wsFieldLong(req, "desc", 0) != 0, "");
+  }
+}
+
+void wsFMuploadBegin(AsyncWebSocketClient *client, WSRequest &req){
+  // Client will be uploading a file and wants the server to track the status.
+  char path[256];
+  wsField(req, "path", path, sizeof(path));
+  createUpload(path, (unsigned int)wsFieldLong(req, "size", 0));
+}
+
+void wsFMuploadEnd(AsyncWebSocketClient *client, WSRequest &req){
+  // Client knows/confirms uploading is finished, free up this slot in the upload structure
+  char path[256];
+  wsField(req, "path", path, sizeof(path));
+  deleteUpload(path);
+}
+
+void wsFMuploadStatus(AsyncWebSocketClient *client, WSRequest &req){
+  // Client requests the status of this upload
+  char path[256];
+  char stat[200];
+  wsField(req, "path", path, sizeof(path));
+  statusUpload(path, stat);
+  client->text(stat);
+}
+#endif // UseFileManager
+
+// Core requests. MUST be sorted by name (strcmp order, so upper case before lower case)!
+// This is verified at compile time.
+constexpr WSRoute coreWSRoutes[] = {
+#if(UseFileManager)
+  {"FMdelete",        wsFMdelete,        WSjson | WSlocal | WSstorage},
+  {"FMgetBasic",      wsFMgetBasic,      WSjson | WSlocal | WSstorage},
+  {"FMgetDir",        wsFMgetDir,        WSjson | WSlocal | WSstorage},
+  {"FMgetFS",         wsFMgetFS,         WSjson | WSlocal | WSstorage},
+  {"FMmkDir",         wsFMmkDir,         WSjson | WSlocal | WSstorage},
+  {"FMuploadBegin",   wsFMuploadBegin,   WSjson},
+  {"FMuploadEnd",     wsFMuploadEnd,     WSjson},
+  {"FMuploadStatus",  wsFMuploadStatus,  WSjson},
+#endif
+  {"getDateTime",     wsGetDateTime,     WSjson | WStext},
+  {"getHostSettings", wsGetHostSettings, WStext | WSlocal},
+#if UseMetrics
+  {"getMetrics",      wsGetMetrics,      WSjson},
+#endif
+  {"setDateTime",     wsSetDateTime,     WStext | WSlocal},
+  {"setHostSettings", wsSetHostSettings, WStext | WSlocal}
+};
+const int numCoreWSRoutes = sizeof(coreWSRoutes) / sizeof(WSRoute);
+static_assert(wsSorted(coreWSRoutes, sizeof(coreWSRoutes) / sizeof(WSRoute)), "coreWSRoutes must be sorted by name");
+
+// Custom requests, kept sorted as they are registered
+WSRoute customWSRoutes[WSmaxCustomRequests];
+int numCustomWSRoutes = 0;
+
+#if UseMetrics
+int wsCoreMetric[numCoreWSRoutes];                       // Metric of each request, by table index
+int wsCustomMetric[WSmaxCustomRequests];
+
+// Registers a metric for each core request. Called by setupMetrics, custom requests get theirs in registerWSRequest
+void wsSetupMetrics(){
+  for(int i = 0; i < numCoreWSRoutes; i++) wsCoreMetric[i] = metricsRegister(coreWSRoutes[i].name, "websocket");
+}
+
+// Metric of a route of either table
+int wsMetric(const WSRoute *route){
+  if((route >= coreWSRoutes) && (route < coreWSRoutes + numCoreWSRoutes)) return wsCoreMetric[route - coreWSRoutes];
+  return wsCustomMetric[route - customWSRoutes];
+}
+#endif
+
+// Register a custom websocket request. Call from customLateSetup().
+// name: the "request" attribute (JSON) or first line (text) of the message
+// handler: function to call, void handler(AsyncWebSocketClient *client, WSRequest &req)
+// flags: WSjson and/or WStext for the accepted formats, plus WSlocal if only local clients may use it
+//        and WSstorage if it needs the file systems (answered with storageNotReady until they are mounted)
+// Returns false if the table is full or the name is already registered.
+bool registerWSRequest(const char *name, WSHandler handler, uint8_t flags){
+  if(numCustomWSRoutes >= WSmaxCustomRequests) return false;
+  if(findWSRoute(customWSRoutes, numCustomWSRoutes, name)) return false;   // Before anything is moved
+  int i = numCustomWSRoutes;
+  while(i > 0){                                          // Insertion sort keeps the table ready for a binary search
+    if(strcmp(customWSRoutes[i-1].name, name) < 0) break;
+    customWSRoutes[i] = customWSRoutes[i-1];
+#if UseMetrics
+    wsCustomMetric[i] = wsCustomMetric[i-1];
+#endif
+    i--;
+  }
+  customWSRoutes[i] = {name, handler, flags};
+#if UseMetrics
+  wsCustomMetric[i] = metricsRegister(name, "websocket");
+#endif
+  numCustomWSRoutes++;
+  return true;
+}
+
+// Binary search for a request name in a sorted table
+const WSRoute *findWSRoute(const WSRoute routes[], int num, const char *name){
+  int lo = 0, hi = num - 1;
+  while(lo <= hi){
+    int mid = (lo + hi) / 2;
+    int c = strcmp(routes[mid].name, name);
+    if(c == 0) return &routes[mid];
+    if(c < 0) lo = mid + 1; else hi = mid - 1;
+  }
+  return NULL;
+}
+
+// Looks up and runs the handler for a complete text message. Returns false if no handler took it.
+bool wsDispatch(AsyncWebSocketClient *client, char *msg, size_t len){
+  WSRequest req;
+  if(!wsParse(req, msg, len)) return false;
+  uint8_t format = req.json ? WSjson : WStext;
+  const WSRoute *route = findWSRoute(coreWSRoutes, numCoreWSRoutes, req.name);
+  if(!(route && (route->flags & format)))
+    route = findWSRoute(customWSRoutes, numCustomWSRoutes, req.name);
+  if(!(route && (route->flags & format))) return false;
+  if((route->flags & WSlocal) && onlyLocalAdmin && !isLocal(client->remoteIP()))
+    return true;                                         // Not allowed. Silently ignored, just as before
+  if((route->flags & WSstorage) && !bootStorageReady()){ // File systems not mounted yet (see Boot.ino)
+    wsStorageNotReady(client, req);
+    return true;
+  }
+  metricsScope(wsMetric(route));
+  metricsBytes(len);
+  route->handler(client, req);
+  return true;
+}
+
+// Answers a request that needs the file systems while they are still being mounted. Pages send it again after
+// "retry" milliseconds, the same as the Retry-After of HTTP requests (see storageAvailable)
+void wsStorageNotReady(AsyncWebSocketClient *client, WSRequest &req){
+  char rsvp[100];
+  if(req.json) snprintf(rsvp, sizeof(rsvp), "{\"answer\":\"storageNotReady\",\"request\":\"%s\",\"retry\":2000}", req.name);
+  else snprintf(rsvp, sizeof(rsvp), "storageNotReady\n%s", req.name);
+  client->text(rsvp);
+}
+
+// ------------------------- Request parsing -------------------------
+// Skips white space
+const char *wsSkip(const char *p, const char *end){
+  while((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n'))) p++;
+  return p;
+}
+
+// Finds the closing quote of a string starting after the opening quote. Returns end if there is none.
+const char *wsStringEnd(const char *p, const char *end, char quote){
+  while((p < end) && (*p != quote)){
+    if(*p == '\\') p++;                                  // Skip the escaped character
+    p++;
+  }
+  return p < end ? p : end;
+}
+
+// Gets the "name" or "Identifier" of the data event received
+// It is terminated either with a zero, a carriage return (\r) or a newline (\n)
+void getOperand(char operand[], char input[], int maxLen){
+  int i;
+  for(i = 0; i < maxLen - 1; i++){
+    operand[i] = input[i];
+    if((operand[i] == '\r') || (operand[i] == '\n'))
+      operand[i] = 0;
+    if(operand[i] == 0)
+      break;
+  }
+  operand[i] = 0;
+}
+
+// Indexes a message. JSON attributes are recorded as pointers into the message, nothing is copied.
+// Text messages only have their first line (the operand) extracted.
+bool wsParse(WSRequest &req, char *msg, size_t len){
+  req.data = msg;
+  req.len = len;
+  req.numFields = 0;
+  req.name[0] = 0;
+  while((len > 0) && (msg[len-1] == 0)) len--;           // Pages send JSON with a terminating 0
+  req.json = (len > 0) && (msg[0] == '{');               // Rudimentary test to determine if the message is in JSON format
+  if(!req.json){
+    getOperand(req.name, msg, sizeof(req.name));
+    return req.name[0] != 0;
+  }
+  const char *p = msg + 1, *end = msg + len;
+  while(true){
+    p = wsSkip(p, end);
+    if((p >= end) || (*p == '}')) break;
+    if((*p != '"') && (*p != '\'')) return false;        // Attribute names must be quoted (single quotes accepted, as ArduinoJson does)
+    char q = *p++;
+    const char *key = p;
+    p = wsStringEnd(p, end, q);
+    if(p >= end) return false;
+    size_t keyLen = p - key;
+    p = wsSkip(p + 1, end);
+    if((p >= end) || (*p != ':')) return false;
+    p = wsSkip(p + 1, end);
+    if(p >= end) return false;
+    const char *val = p;
+    char vq = 0;
+    if((*p == '"') || (*p == '\'')){                     // String value
+      vq = *p++;
+      val = p;
+      p = wsStringEnd(p, end, vq);
+      if(p >= end) return false;
+    } else if((*p == '{') || (*p == '[')){               // Nested object or array. Skip it, strings included
+      int depth = 0;
+      do{
+        if((*p == '"') || (*p == '\'')) p = wsStringEnd(p + 1, end, *p);
+        else if((*p == '{') || (*p == '[')) depth++;
+        else if((*p == '}') || (*p == ']')) depth--;
+        p++;
+      } while((depth > 0) && (p < end));
+      if(depth > 0) return false;
+    } else {                                             // Number, true, false or null
+      while((p < end) && (*p != ',') && (*p != '}') && (*p != ' ') && (*p != '\r') && (*p != '\n')) p++;
+    }
+    if(req.numFields < WSmaxFields){
+      req.fields[req.numFields] = {key, val, (uint16_t)keyLen, (uint16_t)(p - val), vq};
+      req.numFields++;
+    }
+    if(vq) p++;                                          // Step over the closing quote
+    p = wsSkip(p, end);
+    if((p < end) && (*p == ',')) p++;
+  }
+  return wsField(req, "request", req.name, sizeof(req.name));
+}
+
+// Copies the value of a JSON attribute into out (unescaping strings). out is always zero terminated,
+// an empty string if the attribute doesn't exist. Returns false if the attribute doesn't exist.
+bool wsField(WSRequest &req, const char *key, char out[], size_t outLen){
+  out[0] = 0;
+  size_t keyLen = strlen(key);
+  for(int f = 0; f < req.numFields; f++){
+    if((req.fields[f].keyLen != keyLen) || (memcmp(req.fields[f].key, key, keyLen) != 0)) continue;
+    const char *p = req.fields[f].val, *end = p + req.fields[f].valLen;
+    size_t o = 0;
+    while((p < end) && (o + 1 < outLen)){
+      char c = *p++;
+      if(req.fields[f].quote && (c == '\\') && (p < end)){
+        c = *p++;
+        switch(c){
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'u':{                                       // \uXXXX, written as UTF-8
+          if(end - p < 4) break;
+          char hex[5] = {p[0], p[1], p[2], p[3], 0};
+          unsigned long u = strtoul(hex, NULL, 16);
+          p += 4;
+          if((u < 0x80) || (o + 2 >= outLen)){c = (char)u; break;}
+          if((u < 0x800) || (o + 3 >= outLen)){
+            out[o++] = 0xC0 | (u >> 6);
+          } else {
+            out[o++] = 0xE0 | (u >> 12);
+            out[o++] = 0x80 | ((u >> 6) & 0x3F);
+          }
+          c = 0x80 | (u & 0x3F);
+          break;
+        }
+        default: break;                                  // \" \' \\ \/ are the character itself
+        }
+      }
+      out[o++] = c;
+    }
+    out[o] = 0;
+    return true;
+  }
+  return false;
+}
+
+// Returns the value of a JSON attribute as a number (quoted or not), or def if the attribute doesn't exist.
+long wsFieldLong(WSRequest &req, const char *key, long def){
+  char buff[24];
+  if(!wsField(req, key, buff, sizeof(buff))) return def;
+  return strtol(buff, NULL, 10);
+}
+
+// ------------------------- Fragmented messages -------------------------
+// Messages may arrive in several frames (info->final) and frames in several packets (info->index).
+// Those pieces are collected per client here until the message is complete.
+// Single packet messages (the usual case) are used directly without copying.
+typedef struct {uint32_t id;                               // Websocket client id. 0 = slot is empty
+                char *buff;                                // Message assembled so far
+                size_t used;                               // Bytes in buff
+                bool overflow;                             // Message exceeded WSmaxMessage and will be ignored
+               } WSpartial;
+WSpartial wsPartials[8];                                   // The async web server allows 8 clients
+const int numWSpartials = sizeof(wsPartials) / sizeof(WSpartial);
+
+// Returns true once a complete text message is available in msg/msgLen (zero terminated).
+// Call wsRelease afterwards to free memory used for assembling the message.
+bool wsAssemble(AsyncWebSocketClient *client, AwsFrameInfo *info, uint8_t *data, size_t len, char *&msg, size_t &msgLen){
+  if(info->final && (info->num == 0) && (info->index == 0) && (info->len == len)){
+    msg = (char*)data;                                     // Whole message in one packet. The library zero terminates it
+    msgLen = len;
+    return info->opcode == WS_TEXT;
+  }
+  if(info->message_opcode != WS_TEXT) return false;
+  int s = -1;
+  for(int i = 0; i < numWSpartials; i++){                  // Find this client's slot, or else the first empty one
+    if(wsPartials[i].id == client->id()){s = i; break;}
+    if((s < 0) && (wsPartials[i].id == 0)) s = i;
+  }
+  if(s < 0) return false;
+  WSpartial &part = wsPartials[s];
+  if((info->num == 0) && (info->index == 0)){              // First piece of a new message
+    if(part.buff == NULL) part.buff = (char*)malloc(WSmaxMessage + 1);
+    part.id = client->id();
+    part.used = 0;
+    part.overflow = (part.buff == NULL);
+  }
+  if(part.id != client->id()) return false;                // A piece without its beginning
+  if(!part.overflow){
+    if(part.used + len > WSmaxMessage) part.overflow = true;
+    else {
+      memcpy(part.buff + part.used, data, len);
+      part.used += len;
+    }
+  }
+  if(!(info->final && (info->index + len == info->len))) return false;
+  if(part.overflow){                                       // Too big. Forget it
+    wsRelease(client);
+    return false;
+  }
+  part.buff[part.used] = 0;
+  msg = part.buff;
+  msgLen = part.used;
+  return true;
+}
+
+// Frees memory used for assembling a message from this client
+void wsRelease(AsyncWebSocketClient *client){
+  for(int i = 0; i < numWSpartials; i++){
+    if(wsPartials[i].id == client->id()){
+      free(wsPartials[i].buff);
+      wsPartials[i] = {0, NULL, 0, false};
+      break;
+    }
+  }
+}
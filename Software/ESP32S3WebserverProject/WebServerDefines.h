@@ -1,27 +1,111 @@
-// Define here what type, if any, SD card is to be used.
-#define TypeNoSD 0                      // Value indicating that no SD will be used.
-#define TypeSD   1                      // Value indicating that a SD card will be used. Card can be up to 32GB. Standard SPI pins will be used
-#define TypeMMC  2                      // Value indicating that a MMC card will be used. A MMC card is faster than SD, can be up to 2TB. Pins defined below
-
-// Define what file system is being used for standard files. Don't change the values for onSD or onLFS!
-#define onSD     1                      // Defines that standard files (/admin, /favicon.ico, DefaultHTM, etc.) are on SD/MMC
-#define onLFS    2                      // Defines that standard files (/admin, /favicon.ico, DefaultHTM, etc.) are in LittleFS (Flash)
-
-// Define if and how Telegram messages may be implemented on the server.
-#define noTelegram          0           // Value indicating Telegram will not be implemented
-#define TelegramSend        1           // Value indicating Telegram will be implemented to send messages only
-#define TelegramReceive     2           // Value indicating Telegram will be implemented to receive messages only
-#define TelegramSendReceive 3           // Value indicating Telegram will be implemented to send and receive messages
-
-// Structure defining Telegram Bots used:
-typedef struct{
-  String token;                         // The bot token for your Telegram bot was provided to you by Telegrams bot father. It identifies your bot.
-  bool receives;                        // True if this bot RECEIVES messages. False if it is only for sending messages.
-  long lastReceived;                    // Used internally to track new messages. Need not be assigned when creating bots.
-}Bot;
-
-// Structure defining simple buttons for use with Telegram
-typedef struct{
-  char label[21];
-  char response[21];
-}TelegramBtn;
+// Define here what type, if any, SD card is to be used.
+#define TypeNoSD 0                      // Value indicating that no SD will be used.
+#define TypeSD   1                      // Value indicating that a SD card will be used. Card can be up to 32GB. Standard SPI pins will be used
+#define TypeMMC  2                      // Value indicating that a MMC card will be used. A MMC card is faster than SD, can be up to 2TB. Pins defined below
+
+// Define what file system is being used for standard files. Don't change the values for onSD or onLFS!
+#define onSD     1                      // Defines that standard files (/admin, /favicon.ico, DefaultHTM, etc.) are on SD/MMC
+#define onLFS    2                      // Defines that standard files (/admin, /favicon.ico, DefaultHTM, etc.) are in LittleFS (Flash)
+
+// Indices of the file systems in the usage cache (see FSUsage). Don't change these values!
+#define FSUsageLittleFS 0               // LittleFS usage
+#define FSUsageSD       1               // SD/MMC usage
+
+// Variants of a static file (see StaticFiles)
+#define StaticPlain 0                   // The file itself
+#define StaticGz    1                   // Its gzipped sibling, file.gz
+#define StaticBr    2                   // Its brotli compressed sibling, file.br
+
+typedef struct{
+  bool exists[3];                       // Does the variant exist
+  uint32_t size[3];                     // Size of each variant
+  time_t mtime[3];                      // Modification time of each variant
+  bool dir;                             // The path is a directory (none of the variants exist then)
+}StaticInfo;
+
+// A file manager download (see FMDownload). Lives as long as the request
+typedef struct{
+  uint32_t ticket;                      // Place in the queue of downloads waiting for a slot
+  int slot;                             // Download slot while sending. -1 while waiting, -2 when done
+  int fsNum;                            // File system (index into fmFS) and
+  char path[256];                       // path of the file
+  size_t start;                         // First byte to send
+  size_t length;                        // Bytes to send
+}FMdlRequest;
+
+// Define if and how Telegram messages may be implemented on the server.
+#define noTelegram          0           // Value indicating Telegram will not be implemented
+#define TelegramSend        1           // Value indicating Telegram will be implemented to send messages only
+#define TelegramReceive     2           // Value indicating Telegram will be implemented to receive messages only
+#define TelegramSendReceive 3           // Value indicating Telegram will be implemented to send and receive messages
+
+// Structure defining Telegram Bots used:
+typedef struct{
+  String token;                         // The bot token for your Telegram bot was provided to you by Telegrams bot father. It identifies your bot.
+  bool receives;                        // True if this bot RECEIVES messages. False if it is only for sending messages.
+  long lastReceived;                    // Used internally to track new messages. Need not be assigned when creating bots.
+}Bot;
+
+// Structure defining simple buttons for use with Telegram
+typedef struct{
+  char label[21];
+  char response[21];
+}TelegramBtn;
+
+// Websocket requests are dispatched through sorted tables of WSRoute entries (see WSDispatch.ino)
+class AsyncWebSocketClient;
+#define WSjson  1                       // Request may arrive as JSON: {"request":"name",...}
+#define WStext  2                       // Request may arrive as text lines: name\n...
+#define WSlocal 4                       // Request is only allowed from the local network if onlyLocalAdmin is set
+#define WSstorage 8                     // Request needs the file systems. Answered with storageNotReady until they are mounted
+#define WSmaxFields 12                  // Maximum number of JSON attributes indexed per request
+
+// A received websocket request. JSON attributes are indexed once, in place, without building a document on the heap.
+// Use wsField/wsFieldLong to get at their values.
+typedef struct{
+  char *data;                           // The complete message, zero terminated
+  size_t len;                           // Length of the message
+  bool json;                            // True if the message is in JSON format
+  char name[25];                        // The "request" attribute (JSON) or first line (text) of the message
+  uint8_t numFields;                    // Number of JSON attributes indexed
+  struct{
+    const char *key;                    // Start of the attribute name within data
+    const char *val;                    // Start of the attribute value within data (without quotes)
+    uint16_t keyLen;
+    uint16_t valLen;
+    char quote;                         // Quote character of a string value, 0 if the value is not a string
+  } fields[WSmaxFields];
+}WSRequest;
+
+typedef void (*WSHandler)(AsyncWebSocketClient *client, WSRequest &req);
+
+typedef struct{
+  const char *name;                     // Name of the request. Tables must be sorted by name!
+  WSHandler handler;                    // Function handling the request
+  uint8_t flags;                        // WSjson, WStext, WSlocal and/or WSstorage
+}WSRoute;
+
+// Compile time helpers to verify that a WSRoute table is sorted (required for the binary search)
+constexpr int wsCmp(const char *a, const char *b){
+  return ((*a != *b) || (*a == 0)) ? (*a - *b) : wsCmp(a + 1, b + 1);
+}
+constexpr bool wsSorted(const WSRoute *r, size_t n){
+  return (n < 2) || ((wsCmp(r[0].name, r[1].name) < 0) && wsSorted(r + 1, n - 1));
+}
+
+// Core webpages bundled by Software/Tools/bundleAssets.py (see Assets.h)
+#define AssetAdmin 1                    // Page is only served if adminAllowed
+
+typedef struct{
+  const char *url;                      // Url of the page. Tables must be sorted by url!
+  const char *file;                     // File (where StandardFiles are) that is served if the page isn't embedded
+  const char *mime;                     // Content type
+  const uint8_t *data;                  // Embedded, gzipped page. NULL if it is served from the file system
+  size_t len;                           // Bytes in data
+  const char *etag;                     // ETag of the embedded page, quotes included
+  uint8_t flags;                        // AssetAdmin
+}EmbeddedAsset;
+
+constexpr bool assetsSorted(const EmbeddedAsset *a, size_t n){
+  return (n < 2) || ((wsCmp(a[0].url, a[1].url) < 0) && assetsSorted(a + 1, n - 1));
+}
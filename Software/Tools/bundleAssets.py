@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+# Asset bundler for the ESP32 S3 Webserver Project
+# Reads the core webpages from the HTML directory and writes Assets.h into the sketch directory.
+# Assets.h holds every page gzipped as a PROGMEM byte array, plus the sorted table embeddedAssets[]
+# with url, file, content type, length and ETag of each one (see EmbeddedAsset in WebServerDefines.h).
+# Which pages are actually embedded is decided in customize.h (embedMain, embedAdmin, ...). Pages that
+# are not embedded are served from the file system where StandardFiles are, just like before.
+#
+# Run it again whenever a page in HTML is changed:
+#   python3 Software/Tools/bundleAssets.py                   (from the repository root)
+#   python3 bundleAssets.py <html directory> <Assets.h>      (or with explicit paths)
+
+import gzip
+import hashlib
+import io
+import os
+import sys
+
+# Source file, url, file define (customize.h), embed define (customize.h), compile condition, admin only
+ASSETS = [
+    ("Main.htm",     "/Main.htm",    '"/Main.htm"', "embedMain",     None,             False),
+    ("Admin.htm",    "/admin",       "AdminHTM",    "embedAdmin",    None,             True),
+    ("SerialWS.htm", "/SerialWS",    "SerialHTM",   "embedSerialWS", "useSerialWS",    True),
+    ("favicon.ico",  "/favicon.ico", "FavIcon",     "embedFavicon",  None,             False),
+    ("fileman.htm",  "/fileman",     "FilAdminHTM", "embedFileman",  "UseFileManager", True),
+]
+
+MIME = {".htm": "text/html", ".html": "text/html", ".css": "text/css", ".js": "application/javascript",
+        ".ico": "image/x-icon", ".png": "image/png", ".jpg": "image/jpeg", ".svg": "image/svg+xml"}
+
+
+def arrayName(source):
+    return source.lower().replace(".", "_") + "_gz"
+
+
+def compress(data):
+    out = io.BytesIO()
+    # mtime 0 and no file name keep the output identical from run to run
+    with gzip.GzipFile(filename="", mode="wb", fileobj=out, compresslevel=9, mtime=0) as g:
+        g.write(data)
+    return out.getvalue()
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    html = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "..", "..", "HTML")
+    target = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, "..", "ESP32S3WebserverProject", "Assets.h")
+
+    out = []
+    out.append("// Generated by Software/Tools/bundleAssets.py from the HTML directory. Do not edit!")
+    out.append("// Run the bundler again after changing any of these pages.")
+    out.append("")
+    entries = []
+    for source, url, fileDef, embedDef, cond, admin in sorted(ASSETS, key=lambda a: a[1].encode()):
+        data = open(os.path.join(html, source), "rb").read()
+        gz = compress(data)
+        etag = '\\"' + hashlib.sha1(data).hexdigest()[:16] + '\\"'
+        mime = MIME.get(os.path.splitext(source)[1].lower(), "text/plain")
+        name = arrayName(source)
+        if cond:
+            out.append("#if %s" % cond)
+        out.append("#if %s" % embedDef)
+        out.append("// %s: %u bytes, %u gzipped" % (source, len(data), len(gz)))
+        out.append("const uint8_t %s[] PROGMEM = {" % name)
+        lines = ["  " + ",".join("0x%02X" % b for b in gz[i:i + 20]) for i in range(0, len(gz), 20)]
+        out.append(",\n".join(lines))
+        out.append("};")
+        out.append("#endif")
+        if cond:
+            out.append("#endif")
+        out.append("")
+        flags = "AssetAdmin" if admin else "0"
+        entries.append((cond, embedDef,
+                        '  {"%s", %s, "%s", %s, sizeof(%s), "%s", %s},' % (url, fileDef, mime, name, name, etag, flags),
+                        '  {"%s", %s, "%s", NULL, 0, NULL, %s},' % (url, fileDef, mime, flags)))
+
+    out.append("// Sorted by url, required for the binary search in findAsset")
+    out.append("constexpr EmbeddedAsset embeddedAssets[] = {")
+    for cond, embedDef, embedded, onFile in entries:
+        if cond:
+            out.append("#if %s" % cond)
+        out.append("#if %s" % embedDef)
+        out.append(embedded)
+        out.append("#else")
+        out.append(onFile)
+        out.append("#endif")
+        if cond:
+            out.append("#endif")
+    out.append("};")
+    out.append("constexpr size_t numEmbeddedAssets = sizeof(embeddedAssets) / sizeof(EmbeddedAsset);")
+    out.append('static_assert(assetsSorted(embeddedAssets, numEmbeddedAssets), "embeddedAssets must be sorted by url");')
+    out.append("")
+
+    with open(target, "wb") as f:
+        f.write("\r\n".join(out).encode())
+    print("Wrote %s with %u assets" % (target, len(ASSETS)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,44 @@
+// File manager listings: time and heap per page of FMsendDir, for small and large directories.
+// The heap a listing needs must not depend on the size of the directory.
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "FMHost.h"
+#include "Bench.h"
+
+#include "FSUsage.ino"
+#include "FM.ino"
+#include "FMDownload.ino"
+
+static AsyncWebSocket ws("/ws");
+
+// First page of the listing of a directory of n files, in each order
+static void benchDir(int n, size_t peak[4]){
+  HostDir d;
+  for(int i = 0; i < n; i++){
+    char name[32];
+    sprintf(name, "/file%05d.txt", (i * 7919) % n);
+    d.file(name, i % 1000, 1600000000 + i);
+  }
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  c->hostRecord = false;
+  const char *sorts[] = {"", "name", "date", "size"};
+  for(int s = 0; s < 4; s++){
+    char title[64];
+    snprintf(title, sizeof(title), "FMsendDir %5d files, order \"%s\"", n, sorts[s]);
+    size_t bytes = c->bytesReceived;
+    FMsendDir(c, "LittleFS", "/", sorts[s], false, "");
+    bytes = c->bytesReceived - bytes;
+    BenchResult r = bench(title, bytes, [&](){ FMsendDir(c, "LittleFS", "/", sorts[s], false, ""); });
+    peak[s] = r.peakBytes;
+  }
+  ws.hostDisconnect(1);
+}
+
+TEST(dirPageHeap){
+  size_t small[4], large[4];
+  benchDir(100, small);
+  benchDir(2000, large);
+  for(int s = 0; s < 4; s++) CHECK_EQ(large[s], small[s]);   // Same heap for 100 and 2000 files
+}
+
+BENCH_MAIN
@@ -0,0 +1,54 @@
+// File manager downloads: several at once, their responses pumped in turn the way the async TCP task does.
+// Only FMmaxDownloads of them hold read-ahead buffers, so the heap must not grow with the number of downloads.
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "FMHost.h"
+#include "Bench.h"
+
+#include "FSUsage.ino"
+#include "FM.ino"
+#include "FMDownload.ino"
+
+static const size_t fileSize = 256 * 1024;
+
+// n downloads of the same file, started together and sent in turn, 1460 bytes (one TCP segment) at a time.
+// Ends once all slots are free again, so each run starts with nothing on the heap
+static void downloads(int n){
+  std::vector<AsyncWebServerRequest *> r;
+  for(int i = 0; i < n; i++){
+    r.push_back(new AsyncWebServerRequest(HTTP_GET, "/download"));
+    FMsendDownload(r.back(), 0, "/f.bin", "f.bin");
+  }
+  uint8_t buf[1460];
+  for(int done = 0; done < n; ){
+    done = 0;
+    for(auto x : r){
+      if(x->hostComplete()){ done++; continue; }
+      if(x->hostPump(buf, sizeof(buf)) == RESPONSE_TRY_AGAIN) yield();   // FMreader is behind, or no slot yet
+    }
+  }
+  for(auto x : r) delete x;
+  for(bool busy = true; busy; yield()){                 // Until FMreader closed the files and released the buffers
+    busy = false;
+    for(auto &s : FMdlSlots) busy = busy || (s.state != FMdlFree);
+  }
+}
+
+TEST(concurrentDownloads){
+  HostDir d;
+  d.file("/f.bin", fileSize);
+  FMdownloadInit();
+  size_t peak[3];
+  int counts[] = {1, FMmaxDownloads, FMdownloadQueue};
+  for(int i = 0; i < 3; i++){
+    char title[64];
+    snprintf(title, sizeof(title), "downloads of %u KB, %d at once", (unsigned)(fileSize / 1024), counts[i]);
+    peak[i] = bench(title, counts[i] * fileSize, [&](){ downloads(counts[i]); }).peakBytes;
+  }
+  size_t buffers = 2 * FMdownloadBufKB * 1024;          // Read-ahead buffers of one download
+  CHECK(peak[0] >= buffers);
+  for(int i = 0; i < 3; i++)                            // Buffers and an open file per slot, a few KB per request.
+    CHECK(peak[i] < FMmaxDownloads * (buffers + 8192) + counts[i] * 4096);   // Waiting downloads hold no buffers
+}
+
+BENCH_MAIN
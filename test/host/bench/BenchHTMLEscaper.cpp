@@ -0,0 +1,38 @@
+// HTML escaping: textToHTML as it was (String replacements) and as it is (HTMLEscaper), on a status page sized text,
+// and HTMLEscaper streaming into a buffer. The new code must not use the heap.
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "Bench.h"
+#include "LegacyHTMLUtil.h"
+
+#include "HTMLUtil.ino"
+
+// About 1 KB of text as serverStatus writes it, with a few characters to escape
+static std::string statusText(){
+  std::string text;
+  for(int i = 0; i < 12; i++)
+    text += "Sensor " + std::to_string(i) + ":\t21.5\xC2\xB0" "C, \"ok\" & running \xE2\x80\x93 uptime 3d 4h\n";
+  return text;
+}
+
+TEST(textToHTML){
+  std::string text = statusText();
+  static char txt[4096];
+  bench("legacyTextToHTML", text.size(), [&](){ strcpy(txt, text.c_str()); legacyTextToHTML(txt, sizeof(txt)); });
+  BenchResult r = bench("textToHTML", text.size(), [&](){ strcpy(txt, text.c_str()); textToHTML(txt, sizeof(txt)); });
+  CHECK_EQ(r.allocsPerOp, 0);
+}
+
+TEST(escaperStream){
+  std::string text = statusText();
+  static char buf[4096];
+  BenchResult r = bench("HTMLEscaper into CharPrint", text.size(), [&](){
+    CharPrint out(buf, sizeof(buf));
+    HTMLEscaper html(out);
+    html.print(text.c_str());
+    html.flush();
+  });
+  CHECK_EQ(r.allocsPerOp, 0);
+}
+
+BENCH_MAIN
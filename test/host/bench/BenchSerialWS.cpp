@@ -0,0 +1,91 @@
+// SerialWS ring throughput, compared with SerialWS as it was (LegacySerialWS.h): small writes coalesced into frames for
+// 1 and 4 clients, a stalled client with a backlog, and received frames read back in blocks.
+// Sending allocates one shared message buffer per frame, nothing per client.
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "SerialWS.h"
+#include "Bench.h"
+#include "LegacySerialWS.h"
+
+extern AsyncWebSocket _ws;                     // SerialWS.cpp
+static AsyncWebServer server(80);
+
+static const char line[] = "Temp 21.5 C, humidity 48 %\n";    // 28 bytes, as a sketch would print them
+
+// Prints how the new version compares with the legacy one
+static void compare(const BenchResult &legacy, const BenchResult &now){
+  printf("  %-46s %10.2fx bytes/s, %.2f -> %.2f allocs\n", "new vs. legacy", now.mbPerSec / legacy.mbPerSec,
+    legacy.allocsPerOp, now.allocsPerOp);
+}
+
+// 64 lines written one by one through a 256 byte ring, sent whenever it is full and once at the end
+static BenchResult benchWrite(const char *title, int clients, bool stalled){
+  SerialWS s;
+  s.begin(&server, 256, 256);
+  s.setClientPolicy(stalled ? 1024 : 0, true);
+  for(int id = 1; id <= clients; id++) _ws.hostConnect(id)->hostRecord = false;
+  if(stalled) _ws.client(clients)->hostQueueFull = true;
+  BenchResult r = bench(title, 64 * strlen(line), [&](){
+    for(int i = 0; i < 64; i++) s.write(line);
+    s.send();
+  });
+  for(int id = 1; id <= clients; id++) _ws.hostDisconnect(id);
+  s.end();
+  return r;
+}
+
+static BenchResult benchLegacyWrite(const char *title, int clients, bool stalled){
+  LegacySerialWS s;
+  s.begin(&server, 256, 256);
+  for(int id = 1; id <= clients; id++) legacyWs.hostConnect(id)->hostRecord = false;
+  if(stalled) legacyWs.client(clients)->hostQueueFull = true;
+  BenchResult r = bench(title, 64 * strlen(line), [&](){
+    for(int i = 0; i < 64; i++) s.write(line);
+    s.send();
+  });
+  for(int id = 1; id <= clients; id++) legacyWs.hostDisconnect(id);
+  s.end();
+  return r;
+}
+
+TEST(txThroughput){
+  size_t frames = (64 * strlen(line) + 254) / 255;                    // 255 bytes fit in a 256 byte ring
+  BenchResult legacyOne = benchLegacyWrite("legacy: write 28 B lines, 1 client", 1, false);
+  BenchResult one = benchWrite("write 28 B lines, 1 client", 1, false);
+  compare(legacyOne, one);
+  BenchResult legacyFour = benchLegacyWrite("legacy: write 28 B lines, 4 clients", 4, false);
+  BenchResult four = benchWrite("write 28 B lines, 4 clients", 4, false);
+  compare(legacyFour, four);
+  BenchResult legacyStalled = benchLegacyWrite("legacy: write 28 B lines, 4 clients, 1 stalled", 4, true);
+  BenchResult stalled = benchWrite("write 28 B lines, 4 clients, 1 stalled", 4, true);
+  compare(legacyStalled, stalled);
+  CHECK(one.allocsPerOp <= 2 * frames);                                // Only the message buffer of each frame (object and data)
+  CHECK_EQ(four.allocsPerOp, one.allocsPerOp);                         // Shared by all clients
+}
+
+TEST(rxThroughput){
+  std::string frame(200, 'x');
+  char buf[128];
+  LegacySerialWS legacy;
+  legacy.begin(&server, 256, 1024);
+  AsyncWebSocketClient *lc = legacyWs.hostConnect(1);
+  BenchResult old = bench("legacy: receive 200 B frames, read 128 B blocks", frame.size(), [&](){
+    legacyWs.hostText(lc, frame.c_str());
+    while(legacy.read(buf, sizeof(buf)) > 0);
+  });
+  legacyWs.hostDisconnect(1);
+  legacy.end();
+  SerialWS s;
+  s.begin(&server, 256, 1024);
+  AsyncWebSocketClient *c = _ws.hostConnect(1);
+  BenchResult r = bench("receive 200 B frames, read 128 B blocks", frame.size(), [&](){
+    _ws.hostText(c, frame.c_str());
+    while(s.read(buf, sizeof(buf)) > 0);
+  });
+  compare(old, r);
+  CHECK(r.allocsPerOp <= 1);                                           // Only the copy of the frame hostText makes
+  _ws.hostDisconnect(1);
+  s.end();
+}
+
+BENCH_MAIN
@@ -0,0 +1,64 @@
+// Websocket dispatch: parsing a request and finding its route, for core and custom requests in both formats, with a
+// full custom table, compared with the strstr + JsonDocument + strcmp chain it replaced (LegacyWSDispatch.h).
+// Dispatching must not use the heap.
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "WSHost.h"
+#include "Bench.h"
+
+#include "WSDispatch.ino"
+#include "LegacyWSDispatch.h"
+
+static AsyncWebSocket ws("/ws");
+
+static void customHandler(AsyncWebSocketClient *client, WSRequest &req){
+  char field[32];
+  wsField(req, "value", field, sizeof(field));
+  client->text(field);
+}
+
+// Prints the cost per message of both versions
+static void compare(const BenchResult &legacy, const BenchResult &now){
+  printf("  %-46s %8.0f ns -> %.0f ns per message (%.2fx), %.2f -> %.2f allocs\n", "legacy vs. new", legacy.nsPerOp,
+    now.nsPerOp, legacy.nsPerOp / now.nsPerOp, legacy.allocsPerOp, now.allocsPerOp);
+}
+
+TEST(dispatch){
+  static char names[WSmaxCustomRequests][12];
+  numCustomWSRoutes = 0;
+  for(int i = 0; i < WSmaxCustomRequests; i++){
+    sprintf(names[i], "custom%02d", (i * 7) % WSmaxCustomRequests);
+    registerWSRequest(names[i], customHandler, WSjson);
+  }
+  const char *legacyNames[WSmaxCustomRequests];
+  for(int i = 0; i < WSmaxCustomRequests; i++) legacyNames[i] = names[i];
+  legacyCustomNames = legacyNames;
+  legacyNumCustom = WSmaxCustomRequests;
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  c->hostRecord = false;
+  const char *msgs[][2] = {
+    {"JSON core request", "{\"request\":\"FMgetDir\",\"filesys\":\"LittleFS\",\"dir\":\"/data/\",\"sort\":\"name\",\"desc\":0,\"cursor\":\"\"}"},
+    {"text core request", "getDateTime"},
+    {"JSON custom request", "{\"request\":\"custom05\",\"value\":\"42\"}"},
+    {"unknown request", "{\"request\":\"zzz\"}"}};
+  for(auto &m : msgs){
+    std::string msg = m[1];
+    std::string copy;
+    std::string title = std::string(m[0]) + ", legacy";
+    BenchResult legacy = bench(title.c_str(), msg.size(), [&](){
+      copy = msg;
+      legacyOnWsEvent(c, (uint8_t*)&copy[0], copy.size());
+    });
+    BenchResult r = bench(m[0], msg.size(), [&](){
+      copy = msg;                              // Handlers may change the message, so each run gets a fresh copy
+      wsDispatch(c, &copy[0], copy.size());
+    });
+    compare(legacy, r);
+    CHECK_EQ(r.allocsPerOp, 0);
+  }
+  legacyNumCustom = 0;
+  ws.hostDisconnect(1);
+  numCustomWSRoutes = 0;
+}
+
+BENCH_MAIN
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Writes prototypes of the functions defined in Arduino sketch files (.ino), as the Arduino build does before it
+# compiles them. The host tests include .ino files directly and need these declarations first.
+# Usage: inoproto.py output.h file.ino ...
+import re
+import sys
+
+KEYWORDS = {'if', 'while', 'for', 'switch', 'return', 'sizeof'}
+HEAD = re.compile(r'^[A-Za-z_][\w\s\*&:<>,]*[\s\*&]$')
+
+
+def strip(text):
+    """Removes comments, empties string and character literals and drops preprocessor lines."""
+    out = []
+    i = 0
+    n = len(text)
+    line_start = True
+    while i < n:
+        c = text[i]
+        if line_start and c == '#':                    # Preprocessor line, with its continuations
+            while i < n and text[i] != '\n':
+                i += 2 if text[i] == '\\' else 1
+            continue
+        if text.startswith('//', i):
+            while i < n and text[i] != '\n':
+                i += 1
+            continue
+        if text.startswith('/*', i):
+            end = text.find('*/', i + 2)
+            i = n if end < 0 else end + 2
+            out.append(' ')
+            continue
+        if c in '"\'':
+            j = i + 1
+            while j < n and text[j] != c:
+                j += 2 if text[j] == '\\' else 1
+            out.append(c + c)
+            i = j + 1
+            line_start = False
+            continue
+        out.append(c)
+        if c == '\n':
+            line_start = True
+        elif not c.isspace():
+            line_start = False
+        i += 1
+    return ''.join(out)
+
+
+def signature(decl):
+    """Name of the function decl defines ('head name(params)'). None if it isn't a function definition."""
+    if decl.endswith('const'):
+        decl = decl[:-5].rstrip()
+    if not decl.endswith(')'):
+        return None
+    depth = 0
+    for i in range(len(decl) - 1, -1, -1):             # Find the ( matching the last )
+        if decl[i] == ')':
+            depth += 1
+        elif decl[i] == '(':
+            depth -= 1
+            if depth == 0:
+                break
+    else:
+        return None
+    m = re.search(r'([A-Za-z_]\w*)\s*$', decl[:i])
+    if not m or m.group(1) in KEYWORDS:
+        return None
+    head = decl[:m.start()]
+    if not HEAD.match(head) or re.match(r'(typedef|struct|class|enum|union|namespace)\b', head):
+        return None
+    return m.group(1)
+
+
+def prototypes(text):
+    text = strip(text)
+    found = []
+    depth = 0
+    start = 0                                          # Start of the current top level declaration
+    for i, c in enumerate(text):
+        if c == '{':
+            if depth == 0:
+                decl = ' '.join(text[start:i].split())
+                if signature(decl):
+                    found.append(decl + ';')
+            depth += 1
+        elif c == '}':
+            depth -= 1
+            if depth == 0:
+                start = i + 1
+        elif c == ';' and depth == 0:
+            start = i + 1
+    return found
+
+
+def main():
+    out = ['// Generated by inoproto.py. Do not edit']
+    for name in sys.argv[2:]:
+        with open(name, encoding='utf-8', errors='replace') as f:
+            out += prototypes(f.read())
+    text = '\n'.join(out) + '\n'
+    try:
+        with open(sys.argv[1], encoding='utf-8') as f:
+            if f.read() == text:
+                return                                 # Unchanged. Keeps the tests from being rebuilt
+    except OSError:
+        pass
+    with open(sys.argv[1], 'w', encoding='utf-8') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
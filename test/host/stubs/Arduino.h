@@ -0,0 +1,148 @@
+// Host stand-in for the parts of the ESP32 Arduino core the sketch uses (see test/host/README.md)
+// Time, ESP, heap_caps, IPAddress and the FreeRTOS calls (tasks are threads) are implemented in support/Host.cpp.
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <time.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+
+using std::min;
+using std::max;
+
+#define B00000001 1
+
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+int64_t esp_timer_get_time();
+
+// ------------------------- ESP -------------------------
+class EspClass {
+  public:
+    uint32_t getCycleCount();                   // Host clock in 240MHz cycles, like an ESP32-S3 at full speed
+    uint32_t getCpuFreqMHz(){ return 240; }
+    uint32_t getFreeHeap();                     // From the counting allocator (see HostHeap.h)
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getFreePsram(){ return 0; }
+    uint32_t getMinFreePsram(){ return 0; }
+    uint32_t getMaxAllocPsram(){ return 0; }
+    uint64_t getEfuseMac(){ return 0x0000A1B2C3D4E5F6ULL; }
+    void restart();                             // Ends the program: there is nothing to reboot into
+};
+extern EspClass ESP;
+inline bool hostPsram = false;                 // What psramFound() says. Boards without PSRAM by default
+inline bool psramFound(){ return hostPsram; }
+
+#define MALLOC_CAP_SPIRAM  (1 << 10)
+#define MALLOC_CAP_8BIT    (1 << 2)
+inline int hostPsramFailures = 0;               // The next this many heap_caps_malloc calls fail (out of PSRAM)
+inline void *heap_caps_malloc(size_t size, uint32_t caps){
+  if(hostPsramFailures > 0){
+    hostPsramFailures--;
+    return NULL;
+  }
+  return malloc(size);
+}
+
+// ------------------------- IPAddress -------------------------
+class IPAddress {
+  public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t addr) : _addr(addr) {}
+    operator uint32_t() const { return _addr; }
+    uint8_t operator[](int i) const { return (_addr >> (8 * i)) & 0xFF; }
+    bool operator==(const IPAddress &o) const { return _addr == o._addr; }
+  private:
+    uint32_t _addr;
+};
+
+// ------------------------- FreeRTOS -------------------------
+// Tasks are threads. Critical sections are one lock per portMUX, as on the dual core ESP32.
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+typedef struct { volatile int locked; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+void hostEnterCritical(portMUX_TYPE *mux);
+void hostExitCritical(portMUX_TYPE *mux);
+#define portENTER_CRITICAL(mux)     hostEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)      hostExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) hostEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)  hostExitCritical(mux)
+
+struct HostTask;
+typedef HostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);            // Only vTaskDelete(NULL), at the end of a task
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+void xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+
+struct HostQueue;
+typedef HostQueue *QueueHandle_t;
+typedef HostQueue *SemaphoreHandle_t;
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial);
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s);
+#define xQueueSendToBack xQueueSend
+
+struct HostEvents;
+typedef HostEvents *EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+EventGroupHandle_t xEventGroupCreate();
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks);
+
+#include "WString.h"
+#include "Stream.h"
+
+// ------------------------- Serial -------------------------
+// Goes to stdout, unless a test captures it
+class HostSerial : public Stream {
+  public:
+    void begin(unsigned long baud){}
+    void setDebugOutput(bool on){}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t len) override;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    String *capture = NULL;                     // Output is appended here instead, if set
+};
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,368 @@
+// Host stand-in for the parts of ESPAsyncWebServer the sketch uses
+// There is no network: a test plays the part of the clients and the async TCP task. It builds requests (hostParam,
+// hostHeader), looks at what was sent back (hostResponse), drives callback responses (hostPump) and connects websocket
+// clients (hostConnect), whose frames are recorded (frames) or only counted.
+#ifndef ESPAsyncWebServer_h
+#define ESPAsyncWebServer_h
+
+#include <vector>
+#include <string>
+#include "Arduino.h"
+#include "FS.h"
+
+typedef enum {HTTP_GET     = 0b00000001,
+              HTTP_POST    = 0b00000010,
+              HTTP_DELETE  = 0b00000100,
+              HTTP_PUT     = 0b00001000,
+              HTTP_PATCH   = 0b00010000,
+              HTTP_HEAD    = 0b00100000,
+              HTTP_OPTIONS = 0b01000000,
+              HTTP_ANY     = 0b01111111} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+class AsyncWebServerRequest;
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)> ArBodyHandlerFunction;
+
+// ------------------------- Requests and responses -------------------------
+class AsyncClient {
+  public:
+    IPAddress remoteIP(){ return ip; }
+    IPAddress ip = IPAddress(192, 168, 4, 2);
+};
+
+class AsyncWebParameter {
+  public:
+    AsyncWebParameter(const String &name, const String &value, bool post) : _name(name), _value(value), _post(post) {}
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+    bool isPost() const { return _post; }
+    bool isFile() const { return false; }
+  private:
+    String _name;
+    String _value;
+    bool _post;
+};
+
+class AsyncWebServerResponse {
+  public:
+    AsyncWebServerResponse(int code, const String &type, const String &content) : code(code), contentType(type), content(content.c_str()) {}
+    virtual ~AsyncWebServerResponse() {}
+    void setCode(int c){ code = c; }
+    void addHeader(const String &name, const String &value){ headers.push_back({name.c_str(), value.c_str()}); }
+    // Value of a header added, NULL if there is none
+    const char *header(const char *name) const {
+      for(auto &h : headers) if(strcasecmp(h.first.c_str(), name) == 0) return h.second.c_str();
+      return NULL;
+    }
+    int code;
+    String contentType;
+    std::string content;                               // Body of a plain or stream response
+    std::vector<std::pair<std::string, std::string>> headers;
+    AwsResponseFiller filler;                          // Body of a callback response, see hostPump
+    size_t contentLength = 0;
+    size_t sent = 0;                                   // Bytes the filler delivered so far
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+  public:
+    AsyncResponseStream(const String &type) : AsyncWebServerResponse(200, type, String()) {}
+    size_t write(uint8_t c) override { content += (char)c; return 1; }
+    size_t write(const uint8_t *buf, size_t len) override { content.append((const char *)buf, len); return len; }
+    using Print::write;
+};
+
+class AsyncWebServerRequest {
+  public:
+    AsyncWebServerRequest(WebRequestMethodComposite method = HTTP_GET, const char *url = "/") : _method(method), _url(url) {}
+    ~AsyncWebServerRequest(){
+      hostDisconnect();
+      for(auto p : _params) delete p;
+      delete _response;
+      free(_tempObject);                               // Like the real one
+    }
+    void *_tempObject = NULL;
+
+    AsyncClient *client(){ return &_client; }
+    WebRequestMethodComposite method() const { return _method; }
+    const String &url() const { return _url; }
+    size_t contentLength() const { return hostContentLength; }
+
+    bool hasParam(const String &name, bool post = false, bool file = false) const { return getParam(name, post, file) != NULL; }
+    AsyncWebParameter *getParam(const String &name, bool post = false, bool file = false) const {
+      for(auto p : _params) if((p->name() == name) && (p->isPost() == post)) return p;
+      return NULL;
+    }
+    size_t params() const { return _params.size(); }
+    AsyncWebParameter *getParam(size_t i) const { return (i < _params.size()) ? _params[i] : NULL; }
+    bool hasHeader(const String &name) const { return findHeader(name) >= 0; }
+    String header(const char *name) const { int i = findHeader(name); return (i < 0) ? String() : _headers[i].second; }
+    size_t headers() const { return _headers.size(); }
+    String headerName(size_t i) const { return _headers[i].first; }
+    String header(size_t i) const { return _headers[i].second; }
+
+    bool authenticate(const char *user, const char *pass){ return hostAuthenticated; }
+    void requestAuthentication(){ send(401); }
+    void onDisconnect(std::function<void()> fn){ _onDisconnect = fn; }
+
+    AsyncWebServerResponse *beginResponse(int code, const String &type = String(), const String &content = String()){
+      return new AsyncWebServerResponse(code, type, content);
+    }
+    AsyncWebServerResponse *beginResponse(const String &type, size_t len, AwsResponseFiller filler){
+      AsyncWebServerResponse *r = new AsyncWebServerResponse(200, type, String());
+      r->filler = filler;
+      r->contentLength = len;
+      return r;
+    }
+    AsyncResponseStream *beginResponseStream(const String &type, size_t bufferSize = 1460){ return new AsyncResponseStream(type); }
+    AsyncWebServerResponse *beginResponse(FS &fs, const String &path, const String &type = String()){
+      File f = fs.open(path, "r");
+      if(!f || f.isDirectory()) return new AsyncWebServerResponse(404, String(), String());
+      AsyncWebServerResponse *r = new AsyncWebServerResponse(200, type, String());
+      uint8_t buf[512];
+      for(size_t n; (n = f.read(buf, sizeof(buf))) > 0; ) r->content.append((const char *)buf, n);
+      return r;
+    }
+    AsyncWebServerResponse *beginResponse_P(int code, const String &type, const uint8_t *content, size_t len){
+      AsyncWebServerResponse *r = new AsyncWebServerResponse(code, type, String());
+      r->content.assign((const char *)content, len);
+      return r;
+    }
+    void addInterestingHeader(const String &name){}
+    void send(AsyncWebServerResponse *response){
+      delete _response;
+      _response = response;
+    }
+    void send(int code, const String &type = String(), const String &content = String()){ send(beginResponse(code, type, content)); }
+
+    // ---- Host side ----
+    void hostParam(const char *name, const char *value, bool post = false){ _params.push_back(new AsyncWebParameter(name, value, post)); }
+    void hostHeader(const char *name, const char *value){ _headers.push_back({name, value}); }
+    AsyncWebServerResponse *hostResponse(){ return _response; }   // What was sent. NULL if nothing was (yet)
+    // Asks a callback response for up to maxLen more bytes, the way the async TCP task does once there is room to send.
+    // Returns what the filler returned: bytes, 0 or RESPONSE_TRY_AGAIN. 0 as well once the whole content was delivered
+    size_t hostPump(uint8_t *buffer, size_t maxLen){
+      if(!(_response && _response->filler)) return 0;
+      size_t n = _response->contentLength - _response->sent;
+      if(n > maxLen) n = maxLen;
+      if((n == 0) && (_response->sent > 0)) return 0;
+      size_t r = _response->filler(buffer, n, _response->sent);
+      if(r != RESPONSE_TRY_AGAIN) _response->sent += r;
+      return r;
+    }
+    bool hostComplete() const { return _response && (_response->sent >= _response->contentLength); }
+    // The connection closes. The real server does this for every request, done or not
+    void hostDisconnect(){
+      if(_onDisconnect){
+        auto fn = _onDisconnect;
+        _onDisconnect = nullptr;
+        fn();
+      }
+    }
+    bool hostAuthenticated = true;
+    size_t hostContentLength = 0;
+  private:
+    int findHeader(const String &name) const {
+      for(size_t i = 0; i < _headers.size(); i++) if(strcasecmp(_headers[i].first.c_str(), name.c_str()) == 0) return i;
+      return -1;
+    }
+    WebRequestMethodComposite _method;
+    String _url;
+    AsyncClient _client;
+    std::vector<AsyncWebParameter *> _params;
+    std::vector<std::pair<String, String>> _headers;
+    AsyncWebServerResponse *_response = NULL;
+    std::function<void()> _onDisconnect;
+};
+
+// ------------------------- Handlers and server -------------------------
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *request){ return false; }
+    virtual void handleRequest(AsyncWebServerRequest *request){}
+    virtual bool isRequestHandlerTrivial(){ return true; }
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+  public:
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+    ArUploadHandlerFunction onUpload;
+    ArBodyHandlerFunction onBody;
+    bool canHandle(AsyncWebServerRequest *request) override { return (request->url() == uri) && (request->method() & method); }
+    void handleRequest(AsyncWebServerRequest *request) override { if(onRequest) onRequest(request); }
+};
+
+class AsyncWebServer {
+  public:
+    AsyncWebServer(uint16_t port) {}
+    ~AsyncWebServer(){ for(auto h : _routes) delete h; }
+    void begin(){}
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                                ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr){
+      AsyncCallbackWebHandler *h = new AsyncCallbackWebHandler;
+      h->uri = uri;
+      h->method = method;
+      h->onRequest = onRequest;
+      h->onUpload = onUpload;
+      h->onBody = onBody;
+      _routes.push_back(h);
+      _handlers.push_back(h);
+      return *h;
+    }
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler){ _handlers.push_back(handler); return *handler; }
+    bool removeHandler(AsyncWebHandler *handler){
+      for(size_t i = 0; i < _handlers.size(); i++)
+        if(_handlers[i] == handler){ _handlers.erase(_handlers.begin() + i); return true; }
+      return false;
+    }
+    void onNotFound(ArRequestHandlerFunction fn){ _notFound = fn; }
+    // Host side: hands a request to the first handler that takes it, as the server does once the request is complete
+    void hostRequest(AsyncWebServerRequest *request){
+      for(auto h : _handlers)
+        if(h->canHandle(request)){ h->handleRequest(request); return; }
+      if(_notFound) _notFound(request);
+      else request->send(404);
+    }
+  private:
+    std::vector<AsyncWebHandler *> _handlers;
+    std::vector<AsyncCallbackWebHandler *> _routes;
+    ArRequestHandlerFunction _notFound;
+};
+
+// ------------------------- Websockets -------------------------
+typedef enum {WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA} AwsEventType;
+typedef enum {WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG} AwsFrameType;
+
+typedef struct {uint8_t message_opcode;
+                uint32_t num;
+                uint8_t final;
+                uint8_t masked;
+                uint8_t opcode;
+                uint64_t len;
+                uint8_t mask[4];
+                uint64_t index;
+               } AwsFrameInfo;
+
+class AsyncWebSocketMessageBuffer {
+  public:
+    AsyncWebSocketMessageBuffer(size_t size) : _data(new uint8_t[size + 1]), _len(size) { _data[size] = 0; }
+    ~AsyncWebSocketMessageBuffer(){ delete[] _data; }
+    uint8_t *get(){ return _data; }
+    size_t length() const { return _len; }
+  private:
+    uint8_t *_data;
+    size_t _len;
+};
+
+class AsyncWebSocket;
+
+// A frame a client got
+struct HostFrame {
+  bool binary;
+  std::string data;
+};
+
+class AsyncWebSocketClient {
+  public:
+    AsyncWebSocketClient(AsyncWebSocket *server, uint32_t id, IPAddress ip) : _server(server), _id(id), _ip(ip) {}
+    uint32_t id() const { return _id; }
+    IPAddress remoteIP() const { return _ip; }
+    AsyncWebSocket *server(){ return _server; }
+    bool queueIsFull() const { return hostQueueFull; }
+    void text(const char *msg, size_t len){ take(false, (const uint8_t *)msg, len); }
+    void text(const char *msg){ text(msg, strlen(msg)); }
+    void text(uint8_t *msg, size_t len){ text((const char *)msg, len); }
+    void text(const String &msg){ text(msg.c_str(), msg.length()); }
+    void text(AsyncWebSocketMessageBuffer *buffer){ take(false, buffer->get(), buffer->length()); }
+    void binary(const uint8_t *msg, size_t len){ take(true, msg, len); }
+    void binary(AsyncWebSocketMessageBuffer *buffer){ take(true, buffer->get(), buffer->length()); }
+
+    // ---- Host side ----
+    bool hostQueueFull = false;                        // A full queue drops further frames, like the real one
+    bool hostRecord = true;                            // Keep the frames (false only counts them, for benchmarks)
+    std::vector<HostFrame> frames;
+    size_t framesReceived = 0;
+    size_t bytesReceived = 0;
+    size_t framesDropped = 0;
+    std::string lastText() const { return frames.empty() ? std::string() : frames.back().data; }
+  private:
+    void take(bool binary, const uint8_t *data, size_t len){
+      if(hostQueueFull){ framesDropped++; return; }
+      framesReceived++;
+      bytesReceived += len;
+      if(hostRecord) frames.push_back({binary, std::string((const char *)data, len)});
+    }
+    AsyncWebSocket *_server;
+    uint32_t _id;
+    IPAddress _ip;
+};
+
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    AsyncWebSocket(const char *url) : _url(url) {}
+    ~AsyncWebSocket(){ for(auto c : _clients) delete c; }
+    void onEvent(AwsEventHandler handler){ _handler = handler; }
+    size_t count() const { return _clients.size(); }
+    AsyncWebSocketClient *client(uint32_t id){
+      for(auto c : _clients) if(c->id() == id) return c;
+      return NULL;
+    }
+    AsyncWebSocketMessageBuffer *makeBuffer(size_t size){ return new AsyncWebSocketMessageBuffer(size); }
+    void textAll(AsyncWebSocketMessageBuffer *buffer){
+      for(auto c : _clients) c->text(buffer);
+      delete buffer;                                   // The real one counts references and deletes it once sent
+    }
+    void textAll(const char *msg, size_t len){           // Like the real one: copied into one buffer shared by all clients
+      AsyncWebSocketMessageBuffer *buffer = makeBuffer(len);
+      memcpy(buffer->get(), msg, len);
+      textAll(buffer);
+    }
+    void textAll(const uint8_t *msg, size_t len){ textAll((const char *)msg, len); }
+    void textAll(const char *msg){ textAll(msg, strlen(msg)); }
+    void textAll(const String &msg){ textAll(msg.c_str(), msg.length()); }
+    void binaryAll(AsyncWebSocketMessageBuffer *buffer){
+      for(auto c : _clients) c->binary(buffer);
+      delete buffer;
+    }
+    void binaryAll(const uint8_t *msg, size_t len){ for(auto c : _clients) c->binary(msg, len); }
+    void cleanupClients(uint16_t maxClients = 8){}
+
+    // ---- Host side ----
+    AsyncWebSocketClient *hostConnect(uint32_t id, IPAddress ip = IPAddress(192, 168, 4, 2)){
+      AsyncWebSocketClient *c = new AsyncWebSocketClient(this, id, ip);
+      _clients.push_back(c);
+      if(_handler) _handler(this, c, WS_EVT_CONNECT, NULL, NULL, 0);
+      return c;
+    }
+    void hostDisconnect(uint32_t id){
+      for(size_t i = 0; i < _clients.size(); i++){
+        if(_clients[i]->id() != id) continue;
+        AsyncWebSocketClient *c = _clients[i];
+        if(_handler) _handler(this, c, WS_EVT_DISCONNECT, NULL, NULL, 0);
+        _clients.erase(_clients.begin() + i);
+        delete c;
+        return;
+      }
+    }
+    // A text message in one frame, zero terminated as the real library delivers it
+    void hostText(AsyncWebSocketClient *c, const char *msg){
+      std::string copy(msg);
+      AwsFrameInfo info = {WS_TEXT, 0, 1, 1, WS_TEXT, copy.size(), {0, 0, 0, 0}, 0};
+      if(_handler) _handler(this, c, WS_EVT_DATA, &info, (uint8_t *)&copy[0], copy.size());
+    }
+  private:
+    String _url;
+    std::vector<AsyncWebSocketClient *> _clients;
+    AwsEventHandler _handler;
+};
+
+#endif
@@ -0,0 +1,82 @@
+// Host stand-in for FS and File of the ESP32 Arduino core, backed by POSIX files (see support/HostFS.cpp)
+// A file system is a mount point of the ESP32 virtual file system ("/littlefs", "/sd"), mapped to a directory of the
+// host with hostMount. The sketch reads directories and file details with opendir and stat on virtual paths, as the
+// ESP32 allows. These are redirected through the same mapping.
+#ifndef FS_h
+#define FS_h
+
+#include <memory>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "Stream.h"
+
+void hostMount(const char *mount, const char *dir);     // Maps mount (such as "/littlefs") to a host directory
+std::string hostPath(const char *path);                  // Host path of a virtual path. Unmapped paths stay as they are
+DIR *hostOpendir(const char *path);
+int hostStat(const char *path, struct stat *st);
+extern volatile uint32_t hostWriteDelayMs;               // Each block written to a file takes this long (slow storage). 0 by default
+extern uint32_t hostStatCalls;                           // Number of stat calls thus far
+#define opendir(path)   hostOpendir(path)
+#define stat(path, st)  hostStat(path, st)
+
+namespace fs {
+
+enum SeekMode {SeekSet = 0, SeekCur = 1, SeekEnd = 2};
+
+struct FileImpl;
+
+class File : public Stream {
+  public:
+    File() {}
+    File(std::shared_ptr<FileImpl> impl) : _impl(impl) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t read(uint8_t *buf, size_t size);
+    size_t readBytes(char *buf, size_t size){ return read((uint8_t *)buf, size); }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const;
+    time_t getLastWrite();
+    const char *path() const;
+    const char *name() const;
+    bool isDirectory() const;
+    File openNextFile(const char *mode = "r");
+    void rewindDirectory();
+  private:
+    std::shared_ptr<FileImpl> _impl;
+};
+
+class FS {
+  public:
+    constexpr FS(const char *mount) : _mount(mount) {}
+    File open(const char *path, const char *mode = "r", bool create = false);
+    File open(const String &path, const char *mode = "r", bool create = false){ return open(path.c_str(), mode, create); }
+    bool exists(const char *path);
+    bool exists(const String &path){ return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path){ return remove(path.c_str()); }
+    bool rename(const char *from, const char *to);
+    bool mkdir(const char *path);
+    bool mkdir(const String &path){ return mkdir(path.c_str()); }
+    bool rmdir(const char *path);
+    const char *mountpoint() const { return _mount; }
+  protected:
+    const char *_mount;
+};
+
+}
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif
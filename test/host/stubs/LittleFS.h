@@ -0,0 +1,19 @@
+// Host stand-in for LittleFS of the ESP32 Arduino core. Mounted at /littlefs like on the ESP32 (see FS.h)
+#ifndef LittleFS_h
+#define LittleFS_h
+
+#include "FS.h"
+
+class LittleFSFS : public FS {
+  public:
+    constexpr LittleFSFS() : FS("/littlefs") {}
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10, const char *label = NULL){ return true; }
+    void end(){}
+    size_t totalBytes();                                  // hostTotalBytes (4MB unless a test changes it)
+    size_t usedBytes();                                   // Sum of the sizes of all files below the mount point
+};
+extern LittleFSFS LittleFS;
+extern size_t hostTotalBytes;
+extern void (*hostWhileUsedBytes)();                      // If set, usedBytes calls it halfway, as if another task ran meanwhile
+
+#endif
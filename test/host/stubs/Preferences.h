@@ -0,0 +1,44 @@
+// Host stand-in for Preferences of the ESP32 Arduino core. Namespaces and keys are kept in memory for the run
+#ifndef Preferences_h
+#define Preferences_h
+
+#include <map>
+#include <string>
+#include "Arduino.h"
+
+class Preferences {
+  public:
+    bool begin(const char *name, bool readOnly = false){ _ns = &store()[name]; _readOnly = readOnly; return true; }
+    void end(){ _ns = NULL; }
+    bool clear(){ if(!writable()) return false; _ns->clear(); return true; }
+    bool remove(const char *key){ return writable() && (_ns->erase(key) > 0); }
+    bool isKey(const char *key){ return _ns && _ns->count(key); }
+    size_t putBytes(const char *key, const void *value, size_t len){
+      if(!writable()) return 0;
+      (*_ns)[key] = std::string((const char *)value, len);
+      return len;
+    }
+    size_t getBytesLength(const char *key){ return isKey(key) ? (*_ns)[key].size() : 0; }
+    size_t getBytes(const char *key, void *buf, size_t maxLen){
+      if(!isKey(key)) return 0;
+      const std::string &v = (*_ns)[key];
+      if(v.size() > maxLen) return 0;                      // Like the real one: nothing is copied if it doesn't fit
+      memcpy(buf, v.data(), v.size());
+      return v.size();
+    }
+    size_t putString(const char *key, const char *value){ return putBytes(key, value, strlen(value) + 1) ? strlen(value) : 0; }
+    String getString(const char *key, const String &def = String()){ return isKey(key) ? String((*_ns)[key].c_str()) : def; }
+    size_t putBool(const char *key, bool value){ uint8_t v = value; return putBytes(key, &v, 1); }
+    bool getBool(const char *key, bool def = false){ uint8_t v = def; getBytes(key, &v, 1); return v; }
+    size_t putInt(const char *key, int32_t value){ return putBytes(key, &value, 4); }
+    int32_t getInt(const char *key, int32_t def = 0){ int32_t v = def; getBytes(key, &v, 4); return v; }
+    static void hostReset(){ store().clear(); }           // Forget everything, as if the flash was erased
+  private:
+    typedef std::map<std::string, std::string> Namespace;
+    static std::map<std::string, Namespace> &store(){ static std::map<std::string, Namespace> s; return s; }
+    bool writable(){ return _ns && !_readOnly; }
+    Namespace *_ns = NULL;
+    bool _readOnly = false;
+};
+
+#endif
@@ -0,0 +1,52 @@
+// Host stand-in for Print of the ESP32 Arduino core. Same virtual functions, printf uses the heap the same way
+#ifndef Print_h
+#define Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size){
+      size_t n = 0;
+      while(size--){
+        if(write(*buffer++)) n++;
+        else break;
+      }
+      return n;
+    }
+    size_t write(const char *str){ return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size){ return write((const uint8_t *)buffer, size); }
+    virtual int availableForWrite(){ return 0; }
+    virtual void flush(){}
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+    size_t print(const String &s){ return write(s.c_str(), s.length()); }
+    size_t print(const char str[]){ return write(str); }
+    size_t print(char c){ return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC){ return printNumber(n, base); }
+    size_t print(int n, int base = DEC){ return printSigned(n, base); }
+    size_t print(unsigned int n, int base = DEC){ return printNumber(n, base); }
+    size_t print(long n, int base = DEC){ return printSigned(n, base); }
+    size_t print(unsigned long n, int base = DEC){ return printNumber(n, base); }
+    size_t print(long long n, int base = DEC){ return printSigned(n, base); }
+    size_t print(unsigned long long n, int base = DEC){ return printNumber(n, base); }
+    size_t print(double n, int digits = 2);
+    template <typename T> size_t println(T x){ size_t n = print(x); return n + println(); }
+    size_t println(){ return write("\r\n"); }
+  private:
+    size_t printNumber(unsigned long long n, int base);
+    size_t printSigned(long long n, int base){
+      if((base == DEC) && (n < 0)) return write('-') + printNumber(-(unsigned long long)n, base);
+      return printNumber(n, base);
+    }
+};
+
+#endif
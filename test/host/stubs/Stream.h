@@ -0,0 +1,22 @@
+// Host stand-in for Stream of the ESP32 Arduino core
+#ifndef Stream_h
+#define Stream_h
+
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout){ _timeout = timeout; }
+    String readStringUntil(char terminator){
+      String s;
+      for(int c; ((c = read()) >= 0) && (c != terminator); ) s += (char)c;
+      return s;
+    }
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+#endif
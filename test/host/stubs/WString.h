@@ -0,0 +1,84 @@
+// Host stand-in for String of the Arduino core, on top of std::string (so it uses the heap like the real one)
+#ifndef WString_h
+#define WString_h
+
+#include <string>
+#include <string.h>
+#include <stdlib.h>
+
+class String {
+  public:
+    String(const char *s = "") : _s(s ? s : "") {}
+    String(const char *s, size_t len) : _s(s, len) {}
+    String(const std::string &s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int n) : _s(std::to_string(n)) {}
+    explicit String(unsigned int n) : _s(std::to_string(n)) {}
+    explicit String(long n) : _s(std::to_string(n)) {}
+    explicit String(unsigned long n) : _s(std::to_string(n)) {}
+
+    const char *c_str() const { return _s.c_str(); }
+    unsigned int length() const { return _s.length(); }
+    bool isEmpty() const { return _s.empty(); }
+    char operator[](unsigned int i) const { return (i < _s.length()) ? _s[i] : 0; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    bool concat(const String &s){ _s += s._s; return true; }
+    bool concat(const char *s){ if(s) _s += s; return s != NULL; }
+    bool concat(char c){ _s += c; return true; }
+    String &operator+=(const String &s){ concat(s); return *this; }
+    String &operator+=(const char *s){ concat(s); return *this; }
+    String &operator+=(char c){ concat(c); return *this; }
+    friend String operator+(const String &a, const String &b){ return String(a._s + b._s); }
+    friend String operator+(const String &a, const char *b){ return String(a._s + b); }
+    friend String operator+(const char *a, const String &b){ return String(a + b._s); }
+
+    bool equals(const String &s) const { return _s == s._s; }
+    bool equals(const char *s) const { return _s == (s ? s : ""); }
+    bool operator==(const String &s) const { return equals(s); }
+    bool operator==(const char *s) const { return equals(s); }
+    bool operator!=(const String &s) const { return !equals(s); }
+    bool operator!=(const char *s) const { return !equals(s); }
+    bool startsWith(const String &s) const { return _s.compare(0, s._s.length(), s._s) == 0; }
+    bool endsWith(const String &s) const {
+      return (_s.length() >= s._s.length()) && (_s.compare(_s.length() - s._s.length(), s._s.length(), s._s) == 0);
+    }
+    int indexOf(char c, unsigned int from = 0) const { size_t i = _s.find(c, from); return (i == std::string::npos) ? -1 : (int)i; }
+    int indexOf(const String &s, unsigned int from = 0) const { size_t i = _s.find(s._s, from); return (i == std::string::npos) ? -1 : (int)i; }
+    String substring(unsigned int from) const { return (from < _s.length()) ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+      if(from > to) std::swap(from, to);
+      return (from < _s.length()) ? String(_s.substr(from, to - from)) : String();
+    }
+
+    // Replaces all occurrences, left to right, like the Arduino String
+    void replace(const String &find, const String &repl){
+      if(find._s.empty()) return;
+      size_t pos = 0;
+      while((pos = _s.find(find._s, pos)) != std::string::npos){
+        _s.replace(pos, find._s.length(), repl._s);
+        pos += repl._s.length();
+      }
+    }
+    void replace(char find, char repl){ for(auto &c : _s) if(c == find) c = repl; }
+    void getBytes(unsigned char *buf, unsigned int size, unsigned int index = 0) const {
+      if(!size || !buf) return;
+      if(index >= _s.length()){ buf[0] = 0; return; }
+      unsigned int n = size - 1;
+      if(n > _s.length() - index) n = _s.length() - index;
+      strncpy((char *)buf, _s.c_str() + index, n);
+      buf[n] = 0;
+    }
+    void toCharArray(char *buf, unsigned int size, unsigned int index = 0) const { getBytes((unsigned char *)buf, size, index); }
+    long toInt() const { return atol(_s.c_str()); }
+    void toLowerCase(){ for(auto &c : _s) c = tolower((unsigned char)c); }
+    void trim(){
+      size_t a = _s.find_first_not_of(" \t\r\n");
+      size_t b = _s.find_last_not_of(" \t\r\n");
+      _s = (a == std::string::npos) ? "" : _s.substr(a, b - a + 1);
+    }
+  private:
+    std::string _s;
+};
+
+#endif
@@ -0,0 +1,46 @@
+// Benchmark support. bench() runs a piece of code over and over and prints the time, throughput and heap use per run.
+// Benchmarks are TESTs (see Check.h), so they can CHECK what they measured, such as the number of allocations.
+// With --quick (as ctest runs them) each one only runs briefly: enough to check the heap, not to compare speed.
+#ifndef Bench_h
+#define Bench_h
+
+#include <chrono>
+#include <functional>
+#include "Check.h"
+#include "HostHeap.h"
+
+typedef struct {double nsPerOp;          // Time per run
+                double mbPerSec;         // Bytes per second (bytesPerOp), 0 if not given
+                double allocsPerOp;      // Heap allocations per run
+                size_t peakBytes;        // Most heap in use at once, above what was in use before
+               } BenchResult;
+
+inline bool &benchQuick(){ static bool quick = false; return quick; }
+
+inline BenchResult bench(const char *name, size_t bytesPerOp, const std::function<void()> &fn){
+  using namespace std::chrono;
+  fn();                                  // Warm up: first use allocations, caches
+  double minNs = benchQuick() ? 2e7 : 5e8;
+  size_t base = hostHeap().inUse;
+  hostHeapReset();
+  size_t ops = 0;
+  auto start = steady_clock::now();
+  double ns = 0;
+  for(size_t batch = 1; ns < minNs; batch *= 2){
+    for(size_t i = 0; i < batch; i++) fn();
+    ops += batch;
+    ns = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+  }
+  HostHeapStats heap = hostHeap();
+  BenchResult r = {ns / ops, bytesPerOp ? (double)bytesPerOp * ops / (ns / 1e9) / 1e6 : 0,
+                   (double)heap.allocs / ops, heap.peak - base};
+  printf("  %-46s %10.1f ns %9.1f MB/s %7.2f allocs %8zu B peak\n", name, r.nsPerOp, r.mbPerSec, r.allocsPerOp, r.peakBytes);
+  return r;
+}
+
+#define BENCH_MAIN int main(int argc, char **argv){ \
+  int n = 1; \
+  for(int i = 1; i < argc; i++){ if(strcmp(argv[i], "--quick") == 0) benchQuick() = true; else argv[n++] = argv[i]; } \
+  return runTests(n, argv); }
+
+#endif
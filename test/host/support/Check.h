@@ -0,0 +1,44 @@
+// Minimal test support. TEST(name) defines a test, CHECK records a failure and carries on.
+// The executable runs all tests, or those named on the command line, and fails if any check failed.
+#ifndef Check_h
+#define Check_h
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct HostTest {const char *name; void (*fn)();};
+inline std::vector<HostTest> &hostTests(){ static std::vector<HostTest> tests; return tests; }
+inline int &hostFailures(){ static int failures = 0; return failures; }
+struct HostTestAdd { HostTestAdd(const char *name, void (*fn)()){ hostTests().push_back({name, fn}); } };
+
+#define TEST(name) static void name(); static HostTestAdd name##Add(#name, name); static void name()
+
+#define CHECK(cond) do{ if(!(cond)){ \
+  fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); hostFailures()++; } }while(0)
+
+// Integers, compared and shown as long long
+#define CHECK_EQ(a, b) do{ long long _a = (long long)(a), _b = (long long)(b); if(_a != _b){ \
+  fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); hostFailures()++; } }while(0)
+
+// Strings (char * or std::string)
+#define CHECK_STR(a, b) do{ std::string _a(a), _b(b); if(_a != _b){ \
+  fprintf(stderr, "%s:%d: CHECK_STR(%s, %s) failed:\n  \"%s\"\n  \"%s\"\n", __FILE__, __LINE__, #a, #b, _a.c_str(), _b.c_str()); \
+  hostFailures()++; } }while(0)
+
+inline int runTests(int argc, char **argv){
+  for(auto &t : hostTests()){
+    bool selected = (argc < 2);
+    for(int i = 1; i < argc; i++) if(strcmp(argv[i], t.name) == 0) selected = true;
+    if(!selected) continue;
+    int before = hostFailures();
+    t.fn();
+    printf("%-40s %s\n", t.name, (hostFailures() == before) ? "ok" : "FAILED");
+  }
+  return hostFailures() ? 1 : 0;
+}
+
+#define TEST_MAIN int main(int argc, char **argv){ return runTests(argc, argv); }
+
+#endif
@@ -0,0 +1,98 @@
+// Shared by the file manager tests and benchmarks: stand-ins for the parts of the sketch FM.ino, FMDownload.ino and
+// FSUsage.ino use, a temporary directory mounted as LittleFS, and helpers to read the pages FMsendDir sends.
+// Include after Prototypes.h and before the .ino files.
+#ifndef FMHost_h
+#define FMHost_h
+
+#include <unistd.h>
+#include <sys/time.h>
+#include <ftw.h>
+#include <string>
+#include <vector>
+
+// ---- Stand-ins for the rest of the sketch ----
+char hostname[32] = "esp32s3";
+AsyncWebServer server(80);
+bool hostStorageReady = true;
+void metricsRecord(int id, int64_t start, size_t bytes){}
+bool bootStorageReady(){ return hostStorageReady; }
+bool storageAvailable(AsyncWebServerRequest *request){ return hostStorageReady; }
+bool adminAllowed(AsyncWebServerRequest *request){ return true; }
+void staticFileChanged(int fs, const char *path){}
+const char *staticContentType(const char *path){ return "application/octet-stream"; }
+
+// ---- A temporary directory, mounted at /littlefs ----
+static int hostRemoveEntry(const char *path, const struct stat *st, int flag, struct FTW *ftw){ return ::remove(path); }
+
+struct HostDir {
+  std::string dir;
+  HostDir(){
+    char tmpl[] = "/tmp/fmhostXXXXXX";
+    dir = mkdtemp(tmpl);
+    hostMount("/littlefs", dir.c_str());
+  }
+  ~HostDir(){ nftw(dir.c_str(), hostRemoveEntry, 16, FTW_DEPTH | FTW_PHYS); }
+  // Creates a file (path within LittleFS) of size bytes, modified at mtime (seconds) if given
+  void file(const std::string &path, size_t size, time_t mtime = 0){
+    std::string full = dir + path;
+    FILE *f = fopen(full.c_str(), "wb");
+    for(size_t i = 0; i < size; i++) fputc('a' + i % 26, f);
+    fclose(f);
+    if(mtime){
+      struct timeval tv[2] = {{mtime, 0}, {mtime, 0}};
+      utimes(full.c_str(), tv);
+    }
+  }
+  void mkdir(const std::string &path){ ::mkdir((dir + path).c_str(), 0755); }
+  std::string read(const std::string &path){
+    std::string s;
+    FILE *f = fopen((dir + path).c_str(), "rb");
+    if(!f) return s;
+    int c;
+    while((c = fgetc(f)) != EOF) s += (char)c;
+    fclose(f);
+    return s;
+  }
+};
+
+// ---- Reading pages of FMsendDir ----
+// Value of the string attribute key, searched from pos. Escapes are undone. Empty if there is none
+inline std::string hostJsonString(const std::string &json, const char *key, size_t pos = 0){
+  std::string pattern = std::string("\"") + key + "\":\"";
+  size_t p = json.find(pattern, pos);
+  if(p == std::string::npos) return "";
+  std::string v;
+  for(p += pattern.size(); (p < json.size()) && (json[p] != '"'); p++){
+    if(json[p] == '\\') p++;
+    v += json[p];
+  }
+  return v;
+}
+
+typedef struct {std::vector<std::string> names;    // Entries in page order. Directories end with '/'
+                std::vector<long> sizes;            // Bytes of the files, -1 for directories
+                std::string next;
+               } HostDirPage;
+
+inline HostDirPage hostParsePage(const std::string &json){
+  HostDirPage page;
+  size_t p = json.find("\"entries\":[");
+  size_t end = json.rfind("],\"next\":");
+  if((p == std::string::npos) || (end == std::string::npos)) return page;
+  while(true){
+    size_t e = json.find('{', p);
+    if((e == std::string::npos) || (e > end)) break;
+    if(json.compare(e, 8, "{\"dir\":\"") == 0){
+      page.names.push_back(hostJsonString(json, "dir", e) + "/");
+      page.sizes.push_back(-1);
+    } else {
+      page.names.push_back(hostJsonString(json, "file", e));
+      page.sizes.push_back(atol(hostJsonString(json, "bytes", e).c_str()));
+    }
+    p = e + 1;                                    // Test names don't contain '{'
+  }
+  page.next = hostJsonString(json, "next", end);
+  return page;
+}
+
+#endif
@@ -0,0 +1,251 @@
+// Host implementation of the Arduino core and FreeRTOS stand-ins (see stubs/Arduino.h)
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include "Arduino.h"
+#include "HostHeap.h"
+
+// ------------------------- Time -------------------------
+static const auto hostStart = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time(){
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+unsigned long millis(){ return esp_timer_get_time() / 1000; }
+unsigned long micros(){ return esp_timer_get_time(); }
+void delay(uint32_t ms){ std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void yield(){ std::this_thread::yield(); }
+
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size){
+  size_t len = strlen(src);
+  if(size){
+    size_t n = (len < size - 1) ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = 0;
+  }
+  return len;
+}
+#endif
+
+// ------------------------- ESP -------------------------
+EspClass ESP;
+
+uint32_t EspClass::getCycleCount(){
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - hostStart).count();
+  return (uint32_t)(ns * 240 / 1000);
+}
+uint32_t EspClass::getFreeHeap(){ return HostHeapSize - hostHeap().inUse; }
+uint32_t EspClass::getMinFreeHeap(){ return HostHeapSize - hostHeap().peak; }
+uint32_t EspClass::getMaxAllocHeap(){ return getFreeHeap(); }
+void EspClass::restart(){
+  fprintf(stderr, "ESP.restart() called\n");
+  exit(3);
+}
+
+// ------------------------- Print and Serial -------------------------
+// As in the ESP32 core: formatted on the stack, on the heap if it is longer than 64 bytes
+size_t Print::printf(const char *format, ...){
+  char loc_buf[64];
+  char *temp = loc_buf;
+  va_list arg;
+  va_list copy;
+  va_start(arg, format);
+  va_copy(copy, arg);
+  int len = vsnprintf(temp, sizeof(loc_buf), format, copy);
+  va_end(copy);
+  if(len < 0){
+    va_end(arg);
+    return 0;
+  }
+  if(len >= (int)sizeof(loc_buf)){
+    temp = (char *)malloc(len + 1);
+    if(temp == NULL){
+      va_end(arg);
+      return 0;
+    }
+    len = vsnprintf(temp, len + 1, format, arg);
+  }
+  va_end(arg);
+  len = write((uint8_t *)temp, len);
+  if(temp != loc_buf) free(temp);
+  return len;
+}
+
+size_t Print::printNumber(unsigned long long n, int base){
+  char buf[8 * sizeof(n) + 1];
+  char *p = &buf[sizeof(buf) - 1];
+  *p = 0;
+  if(base < 2) base = 10;
+  do{
+    int d = n % base;
+    *--p = (d < 10) ? '0' + d : 'A' + d - 10;
+    n /= base;
+  } while(n);
+  return write(p);
+}
+
+size_t Print::print(double n, int digits){
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+HostSerial Serial;
+
+size_t HostSerial::write(uint8_t c){ return write(&c, 1); }
+size_t HostSerial::write(const uint8_t *buf, size_t len){
+  if(capture) capture->concat(String((const char *)buf, len));
+  else fwrite(buf, 1, len, stdout);
+  return len;
+}
+
+// ------------------------- FreeRTOS -------------------------
+void hostEnterCritical(portMUX_TYPE *mux){
+  while(__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE)) std::this_thread::yield();
+}
+void hostExitCritical(portMUX_TYPE *mux){
+  __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+// Waits on cv until ready() or ticks (milliseconds) passed. Returns ready()
+template <typename F> static bool hostWait(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TickType_t ticks, F ready){
+  if(ticks == portMAX_DELAY){
+    cv.wait(lock, ready);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+// Tasks are threads. Their objects are never freed: a task that is still waiting when the program ends must find them
+struct HostTask {
+  std::mutex m;
+  std::condition_variable cv;
+  uint32_t notify = 0;
+};
+struct HostTaskEnd {};                                 // Thrown by vTaskDelete(NULL) to end the thread
+static thread_local HostTask *hostCurrent = NULL;
+
+static HostTask *hostSelf(){
+  if(hostCurrent == NULL) hostCurrent = new HostTask;  // The main thread, or any other thread not created as a task
+  return hostCurrent;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle){
+  HostTask *t = new HostTask;
+  if(handle) *handle = t;
+  std::thread([t, fn, param](){
+    hostCurrent = t;
+    try{
+      fn(param);
+    } catch(HostTaskEnd &){
+    }
+  }).detach();
+  return pdPASS;
+}
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle, BaseType_t core){
+  return xTaskCreate(fn, name, stack, param, prio, handle);
+}
+void vTaskDelete(TaskHandle_t task){
+  if(task == NULL) throw HostTaskEnd();
+  fprintf(stderr, "vTaskDelete of another task is not supported on the host\n");
+  abort();
+}
+void vTaskDelay(TickType_t ticks){ delay(ticks); }
+TickType_t xTaskGetTickCount(){ return millis(); }
+
+void xTaskNotifyGive(TaskHandle_t task){
+  if(task == NULL) return;
+  std::lock_guard<std::mutex> lock(task->m);
+  task->notify++;
+  task->cv.notify_all();
+}
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks){
+  HostTask *t = hostSelf();
+  std::unique_lock<std::mutex> lock(t->m);
+  hostWait(lock, t->cv, ticks, [t]{ return t->notify > 0; });
+  uint32_t n = t->notify;
+  if(n) t->notify = clear ? 0 : n - 1;
+  return n;
+}
+
+// Queues hold length items of itemSize bytes. Semaphores are queues of items without bytes
+struct HostQueue {
+  std::mutex m;
+  std::condition_variable cv;
+  size_t length;
+  size_t itemSize;
+  std::vector<uint8_t> items;
+  size_t head = 0;
+  size_t count = 0;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize){
+  HostQueue *q = new HostQueue;
+  q->length = length;
+  q->itemSize = itemSize;
+  q->items.resize(length * itemSize);
+  return q;
+}
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks){
+  std::unique_lock<std::mutex> lock(q->m);
+  if(!hostWait(lock, q->cv, ticks, [q]{ return q->count < q->length; })) return pdFALSE;
+  if(q->itemSize) memcpy(&q->items[((q->head + q->count) % q->length) * q->itemSize], item, q->itemSize);
+  q->count++;
+  q->cv.notify_all();
+  return pdTRUE;
+}
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks){
+  std::unique_lock<std::mutex> lock(q->m);
+  if(!hostWait(lock, q->cv, ticks, [q]{ return q->count > 0; })) return pdFALSE;
+  if(q->itemSize) memcpy(item, &q->items[q->head * q->itemSize], q->itemSize);
+  q->head = (q->head + 1) % q->length;
+  q->count--;
+  q->cv.notify_all();
+  return pdTRUE;
+}
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q){
+  std::lock_guard<std::mutex> lock(q->m);
+  return q->count;
+}
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial){
+  HostQueue *s = xQueueCreate(max, 0);
+  s->count = initial;
+  return s;
+}
+SemaphoreHandle_t xSemaphoreCreateMutex(){ return xSemaphoreCreateCounting(1, 1); }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks){ return xQueueReceive(s, NULL, ticks); }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s){ return xQueueSend(s, NULL, 0); }
+
+struct HostEvents {
+  std::mutex m;
+  std::condition_variable cv;
+  EventBits_t bits = 0;
+};
+
+EventGroupHandle_t xEventGroupCreate(){ return new HostEvents; }
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g){
+  std::lock_guard<std::mutex> lock(g->m);
+  return g->bits;
+}
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits){
+  std::lock_guard<std::mutex> lock(g->m);
+  g->bits |= bits;
+  g->cv.notify_all();
+  return g->bits;
+}
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits){
+  std::lock_guard<std::mutex> lock(g->m);
+  EventBits_t before = g->bits;
+  g->bits &= ~bits;
+  return before;
+}
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks){
+  std::unique_lock<std::mutex> lock(g->m);
+  hostWait(lock, g->cv, ticks, [g, bits, all]{ return all ? ((g->bits & bits) == bits) : ((g->bits & bits) != 0); });
+  EventBits_t result = g->bits;
+  if(clear) g->bits &= ~bits;
+  return result;
+}
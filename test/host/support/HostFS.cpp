@@ -0,0 +1,162 @@
+// Host implementation of FS, File and LittleFS (see stubs/FS.h), on POSIX files and directories
+#include <ftw.h>
+#include <unistd.h>
+#include <vector>
+#include <string>
+#include <Arduino.h>
+#include "FS.h"
+#include "LittleFS.h"
+#undef opendir
+#undef stat
+
+volatile uint32_t hostWriteDelayMs = 0;
+uint32_t hostStatCalls = 0;
+
+// ------------------------- Mount points -------------------------
+static std::vector<std::pair<std::string, std::string>> &hostMounts(){
+  static std::vector<std::pair<std::string, std::string>> mounts;
+  return mounts;
+}
+
+void hostMount(const char *mount, const char *dir){
+  for(auto &m : hostMounts())
+    if(m.first == mount){
+      m.second = dir;
+      return;
+    }
+  hostMounts().push_back({mount, dir});
+}
+
+std::string hostPath(const char *path){
+  for(auto &m : hostMounts()){
+    size_t len = m.first.size();
+    if((strncmp(path, m.first.c_str(), len) == 0) && ((path[len] == 0) || (path[len] == '/')))
+      return m.second + (path + len);
+  }
+  return path;
+}
+
+DIR *hostOpendir(const char *path){ return opendir(hostPath(path).c_str()); }
+int hostStat(const char *path, struct stat *st){
+  hostStatCalls++;
+  return stat(hostPath(path).c_str(), st);
+}
+
+// ------------------------- File -------------------------
+namespace fs {
+
+struct FileImpl {
+  std::string path;                                  // Virtual path, within the file system
+  std::string host;                                  // Path on the host
+  std::string mount;
+  FILE *f = NULL;
+  DIR *d = NULL;
+  ~FileImpl(){
+    if(f) fclose(f);
+    if(d) closedir(d);
+  }
+};
+
+static std::shared_ptr<FileImpl> openImpl(const std::string &mount, const char *path, const char *mode){
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = path;
+  impl->mount = mount;
+  impl->host = hostPath((mount + path).c_str());
+  struct stat st;
+  if((stat(impl->host.c_str(), &st) == 0) && S_ISDIR(st.st_mode)){
+    impl->d = opendir(impl->host.c_str());
+  } else {
+    std::string m = mode;
+    if(m.find('b') == std::string::npos) m += 'b';
+    impl->f = fopen(impl->host.c_str(), m.c_str());
+  }
+  if(!impl->f && !impl->d) return nullptr;
+  return impl;
+}
+
+size_t File::write(uint8_t c){ return write(&c, 1); }
+size_t File::write(const uint8_t *buf, size_t size){
+  if(hostWriteDelayMs) delay(hostWriteDelayMs);
+  return (_impl && _impl->f) ? fwrite(buf, 1, size, _impl->f) : 0;
+}
+int File::available(){ return (_impl && _impl->f) ? (int)(size() - position()) : 0; }
+int File::read(){
+  uint8_t c;
+  return (read(&c, 1) == 1) ? c : -1;
+}
+int File::peek(){
+  if(!(_impl && _impl->f)) return -1;
+  int c = fgetc(_impl->f);
+  if(c != EOF) ungetc(c, _impl->f);
+  return (c == EOF) ? -1 : c;
+}
+void File::flush(){ if(_impl && _impl->f) fflush(_impl->f); }
+size_t File::read(uint8_t *buf, size_t size){ return (_impl && _impl->f) ? fread(buf, 1, size, _impl->f) : 0; }
+bool File::seek(uint32_t pos, SeekMode mode){
+  return _impl && _impl->f && (fseek(_impl->f, pos, (mode == SeekSet) ? SEEK_SET : (mode == SeekCur) ? SEEK_CUR : SEEK_END) == 0);
+}
+size_t File::position() const { return (_impl && _impl->f) ? ftell(_impl->f) : 0; }
+size_t File::size() const {
+  if(!(_impl && _impl->f)) return 0;
+  fflush(_impl->f);
+  struct stat st;
+  return (fstat(fileno(_impl->f), &st) == 0) ? st.st_size : 0;
+}
+void File::close(){ _impl.reset(); }
+File::operator bool() const { return _impl != nullptr; }
+time_t File::getLastWrite(){
+  struct stat st;
+  return (_impl && (stat(_impl->host.c_str(), &st) == 0)) ? st.st_mtime : 0;
+}
+const char *File::path() const { return _impl ? _impl->path.c_str() : NULL; }
+const char *File::name() const {
+  if(!_impl) return NULL;
+  const char *slash = strrchr(_impl->path.c_str(), '/');
+  return slash ? slash + 1 : _impl->path.c_str();
+}
+bool File::isDirectory() const { return _impl && _impl->d; }
+File File::openNextFile(const char *mode){
+  if(!(_impl && _impl->d)) return File();
+  struct dirent *e;
+  while((e = readdir(_impl->d)) != NULL){
+    if((strcmp(e->d_name, ".") == 0) || (strcmp(e->d_name, "..") == 0)) continue;
+    std::string child = _impl->path + ((_impl->path.back() == '/') ? "" : "/") + e->d_name;
+    return File(openImpl(_impl->mount, child.c_str(), mode));
+  }
+  return File();
+}
+void File::rewindDirectory(){ if(_impl && _impl->d) rewinddir(_impl->d); }
+
+// ------------------------- FS -------------------------
+File FS::open(const char *path, const char *mode, bool create){ return File(openImpl(_mount, path, mode)); }
+bool FS::exists(const char *path){
+  struct stat st;
+  return stat(hostPath((std::string(_mount) + path).c_str()).c_str(), &st) == 0;
+}
+bool FS::remove(const char *path){ return unlink(hostPath((std::string(_mount) + path).c_str()).c_str()) == 0; }
+bool FS::rename(const char *from, const char *to){
+  return ::rename(hostPath((std::string(_mount) + from).c_str()).c_str(), hostPath((std::string(_mount) + to).c_str()).c_str()) == 0;
+}
+bool FS::mkdir(const char *path){ return ::mkdir(hostPath((std::string(_mount) + path).c_str()).c_str(), 0755) == 0; }
+bool FS::rmdir(const char *path){ return ::rmdir(hostPath((std::string(_mount) + path).c_str()).c_str()) == 0; }
+
+}
+
+// ------------------------- LittleFS -------------------------
+LittleFSFS LittleFS;
+size_t hostTotalBytes = 4 * 1024 * 1024;
+void (*hostWhileUsedBytes)() = NULL;
+
+static size_t hostUsed;
+static int hostAddSize(const char *path, const struct stat *st, int flag, struct FTW *ftw){
+  if(flag == FTW_F) hostUsed += st->st_size;
+  return 0;
+}
+
+size_t LittleFSFS::totalBytes(){ return hostTotalBytes; }
+size_t LittleFSFS::usedBytes(){
+  hostUsed = 0;
+  nftw(hostPath(_mount).c_str(), hostAddSize, 16, FTW_PHYS);
+  if(hostWhileUsedBytes) hostWhileUsedBytes();
+  return hostUsed;
+}
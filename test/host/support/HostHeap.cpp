@@ -0,0 +1,78 @@
+// Counting allocator (see HostHeap.h). Replaces the malloc family of glibc, which the C++ runtime uses as well
+#include <malloc.h>
+#include <errno.h>
+#include "HostHeap.h"
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void *__libc_memalign(size_t align, size_t size);
+void __libc_free(void *p);
+}
+
+static size_t heapAllocs = 0;
+static size_t heapFrees = 0;
+static size_t heapAllocated = 0;
+static size_t heapInUse = 0;
+static size_t heapPeak = 0;
+
+static void *counted(void *p){
+  if(p == NULL) return p;
+  size_t size = malloc_usable_size(p);
+  __atomic_fetch_add(&heapAllocs, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&heapAllocated, size, __ATOMIC_RELAXED);
+  size_t now = __atomic_add_fetch(&heapInUse, size, __ATOMIC_RELAXED);
+  size_t peak = __atomic_load_n(&heapPeak, __ATOMIC_RELAXED);
+  while((now > peak) && !__atomic_compare_exchange_n(&heapPeak, &peak, now, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  return p;
+}
+
+static void uncounted(void *p){
+  if(p == NULL) return;
+  __atomic_fetch_add(&heapFrees, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_sub(&heapInUse, malloc_usable_size(p), __ATOMIC_RELAXED);
+}
+
+extern "C" {
+void *malloc(size_t size){ return counted(__libc_malloc(size)); }
+void *calloc(size_t n, size_t size){ return counted(__libc_calloc(n, size)); }
+void free(void *p){
+  uncounted(p);
+  __libc_free(p);
+}
+void *realloc(void *p, size_t size){
+  if(p == NULL) return malloc(size);
+  if(size == 0){
+    free(p);
+    return NULL;
+  }
+  size_t before = malloc_usable_size(p);
+  void *q = __libc_realloc(p, size);
+  if(q == NULL) return NULL;
+  __atomic_fetch_add(&heapFrees, 1, __ATOMIC_RELAXED);  // Counted as a free and a new allocation
+  __atomic_fetch_sub(&heapInUse, before, __ATOMIC_RELAXED);
+  return counted(q);
+}
+void *memalign(size_t align, size_t size){ return counted(__libc_memalign(align, size)); }
+void *aligned_alloc(size_t align, size_t size){ return memalign(align, size); }
+int posix_memalign(void **out, size_t align, size_t size){
+  void *p = memalign(align, size);
+  if(p == NULL) return ENOMEM;
+  *out = p;
+  return 0;
+}
+}
+
+HostHeapStats hostHeap(){
+  return {__atomic_load_n(&heapAllocs, __ATOMIC_RELAXED), __atomic_load_n(&heapFrees, __ATOMIC_RELAXED),
+          __atomic_load_n(&heapAllocated, __ATOMIC_RELAXED), __atomic_load_n(&heapInUse, __ATOMIC_RELAXED),
+          __atomic_load_n(&heapPeak, __ATOMIC_RELAXED)};
+}
+
+void hostHeapReset(){
+  __atomic_store_n(&heapAllocs, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&heapFrees, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&heapAllocated, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&heapPeak, __atomic_load_n(&heapInUse, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
@@ -0,0 +1,20 @@
+// Counting allocator. malloc, free and friends (and with them new and delete) are counted for the whole program,
+// so tests can check how much heap a piece of code takes and benchmarks can report it.
+#ifndef HostHeap_h
+#define HostHeap_h
+
+#include <stddef.h>
+
+#define HostHeapSize (320 * 1024)        // What ESP.getFreeHeap() is computed from: about the internal heap of an ESP32-S3
+
+typedef struct {size_t allocs;           // Allocations since hostHeapReset
+                size_t frees;            // Frees since hostHeapReset
+                size_t allocated;        // Bytes allocated since hostHeapReset
+                size_t inUse;            // Bytes in use now
+                size_t peak;             // Most bytes in use at once since hostHeapReset
+               } HostHeapStats;
+
+HostHeapStats hostHeap();
+void hostHeapReset();                   // Starts counting anew. The peak starts at what is in use now
+
+#endif
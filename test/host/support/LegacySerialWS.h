@@ -0,0 +1,108 @@
+// SerialWS as it was before the rings were rewritten (byte by byte copies, a copy of the ring on the stack for every
+// frame, textAll copying the frame for each client), renamed to LegacySerialWS. It is served on a websocket of its own.
+// The SerialWS benchmark compares the new version with it. Don't change it.
+#ifndef LegacySerialWS_h
+#define LegacySerialWS_h
+
+#include <ESPAsyncWebServer.h>
+
+static AsyncWebSocket legacyWs("/LegacySerialWS");
+static size_t legacyRxBufferSize;
+static unsigned char *legacyRxBuffer;
+static volatile size_t legacyRxHead;
+static volatile size_t legacyRxTail;
+
+class LegacySerialWS : public Stream {
+  public:
+    void begin(AsyncWebServer *server, uint16_t TxBufferSize = 256, uint16_t RxBufferSize = 256){
+      legacyRxBufferSize = RxBufferSize;
+      _txBufferSize = TxBufferSize;
+      legacyRxHead = 0;
+      legacyRxTail = 0;
+      _tx_buffer_head = 0;
+      _tx_buffer_tail = 0;
+      if(legacyRxBufferSize > 0) legacyRxBuffer = (unsigned char *)malloc(legacyRxBufferSize);
+      if(_txBufferSize > 0) _tx_buffer = (unsigned char *)malloc(_txBufferSize);
+      _server = server;
+      legacyWs.onEvent(onSerialWsEvent);
+      _server->addHandler(&legacyWs);
+    }
+    void end(){
+      _server->removeHandler(&legacyWs);
+      if(legacyRxBufferSize > 0) free(legacyRxBuffer);
+      if(_txBufferSize > 0) free(_tx_buffer);
+      _txBufferSize = 0;
+      legacyRxBufferSize = 0;
+    }
+    int available() override {
+      return legacyRxBufferSize ? (unsigned int)(legacyRxBufferSize + legacyRxHead - legacyRxTail) % legacyRxBufferSize : 0;
+    }
+    int peek() override {
+      if((legacyRxBufferSize > 0) && !(legacyRxHead == legacyRxTail)) return (int)legacyRxBuffer[legacyRxTail];
+      return -1;
+    }
+    int read() override {
+      int retVal = peek();
+      if(retVal >= 0) legacyRxTail = (legacyRxTail + 1) % legacyRxBufferSize;
+      return retVal;
+    }
+    int read(uint8_t *buffer, int size){
+      int cnt;
+      for(cnt = 0; cnt < size; cnt++){
+        int c = read();
+        if(c >= 0) buffer[cnt] = (uint8_t)c;
+        else break;
+      }
+      return cnt;
+    }
+    int read(char *buffer, int size){ return read((uint8_t *)buffer, size); }
+    void send(){
+      if(!(_tx_buffer_head == _tx_buffer_tail)){
+        char tmpBuff[_txBufferSize];                    // New buffer (because the ring buffer is not necessarily ordered)
+        int i = 0;
+        while(!(_tx_buffer_head == _tx_buffer_tail)){
+          tmpBuff[i] = _tx_buffer[_tx_buffer_tail];
+          _tx_buffer_tail = (_tx_buffer_tail + 1) % _txBufferSize;
+          i++;
+        }
+        legacyWs.textAll(tmpBuff, i);
+        _tx_buffer_head = 0;
+        _tx_buffer_tail = 0;
+      }
+    }
+    size_t write(uint8_t b) override {
+      checkBuffer();
+      _tx_buffer[_tx_buffer_head] = b;
+      _tx_buffer_head = (_tx_buffer_head + 1) % _txBufferSize;
+      return 1;
+    }
+    size_t write(uint8_t *buffer, size_t size){
+      for(size_t i = 0; i < size; i++){
+        checkBuffer();
+        _tx_buffer[_tx_buffer_head] = buffer[i];
+        _tx_buffer_head = (_tx_buffer_head + 1) % _txBufferSize;
+      }
+      return size;
+    }
+    size_t write(const char *s){ return write((uint8_t *)s, strlen(s)); }
+  private:
+    void checkBuffer(){
+      if((_tx_buffer_head + 1) % _txBufferSize == _tx_buffer_tail) send();   // Full
+    }
+    static void onSerialWsEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len){
+      if((type != WS_EVT_DATA) || (legacyRxBufferSize == 0)) return;
+      for(size_t i = 0; i < len; i++){
+        size_t index = (legacyRxHead + 1) % legacyRxBufferSize;
+        if(index == legacyRxTail) break;                // Full: the rest is dropped
+        legacyRxBuffer[legacyRxHead] = data[i];
+        legacyRxHead = index;
+      }
+    }
+    AsyncWebServer *_server;
+    size_t _txBufferSize;
+    volatile size_t _tx_buffer_head;
+    volatile size_t _tx_buffer_tail;
+    unsigned char *_tx_buffer;
+};
+
+#endif
@@ -0,0 +1,257 @@
+// Websocket requests as onWsEvent and customWS_EVT handled them before the dispatch table: strstr for "request",
+// a JsonDocument deserialized from the message, then a strcmp chain through the core requests; a message nobody
+// handled was deserialized again by customWS_EVT for its own strcmp chain. Text messages went through getOperand and
+// their own chain. The websocket dispatch benchmark compares wsDispatch with it. Don't change it.
+// Include after WSHost.h.
+#ifndef LegacyWSDispatch_h
+#define LegacyWSDispatch_h
+
+#include <stdlib.h>
+#include <string.h>
+
+// ---- Stand-in for ArduinoJson 7, which the host build doesn't have. It costs what a JsonDocument costs for these flat
+// messages: a pool of variant slots from the heap on the first member, one heap copy for every key and string value,
+// a linear search by key, and everything freed again when the document goes ----
+class LegacyJsonDocument {
+  public:
+    struct Variant {
+      const char *str;
+      long num;
+      operator const char*() const { return str; }
+      operator unsigned int() const { return (unsigned int)num; }
+    };
+    ~LegacyJsonDocument(){
+      for(int i = 0; i < _count; i++){
+        free(_slots[i].key);
+        free((char*)_slots[i].value.str);
+      }
+      free(_slots);
+    }
+    Variant operator[](const char *key) const {
+      for(int i = 0; i < _count; i++)
+        if(strcmp(_slots[i].key, key) == 0) return _slots[i].value;
+      return {NULL, 0};
+    }
+    bool add(char *key, const char *str, long num){
+      if(!_slots) _slots = (Slot*)malloc(PoolSlots * sizeof(Slot));
+      if(!_slots || _count == PoolSlots) return false;
+      _slots[_count++] = {key, {str, num}};
+      return true;
+    }
+  private:
+    static const int PoolSlots = 64;
+    struct Slot {char *key; Variant value;};
+    Slot *_slots = NULL;
+    int _count = 0;
+};
+
+static char *legacyJsonString(const char *&p){
+  const char *start = ++p;
+  while(*p && *p != '"') p += (*p == '\\' && p[1]) ? 2 : 1;
+  if(*p != '"') return NULL;
+  char *s = (char*)malloc(p - start + 1);
+  memcpy(s, start, p - start);
+  s[p - start] = 0;
+  p++;
+  return s;
+}
+
+// Flat objects of strings and numbers, which is all the requests use. Returns true on an error, like
+// DeserializationError does
+static bool legacyDeserializeJson(LegacyJsonDocument &doc, const uint8_t *data){
+  const char *p = (const char*)data;
+  while(isspace(*p)) p++;
+  if(*p++ != '{') return true;
+  while(true){
+    while(isspace(*p)) p++;
+    if(*p == '}') return false;
+    if(*p != '"') return true;
+    char *key = legacyJsonString(p);
+    while(isspace(*p)) p++;
+    if(!key || *p++ != ':'){ free(key); return true; }
+    while(isspace(*p)) p++;
+    char *str = NULL;
+    long num = 0;
+    if(*p == '"'){
+      if(!(str = legacyJsonString(p))){ free(key); return true; }
+    } else {
+      char *end;
+      num = strtol(p, &end, 10);
+      if(end == p){ free(key); return true; }
+      p = end;
+    }
+    if(!doc.add(key, str, num)){ free(key); free(str); return true; }
+    while(isspace(*p)) p++;
+    if(*p == ',') p++;
+    else if(*p != '}') return true;
+  }
+}
+
+// ---- customWS_EVT with a strcmp chain through the custom requests, as a sketch had to write it ----
+static const char **legacyCustomNames;
+static int legacyNumCustom;
+
+static void legacyCustomWS_EVT(AsyncWebSocketClient *client, uint8_t *data, size_t len){
+  char operand[25];
+  bool JSON = data[0]=='{';
+  if(JSON){
+    char* reqAddr = strstr((char*)data,"request");
+    if((reqAddr != NULL) && (reqAddr - (char*)data < 10)){
+      LegacyJsonDocument doc;
+      bool Jerror = legacyDeserializeJson(doc, data);
+      if(!Jerror){
+        const char* request = doc["request"];
+        for(int i = 0; i < legacyNumCustom; i++){
+          if(strcmp(request, legacyCustomNames[i]) == 0){
+            const char *value = doc["value"];
+            client->text(value ? value : "");
+            break;
+          }
+        }
+      }
+    }
+  } else {
+    getOperand(operand, (char*)data, sizeof(operand));
+  }
+}
+
+// ---- onWsEvent's WS_TEXT path. FMgetDir answered through FMgetDir(filesys,dir), which is FMsendDir now ----
+static void legacyOnWsEvent(AsyncWebSocketClient *client, uint8_t *data, size_t len){
+  bool handled = false;
+  char operand[25];
+  bool JSON = data[0]=='{';
+
+  if(JSON){
+    char* reqAddr = strstr((char*)data,"request");
+    if((reqAddr != NULL) && (reqAddr - (char*)data < 10)){
+      LegacyJsonDocument doc;
+      bool Jerror = legacyDeserializeJson(doc, data);
+
+      if(Jerror){
+        char buff[1000];
+        snprintf(buff, 1000, "deserializeJson() failed:\n%s\n%s\n","InvalidInput",(char*)data);
+        serialPrint(buff,true);
+      } else {
+        const char* request = doc["request"];
+        if(strcmp(request,"getDateTime") == 0){
+          char rsvp[400];
+          getDateTimeSettings(rsvp,true);
+          client->text(rsvp);
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMgetBasic") == 0){
+          char rsvp[400] = "";
+          if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+            FMgetBasic(rsvp);
+            client->text(rsvp);
+          }
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMgetFS") == 0){
+          const char* filesys = doc["filesys"];
+          char rsvp[400] = "";
+          if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+            FMgetFS(rsvp,filesys);
+          }
+          client->text(rsvp);
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMgetDir") == 0){
+          if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+            const char* filesys = doc["filesys"];
+            const char* dir = doc["dir"];
+            FMsendDir(client, filesys, dir, "name", false, "");
+          }
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMmkDir") == 0){
+          if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+            const char* filesys = doc["filesys"];
+            const char* dir = doc["dir"];
+            const char* dname = doc["dname"];
+            int fsNum = getFMfsNum((char*)filesys);
+            FMmkDir(fsNum, dir, dname);
+            FMsendDir(client, filesys, dir, "name", false, "");
+          }
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMdelete") == 0){
+          if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+            const char* filesys = doc["filesys"];
+            const char* dir = doc["dir"];
+            const char* fname = doc["fname"];
+            int fsNum = getFMfsNum((char*)filesys);
+            char fullPath[256];
+            if((fsNum>=0)&&dir&&fname&&*dir&&*fname){
+              sprintf(fullPath,"%s%s%s",dir,dir[strlen(dir)-1]=='/' ? "" : "/", fname);
+              FMdelete(fsNum,fullPath);
+              FMsendDir(client, filesys, dir, "name", false, "");
+            }
+          }
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMuploadBegin") == 0){
+          const char *path = doc["path"];
+          const unsigned int siz = doc["size"];
+          createUpload((char*)path, (unsigned int)siz);
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMuploadEnd") == 0){
+          const char *path = doc["path"];
+          deleteUpload((char*)path);
+          handled = true;
+        }
+        if((!handled) && strcmp(request,"FMuploadStatus") == 0){
+          const char *path = doc["path"];
+          char stat[100];
+          statusUpload((char*)path, stat);
+          client->text(stat);
+          handled = true;
+        }
+      }
+    }
+  } else {
+    getOperand(operand, (char*)data, sizeof(operand));
+    if(strcmp(operand,"getHostSettings") == 0){
+      char rsvp[1000] = "";
+      if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+        getHostSettings(rsvp);
+        client->text(rsvp);
+      }
+      handled = true;
+    }
+    if((!handled) && strcmp(operand,"setHostSettings") == 0){
+      char rsvp[200] = "";
+      if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+        setHostSettings((char*)data,rsvp);
+        strcat(rsvp,"\nConfiguration changes ignored");
+        client->text(rsvp);
+      }
+      handled = true;
+    }
+    if((!handled) && strcmp(operand,"getDateTime") == 0){
+      char rsvp[500];
+      getDateTimeSettings(rsvp,false);
+      client->text(rsvp);
+      handled = true;
+    }
+    if((!handled) && strcmp(operand,"setDateTime") == 0){
+      char rsvp[200] = "";
+      if((!onlyLocalAdmin) || isLocal(client->remoteIP())){
+        if(setDateTimeSettings((char*)data,rsvp)){
+          sprintf(rsvp,"Message2\nDate and Time configuration changed.");
+          client->text(rsvp);
+        }else{
+          strcat(rsvp,"\nDate and Time changes ignored");
+          client->text(rsvp);
+        }
+      }
+      handled = true;
+    }
+  }
+  if(!handled){
+    legacyCustomWS_EVT(client, data, len);
+  }
+}
+
+#endif
@@ -0,0 +1,22 @@
+// What the sketch sees before its own code, as in ESP32S3WebserverProject.ino: the core (stand-ins from stubs/),
+// the sketch headers and the libraries. Include first in every host test, then Prototypes.h, then the stand-ins for
+// other parts of the sketch the test needs, then the .ino files under test.
+#ifndef Sketch_h
+#define Sketch_h
+
+#include <Arduino.h>
+#include "WebServerDefines.h"
+#include "customize.h"
+#include "Metrics.h"
+#include "HTMLUtil.h"
+#include "Log.h"
+#include <Preferences.h>
+#include <ESPAsyncWebServer.h>
+#if UseLittleFS
+  #include <LittleFS.h>
+#endif
+#if useSerialWS
+  #include <SerialWS.h>
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+// Shared by the websocket dispatch tests and benchmarks: stand-ins for the handlers WSDispatch.ino calls.
+// Include after Prototypes.h and before WSDispatch.ino.
+#ifndef WSHost_h
+#define WSHost_h
+
+#include <string>
+#include <vector>
+
+// ---- Stand-ins for the rest of the sketch. Those that change something note their call in hostCalls ----
+static std::string hostCalls;
+static void hostCall(const char *what){ hostCalls += hostCalls.empty() ? what : std::string(",") + what; }
+
+SerialWS serialWS;
+bool hostStorageReady = true;
+bool bootStorageReady(){ return hostStorageReady; }
+bool isLocal(IPAddress clientIP){ return clientIP[0] == 192; }
+void serialPrint(char buff[], bool immediate){}
+void getDateTimeSettings(char rsvp[], bool json){ strcpy(rsvp, json ? "{\"answer\":\"setDateTime\"}" : "setDateTime"); }
+void getHostSettings(char rsvp[]){ strcpy(rsvp, "setHostSettings"); }
+bool setHostSettings(char *params, char msg[]){ strcpy(msg, "Error"); return false; }
+bool setDateTimeSettings(char *params, char msg[]){ hostCall("setDateTimeSettings"); return true; }
+void FMgetBasic(char rsvp[]){ strcpy(rsvp, "basic"); }
+void FMgetFS(char rsvp[], const char *filesys){ sprintf(rsvp, "fs %s", filesys); }
+int getFMfsNum(char filesys[]){ return strcmp(filesys, "LittleFS") == 0 ? 0 : -1; }
+void FMsendDir(AsyncWebSocketClient *client, const char *filesys, const char *dir, const char *sort, bool desc, const char *cursor){
+  char rsvp[600];
+  sprintf(rsvp, "dir %s|%s|%s|%d|%s", filesys, dir, sort, desc, cursor);
+  client->text(rsvp);
+}
+void FMmkDir(int fsNum, const char *path, const char *newDir){ hostCall("FMmkDir"); }
+void FMdelete(int fsNum, char fullPath[]){ hostCall(fullPath); }
+int createUpload(char path[], unsigned long sz){ hostCall("createUpload"); return 0; }
+void deleteUpload(char path[]){ hostCall("deleteUpload"); }
+void statusUpload(char path[], char stat[]){ sprintf(stat, "status %s", path); }
+void wsGetMetrics(AsyncWebSocketClient *client, WSRequest &req){ client->text("metrics"); }
+
+// Metrics: an id is the index of "kind:name" in hostMetricNames. hostMetricLast is the id measured last
+static std::vector<std::string> hostMetricNames;
+static int hostMetricLast = -1;
+int metricsRegister(const char *name, const char *kind){
+  hostMetricNames.push_back(std::string(kind) + ":" + name);
+  return (int)hostMetricNames.size() - 1;
+}
+void metricsRecord(int id, int64_t start, size_t bytes){ hostMetricLast = id; }
+
+#endif
@@ -0,0 +1,447 @@
+// File manager: directory listings in pages (FMsendDir), downloads with ranges (FMDownload.ino), the upload pipeline
+// and the file system usage cache (FSUsage.ino), on a temporary directory mounted as LittleFS
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "FMHost.h"
+#include "Check.h"
+#include <set>
+#include <algorithm>
+
+#include "FSUsage.ino"
+#include "FM.ino"
+#include "FMDownload.ino"
+
+static AsyncWebSocket ws("/ws");
+
+// Requests all pages of a listing, the way fileman.htm does. Checks the page limits on the way
+static std::vector<std::string> listAll(const char *dir, const char *sort, bool desc, std::vector<long> *sizes = NULL){
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  std::vector<std::string> all;
+  std::string cursor;
+  for(int pages = 0; pages < 1000; pages++){
+    size_t before = c->frames.size();
+    FMsendDir(c, "LittleFS", dir, sort, desc, cursor.c_str());
+    CHECK_EQ(c->frames.size(), before + 1);
+    if(c->frames.size() == before) break;
+    const std::string &json = c->lastText();
+    CHECK(json.size() <= FMdirChunk);
+    CHECK_STR(hostJsonString(json, "dir"), dir);
+    CHECK_STR(hostJsonString(json, "sort"), sort);     // Lets the page tell replies to an earlier request
+    CHECK_STR(json.substr(json.find("\"first\":"), 12), cursor.empty() ? "\"first\":true" : "\"first\":fals");
+    HostDirPage page = hostParsePage(json);
+    CHECK(page.names.size() <= FMdirPageSize);
+    all.insert(all.end(), page.names.begin(), page.names.end());
+    if(sizes) sizes->insert(sizes->end(), page.sizes.begin(), page.sizes.end());
+    if(page.next.empty()) break;
+    CHECK(!page.names.empty());
+    cursor = page.next;
+  }
+  ws.hostDisconnect(1);
+  return all;
+}
+
+static std::string name(int i){
+  char buff[32];
+  sprintf(buff, "file%03d.txt", i);
+  return buff;
+}
+
+// ---- Listings ----
+TEST(dirOrderPages){
+  HostDir d;
+  std::set<std::string> expected;
+  for(int i = 0; i < 100; i++){
+    d.file("/" + name(i), i);
+    expected.insert(name(i));
+  }
+  d.mkdir("/sub");
+  expected.insert("sub/");
+  std::vector<std::string> all = listAll("/", "", false);
+  CHECK_EQ(all.size(), expected.size());
+  CHECK(std::set<std::string>(all.begin(), all.end()) == expected);   // Every entry exactly once
+}
+
+TEST(dirChunkLimit){
+  HostDir d;
+  std::set<std::string> expected;
+  for(int i = 0; i < 60; i++){                         // Long names: the chunk fills before the page does
+    std::string n = std::string(200, 'n') + name(i);
+    d.file("/" + n, 1);
+    expected.insert(n);
+  }
+  for(const char *sort : {"", "name"}){
+    std::vector<std::string> all = listAll("/", sort, false);
+    CHECK_EQ(all.size(), expected.size());
+    CHECK(std::set<std::string>(all.begin(), all.end()) == expected);
+  }
+}
+
+TEST(sortedByName){
+  HostDir d;
+  std::vector<std::string> expected;
+  for(int i = 0; i < 75; i++){
+    std::string n = std::string(i % 2 ? "B" : "a") + name(74 - i);   // Mixed case: sorted without regard to case
+    d.file("/" + n, 10);
+    expected.push_back(n);
+  }
+  std::sort(expected.begin(), expected.end(), [](const std::string &a, const std::string &b){ return strcasecmp(a.c_str(), b.c_str()) < 0; });
+  std::vector<std::string> all = listAll("/", "name", false);
+  CHECK(all == expected);
+  std::reverse(expected.begin(), expected.end());
+  all = listAll("/", "name", true);
+  CHECK(all == expected);
+}
+
+TEST(sortedBySizeAndDate){
+  HostDir d;
+  for(int i = 0; i < 40; i++) d.file("/" + name(i), (i * 37) % 40 * 10, 1600000000 + (i * 13) % 40);
+  std::vector<long> sizes;
+  std::vector<std::string> all = listAll("/", "size", false, &sizes);
+  CHECK_EQ(all.size(), 40);
+  CHECK(std::is_sorted(sizes.begin(), sizes.end()));
+  sizes.clear();
+  listAll("/", "size", true, &sizes);
+  CHECK(std::is_sorted(sizes.rbegin(), sizes.rend()));
+  all = listAll("/", "date", false);
+  CHECK_EQ(all.size(), 40);
+  for(size_t i = 0; i < all.size(); i++){             // File f is (f * 13) % 40 seconds late, so the i-th oldest is
+    int expectedFile = (int)((i * 37) % 40);           // file (i * 37) % 40, as 13 * 37 = 1 (mod 40)
+    CHECK_STR(all[i], name(expectedFile));
+  }
+}
+
+TEST(sortedEqualKeys){
+  HostDir d;
+  for(int i = 0; i < 70; i++) d.file("/" + name(i), 5); // Same size: the name decides, across pages
+  std::vector<std::string> all = listAll("/", "size", false);
+  CHECK_EQ(all.size(), 70);
+  for(int i = 0; i < (int)all.size(); i++) CHECK_STR(all[i], name(i));
+}
+
+TEST(sortedNamesDifferingInCase){
+  HostDir d;
+  std::vector<std::string> expected;
+  for(int i = 0; i < 40; i++){                         // Pairs such as FILE005.TXT and file005.txt, across pages
+    std::string n = name(i);
+    std::string upper = n;
+    for(auto &ch : upper) ch = toupper(ch);
+    d.file("/" + n, 5);
+    d.file("/" + upper, 5);
+    expected.push_back(upper);
+    expected.push_back(n);
+  }
+  for(const char *sort : {"name", "size"}){
+    std::vector<std::string> all = listAll("/", sort, false);
+    CHECK(all == expected);
+  }
+}
+
+TEST(sortedPassesBounded){
+  HostDir d;
+  const int files = 600;
+  std::vector<std::pair<int, std::string>> byDate;
+  for(int i = 0; i < files; i++){
+    d.file("/" + name(i), 1, 1600000000 + (i * 11) % 97);
+    byDate.push_back({(i * 11) % 97, name(i)});
+  }
+  std::sort(byDate.begin(), byDate.end());
+  uint32_t before = hostStatCalls;
+  CHECK_EQ(listAll("/", "date", false).size(), files);
+  uint32_t everyPage = hostStatCalls - before;         // Without PSRAM the directory is read for every page
+  hostPsram = true;                                    // With it, a pass keeps FMdirSortedPages pages
+  before = hostStatCalls;
+  std::vector<std::string> all = listAll("/", "date", false);
+  uint32_t passes = (files + FMdirSortedPages * FMdirPageSize - 1) / (FMdirSortedPages * FMdirPageSize);
+  CHECK(hostStatCalls - before <= passes * files);
+  CHECK(hostStatCalls - before < everyPage / 4);
+  CHECK_EQ(all.size(), files);
+  for(int i = 0; i < files; i++) CHECK_STR(all[i], byDate[i].second);
+  std::vector<std::string> expected;
+  for(int i = files - 1; i >= 0; i--) expected.push_back(name(i));
+  CHECK(listAll("/", "name", true) == expected);
+  FMdirWindowFree();
+  hostPsram = false;
+}
+
+TEST(escapedNames){
+  HostDir d;
+  d.mkdir("/q\"d");
+  d.file("/q\"d/a\\b\"c", 3);
+  std::vector<std::string> all = listAll("/", "", false);
+  CHECK_EQ(all.size(), 1);
+  CHECK_STR(all[0], "q\"d/");
+  all = listAll("/q\"d", "name", false);
+  CHECK_EQ(all.size(), 1);
+  CHECK_STR(all[0], "a\\b\"c");
+}
+
+TEST(unknownDirSendsNothing){
+  HostDir d;
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  FMsendDir(c, "LittleFS", "/missing", "", false, "");
+  FMsendDir(c, "SD", "/", "", false, "");
+  CHECK_EQ(c->frames.size(), 0);
+  ws.hostDisconnect(1);
+}
+
+// ---- Downloads ----
+TEST(parseRange){
+  size_t start = 0, end = 0;
+  CHECK_EQ(FMparseRange("bytes=10-19", 100, start, end), 1);
+  CHECK_EQ(start, 10);
+  CHECK_EQ(end, 19);
+  CHECK_EQ(FMparseRange("bytes=90-", 100, start, end), 1);
+  CHECK_EQ(end, 99);
+  CHECK_EQ(FMparseRange("bytes=-30", 100, start, end), 1);
+  CHECK_EQ(start, 70);
+  CHECK_EQ(FMparseRange("bytes=-300", 100, start, end), 1);
+  CHECK_EQ(start, 0);
+  CHECK_EQ(FMparseRange("bytes=50-500", 100, start, end), 1);
+  CHECK_EQ(end, 99);
+  CHECK_EQ(FMparseRange("bytes=100-", 100, start, end), -1);
+  CHECK_EQ(FMparseRange("bytes=-0", 100, start, end), -1);
+  CHECK_EQ(FMparseRange("bytes=0-1,5-6", 100, start, end), 0);
+  CHECK_EQ(FMparseRange("bytes=9-5", 100, start, end), 0);
+  CHECK_EQ(FMparseRange("items=0-5", 100, start, end), 0);
+}
+
+// Sends the whole response of a download, the way the async TCP task does. Gives up after a few seconds
+static std::string pumpAll(AsyncWebServerRequest &r){
+  std::string body;
+  uint8_t buf[1460];
+  unsigned long start = millis();
+  while(!r.hostComplete() && (millis() - start < 5000)){
+    size_t n = r.hostPump(buf, sizeof(buf));
+    if(n == RESPONSE_TRY_AGAIN){ delay(1); continue; }
+    if(n == 0) break;
+    body.append((const char *)buf, n);
+  }
+  return body;
+}
+
+static void startReader(){
+  static bool started = false;
+  if(!started) FMdownloadInit();
+  started = true;
+}
+
+TEST(downloadWhole){
+  HostDir d;
+  startReader();
+  d.file("/big.bin", 3 * FMdownloadBufKB * 1024 + 123);
+  AsyncWebServerRequest r(HTTP_GET, "/download");
+  FMsendDownload(&r, 0, "/big.bin", "big.bin");
+  CHECK_EQ(r.hostResponse()->code, 200);
+  CHECK_STR(r.hostResponse()->header("Accept-Ranges"), "bytes");
+  CHECK(pumpAll(r) == d.read("/big.bin"));
+}
+
+TEST(downloadRange){
+  HostDir d;
+  startReader();
+  d.file("/f.txt", 1000);
+  AsyncWebServerRequest r(HTTP_GET, "/download");
+  r.hostHeader("Range", "bytes=100-199");
+  FMsendDownload(&r, 0, "/f.txt", "f.txt");
+  CHECK_EQ(r.hostResponse()->code, 206);
+  CHECK_STR(r.hostResponse()->header("Content-Range"), "bytes 100-199/1000");
+  CHECK(pumpAll(r) == d.read("/f.txt").substr(100, 100));
+
+  AsyncWebServerRequest stale(HTTP_GET, "/download");  // If-Range of an older version: the whole file
+  stale.hostHeader("Range", "bytes=100-199");
+  stale.hostHeader("If-Range", "\"3e8-1\"");
+  FMsendDownload(&stale, 0, "/f.txt", "f.txt");
+  CHECK_EQ(stale.hostResponse()->code, 200);
+  CHECK_EQ(pumpAll(stale).size(), 1000);
+
+  AsyncWebServerRequest bad(HTTP_GET, "/download");
+  bad.hostHeader("Range", "bytes=1000-");
+  FMsendDownload(&bad, 0, "/f.txt", "f.txt");
+  CHECK_EQ(bad.hostResponse()->code, 416);
+
+  AsyncWebServerRequest missing(HTTP_GET, "/download");
+  FMsendDownload(&missing, 0, "/nothing.txt", "nothing.txt");
+  CHECK_EQ(missing.hostResponse()->code, 404);
+}
+
+// Waits until FMreader closed the files of at least n slots (all if not given) and freed them. Gives up after a few seconds
+static bool slotsFree(int n = FMmaxDownloads){
+  unsigned long start = millis();
+  while(millis() - start < 5000){
+    int free = 0;
+    for(auto &s : FMdlSlots) if(s.state == FMdlFree) free++;
+    if(free >= n) return true;
+    delay(1);
+  }
+  return false;
+}
+
+TEST(downloadEmpty){
+  HostDir d;
+  startReader();
+  d.file("/empty.txt", 0);
+  AsyncWebServerRequest r(HTTP_GET, "/download");
+  FMsendDownload(&r, 0, "/empty.txt", "empty.txt");
+  CHECK_EQ(r.hostResponse()->code, 200);
+  CHECK_EQ(FMdlWaiting, 0);                            // Never queued
+  CHECK_EQ(pumpAll(r).size(), 0);
+}
+
+TEST(downloadOpenFails){
+  HostDir d;
+  startReader();
+  d.file("/gone.txt", 100);
+  AsyncWebServerRequest r(HTTP_GET, "/download");
+  FMsendDownload(&r, 0, "/gone.txt", "gone.txt");
+  ::remove((d.dir + "/gone.txt").c_str());             // Headers were sent, the file can't be opened any more
+  CHECK_EQ(pumpAll(r).size(), 0);
+  CHECK(slotsFree());                                  // Given back without waiting for the client to disconnect
+  CHECK_EQ(FMdlWaiting, 0);
+}
+
+TEST(downloadQueue){
+  HostDir d;
+  startReader();
+  d.file("/f.txt", 1000);
+  AsyncWebServerRequest *r[4];
+  uint8_t buf[100];
+  for(auto &x : r){
+    x = new AsyncWebServerRequest(HTTP_GET, "/download");
+    FMsendDownload(x, 0, "/f.txt", "f.txt");
+  }
+  r[0]->hostPump(buf, sizeof(buf));                    // 0 and 1 take both slots, 2 and 3 wait
+  r[1]->hostPump(buf, sizeof(buf));
+  CHECK_EQ(FMdlWaiting, 2);
+  CHECK(r[3]->hostPump(buf, sizeof(buf)) == RESPONSE_TRY_AGAIN);
+  delete r[0];                                         // Client went away: one slot becomes free
+  CHECK(slotsFree(1));
+  CHECK(r[3]->hostPump(buf, sizeof(buf)) == RESPONSE_TRY_AGAIN);   // 2 came first and still asks: its turn
+  CHECK(r[2]->hostPump(buf, sizeof(buf)) != RESPONSE_TRY_AGAIN);
+  CHECK_EQ(FMdlWaiting, 1);
+  delete r[1];
+  CHECK(slotsFree(1));
+  CHECK(pumpAll(*r[3]) == d.read("/f.txt"));
+  delete r[2];
+  delete r[3];
+  CHECK(slotsFree());
+}
+
+TEST(downloadStalledHead){
+  HostDir d;
+  startReader();
+  d.file("/f.txt", 1000);
+  AsyncWebServerRequest a(HTTP_GET, "/download"), b(HTTP_GET, "/download");
+  AsyncWebServerRequest stalled(HTTP_GET, "/download"), next(HTTP_GET, "/download");
+  FMsendDownload(&a, 0, "/f.txt", "f.txt");
+  FMsendDownload(&b, 0, "/f.txt", "f.txt");
+  FMsendDownload(&stalled, 0, "/f.txt", "f.txt");      // Its client never takes data, so it never asks for a slot
+  FMsendDownload(&next, 0, "/f.txt", "f.txt");
+  CHECK_EQ(pumpAll(a).size(), 1000);
+  CHECK_EQ(pumpAll(b).size(), 1000);
+  CHECK(pumpAll(next) == d.read("/f.txt"));            // Doesn't wait for the stalled one longer than FMdlPatienceMs
+  CHECK_EQ(FMdlWaiting, 1);
+  stalled.hostDisconnect();
+  CHECK_EQ(FMdlWaiting, 0);
+  CHECK(slotsFree());
+}
+
+// ---- Uploads ----
+static void startWriter(){
+  static bool started = false;
+  if(!started) FMpipeInit();
+  started = true;
+}
+
+TEST(uploadPipeline){
+  HostDir d;
+  startWriter();
+  std::string data;
+  for(int i = 0; i < 3 * FMuploadBufKB * 1024 + 777; i++) data += (char)('0' + i % 10);
+  char path[] = "LittleFS/up.txt";
+  int slot = createUpload(path, data.size());
+  CHECK(slot >= 0);
+  uint32_t gen = FMpipeOpen(slot, 0, "/up.txt");
+  CHECK(gen != 0);
+  CHECK_EQ(FMpipeOpen(slot, 0, "/up.txt"), 0);        // Busy
+  for(size_t i = 0; i < data.size(); i += 1436)
+    CHECK(FMpipeWrite(slot, (uint8_t *)&data[i], min((size_t)1436, data.size() - i)));
+  FMpipeClose(slot, gen);
+  for(int i = 0; (i < 500) && (FMuploads[slot].stat != 4); i++) delay(10);
+  CHECK_EQ(FMuploads[slot].stat, 4);
+  CHECK_EQ(FMuploads[slot].written, data.size());
+  CHECK_EQ(d.read("/up.txt").size(), data.size());
+  CHECK(d.read("/up.txt") == data);
+  deleteUpload(path);
+}
+
+
+// The storage takes longer than FMuploadWaitMs for a buffer: the upload is aborted instead of blocking the network
+TEST(uploadStorageTooSlow){
+  HostDir d;
+  startWriter();
+  std::vector<uint8_t> block(FMuploadBufKB * 1024, 'x');
+  char path[] = "LittleFS/slow.txt";
+  int slot = createUpload(path, 3 * block.size());
+  uint32_t gen = FMpipeOpen(slot, 0, "/slow.txt");
+  hostWriteDelayMs = FMuploadWaitMs + 500;
+  unsigned long start = millis();
+  CHECK(FMpipeWrite(slot, block.data(), block.size()));   // FMwriter takes this one and is busy with it
+  CHECK(!FMpipeWrite(slot, block.data(), block.size()));  // Waits for the other buffer no longer than FMuploadWaitMs
+  CHECK(millis() - start < FMuploadWaitMs + 400);
+  CHECK(!FMpipeWrite(slot, block.data(), block.size()));  // Aborted: the rest is ignored
+  FMpipeClose(slot, gen);
+  for(int i = 0; (i < 500) && (FMuploads[slot].stat != 4); i++) delay(10);
+  hostWriteDelayMs = 0;
+  CHECK_EQ(FMuploads[slot].stat, 4);                     // File closed
+  CHECK_EQ(FMuploads[slot].written, 2 * block.size());  // Both buffers handed over before the abort are written
+  deleteUpload(path);
+  slot = createUpload(path, 10);                         // The slot works again
+  gen = FMpipeOpen(slot, 0, "/slow.txt");
+  CHECK(gen != 0);
+  CHECK(FMpipeWrite(slot, (uint8_t *)"0123456789", 10));
+  FMpipeClose(slot, gen);
+  for(int i = 0; (i < 500) && (FMuploads[slot].stat != 4); i++) delay(10);
+  CHECK(d.read("/slow.txt") == "0123456789");
+  deleteUpload(path);
+}
+
+// ---- Usage cache ----
+TEST(usageCache){
+  HostDir d;
+  d.file("/a.txt", 1000);
+  initFSUsage();
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 1), hostTotalBytes);
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 2), 1000);
+  char fname[] = "/a.txt";
+  FMdelete(0, fname);
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 2), 0);
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 3), hostTotalBytes);
+  fsUsageAdjust(FSUsageLittleFS, -50);                 // Overshoots: never below 0
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 2), 0);
+  CHECK(!fsUsageReconcile());                           // Not quiet long enough
+  fsUsage[FSUsageLittleFS].changed -= FSreconcileQuietSec * 1000UL;
+  d.file("/b.txt", 300);                                // Written without the file manager knowing
+  CHECK(fsUsageReconcile());
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 2), 300);
+  CHECK(!fsUsage[FSUsageLittleFS].dirty);
+}
+
+// An upload finishes while the real usage is computed: its adjustment must not be lost
+TEST(usageAdjustedWhileReconciling){
+  HostDir d;
+  d.file("/a.txt", 1000);
+  initFSUsage();
+  fsUsageAdjust(FSUsageLittleFS, 0);
+  fsUsage[FSUsageLittleFS].changed -= FSreconcileQuietSec * 1000UL;
+  hostWhileUsedBytes = [](){ fsUsageAdjust(FSUsageLittleFS, 500); };
+  CHECK(fsUsageReconcile());
+  hostWhileUsedBytes = NULL;
+  CHECK_EQ(fsUsageBytes(FSUsageLittleFS, 2), 1500);    // Not overwritten with the 1000 bytes computed before the upload
+  CHECK(fsUsage[FSUsageLittleFS].dirty);
+  CHECK(!fsUsageReconcile());                           // Again once quiet
+  fsUsage[FSUsageLittleFS].changed -= FSreconcileQuietSec * 1000UL;
+  CHECK(fsUsageReconcile());
+  CHECK(!fsUsage[FSUsageLittleFS].dirty);
+}
+
+TEST_MAIN
@@ -0,0 +1,170 @@
+// HTML escaping: HTMLEscaper, CharPrint and textToHTML, also compared with textToHTML as it was before HTMLEscaper
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "Check.h"
+#include "HostHeap.h"
+#include "LegacyHTMLUtil.h"
+#include <random>
+
+#include "HTMLUtil.ino"
+
+// Escapes text in one go
+static std::string escape(const std::string &text){
+  static char buf[4096];
+  CharPrint out(buf, sizeof(buf));
+  HTMLEscaper html(out);
+  ((Print &)html).write((const uint8_t *)text.data(), text.size());
+  html.flush();
+  CHECK_EQ(html.written, out.length());
+  return std::string(buf, out.length());
+}
+
+TEST(ascii){
+  CHECK_STR(escape("plain text 123"), "plain text 123");
+  CHECK_STR(escape("a&b\"c\td\ne~"), "a&amp;b&quot;c&#09;d<br>e&tilde;");
+  CHECK_STR(escape("<b>"), "<b>");             // Markup passes, as it always did
+}
+
+TEST(multibyte){
+  CHECK_STR(escape("\xC3\xA9t\xC3\xA9"), "&eacute;t&eacute;");          // été
+  CHECK_STR(escape("\xE2\x82\xAC 5"), "&#8364; 5");                      // €
+  CHECK_STR(escape("\xE2\x84\xA2"), "&trade;");                          // ™
+  CHECK_STR(escape("\xC3\xA3"), "\xC3\xA3");                             // ã: not in the table, sent as it is
+  CHECK_STR(escape("\xF0\x9F\x98\x80"), "\xF0\x9F\x98\x80");             // Emoji, 4 bytes
+}
+
+TEST(allEntities){
+  for(size_t i = 0; i < numHTMLEntities; i++){
+    uint32_t u = htmlEntities[i].code;
+    std::string s;
+    if(u < 0x80) s += (char)u;
+    else if(u < 0x800){ s += (char)(0xC0 | (u >> 6)); s += (char)(0x80 | (u & 0x3F)); }
+    else { s += (char)(0xE0 | (u >> 12)); s += (char)(0x80 | ((u >> 6) & 0x3F)); s += (char)(0x80 | (u & 0x3F)); }
+    CHECK_STR(escape(s), htmlEntities[i].entity);
+  }
+}
+
+TEST(overlongUTF8){
+  CHECK_STR(escape("\xC0\x89"), "\xC0\x89");                               // Overlong tab
+  CHECK_STR(escape("\xC0\xA2"), "\xC0\xA2");                               // Overlong "
+  CHECK_STR(escape("\xE0\x82\xA9"), "\xE0\x82\xA9");                       // Overlong (c)
+}
+
+TEST(invalidUTF8){
+  CHECK_STR(escape("\xC3"), "\xC3");                                     // Cut off at the end
+  CHECK_STR(escape("\xC3&"), "\xC3&amp;");                               // Broken off by ASCII
+  CHECK_STR(escape("\xE2\x82\xC3\xA9"), "\xE2\x82&eacute;");             // Broken off by another sequence
+  CHECK_STR(escape("\x80\xBF"), "\x80\xBF");                             // Continuation bytes without a lead byte
+  CHECK_STR(escape("\xFF"), "\xFF");
+}
+
+TEST(splitWrites){
+  std::string text = "caf\xC3\xA9 \xE2\x82\xAC & \"x\"\n";
+  std::string whole = escape(text);
+  for(size_t cut = 1; cut < text.size(); cut++){       // UTF-8 sequences split between writes
+    char buf[256];
+    CharPrint out(buf, sizeof(buf));
+    HTMLEscaper html(out);
+    Print &p = html;
+    p.write((const uint8_t *)text.data(), cut);
+    p.write((const uint8_t *)text.data() + cut, text.size() - cut);
+    html.flush();
+    CHECK_STR(std::string(buf, out.length()), whole);
+  }
+}
+
+TEST(charPrintCutsOff){
+  char buf[8];
+  CharPrint out(buf, sizeof(buf));
+  CHECK_EQ(out.print("0123456789"), 7);
+  CHECK_STR(buf, "0123456");
+  CHECK_EQ(out.length(), 7);
+}
+
+TEST(textToHTMLBuffer){
+  char txt[100] = "Temp 20\xC2\xB0" "C\n";
+  textToHTML(txt, sizeof(txt));
+  CHECK_STR(txt, "<meta charset=\"UTF-8\">Temp 20&deg;C<br>");
+  char small[30] = "a&b&c&d";
+  textToHTML(small, sizeof(small));
+  CHECK_STR(small, "<meta charset=\"UTF-8\">a&amp;b");   // Cut off, zero terminated
+}
+
+// ---- Same output as before ----
+// Tab and " were escaped before &, so the old version sent &amp;#09; and &amp;quot; for them. That is the only
+// intended difference. Both outputs are compared with those two put right
+static std::string normalized(std::string s){
+  for(auto r : {std::make_pair("&amp;#09;", "&#09;"), std::make_pair("&amp;quot;", "&quot;")})
+    for(size_t p = 0; (p = s.find(r.first, p)) != std::string::npos; p += strlen(r.second))
+      s.replace(p, strlen(r.first), r.second);
+  return s;
+}
+
+static void compareWithLegacy(const std::string &text, int len){
+  std::vector<char> a(len), b(len);
+  strlcpy(a.data(), text.c_str(), len);
+  strlcpy(b.data(), text.c_str(), len);
+  legacyTextToHTML(a.data(), len);
+  textToHTML(b.data(), len);
+  std::string legacy = normalized(a.data()), now = normalized(b.data());
+  if(legacy != now){
+    std::string hex;
+    for(unsigned char c : text){ char h[4]; sprintf(h, "%02X ", c); hex += h; }
+    fprintf(stderr, "Differs for %s\n", hex.c_str());
+  }
+  CHECK_STR(now, legacy);
+}
+
+TEST(tabAndQuoteFixed){
+  char txt[100] = "\t\"";
+  textToHTML(txt, sizeof(txt));
+  CHECK_STR(txt, "<meta charset=\"UTF-8\">&#09;&quot;");
+  legacyTextToHTML(strcpy(txt, "\t\""), sizeof(txt));
+  CHECK_STR(txt, "<meta charset=\"UTF-8\">&amp;#09;&amp;quot;");
+}
+
+TEST(legacyEntities){
+  for(auto &r : legacyRepl) compareWithLegacy(std::string("x") + r[0].c_str() + "y", 200);
+  for(size_t i = 0; i < numHTMLEntities; i++){         // Each entity of the new table, encoded as UTF-8
+    uint32_t u = htmlEntities[i].code;
+    std::string s;
+    if(u < 0x80) s += (char)u;
+    else if(u < 0x800){ s += (char)(0xC0 | (u >> 6)); s += (char)(0x80 | (u & 0x3F)); }
+    else { s += (char)(0xE0 | (u >> 12)); s += (char)(0x80 | ((u >> 6) & 0x3F)); s += (char)(0x80 | (u & 0x3F)); }
+    compareWithLegacy(s, 200);
+  }
+}
+
+// Random text from pieces that matter (entities, parts of UTF-8 sequences, markup, literal entities) and random bytes
+TEST(legacyFuzz){
+  std::vector<std::string> pieces = {"a", "Z", "0", " ", "\n", "\t", "\"", "&", "~", "<", ">", "'", ";", "#", "&#09;",
+                                     "&quot;", "&amp;", "\xC3", "\xE2\x80", "\x80", "\xBF", "\xF0\x9F\x98\x80", "\xC0\x89"};
+  for(auto &r : legacyRepl) pieces.push_back(r[0].c_str());
+  std::mt19937 rng(12345);
+  for(int i = 0; i < 20000; i++){
+    std::string text;
+    int n = rng() % 40;
+    for(int k = 0; k < n; k++){
+      if(rng() % 4) text += pieces[rng() % pieces.size()];
+      else text += (char)(1 + rng() % 255);
+    }
+    compareWithLegacy(text, 4096);                     // Room for everything: no cut off
+    if(text.find_first_of("\t\"") == std::string::npos)
+      compareWithLegacy(text, 23 + rng() % 60);        // Cut off at the same place
+    if(hostFailures()) break;
+  }
+}
+
+TEST(noHeap){
+  std::string text;
+  for(int i = 0; i < 100; i++) text += "caf\xC3\xA9 & \"x\"\n";
+  char buf[4096];
+  hostHeapReset();
+  CharPrint out(buf, sizeof(buf));
+  HTMLEscaper html(out);
+  html.print(text.c_str());
+  html.flush();
+  CHECK_EQ(hostHeap().allocs, 0);
+}
+
+TEST_MAIN
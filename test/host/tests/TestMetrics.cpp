@@ -0,0 +1,108 @@
+// Metrics (Metrics.ino): durations in the histograms, whatever their length, metrics registered at run time, and the
+// /metrics and getMetrics output
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "Check.h"
+
+// ---- Stand-ins for the rest of the sketch ----
+AsyncWebServer server(80);
+int64_t lastReboot = 0;
+void wsSetupMetrics(){}
+
+#include "Metrics.ino"
+
+static AsyncWebSocket ws("/ws");
+
+TEST(shortDurations){
+  memset(metrics, 0, sizeof(metrics));
+  int64_t now = esp_timer_get_time();
+  metricsRecord(MetricStatus, now - 10, 100);          // Up to 16us
+  metricsRecord(MetricStatus, now - 40, 0);            // Up to 64us
+  MetricHist m;
+  metricsGet(MetricStatus, m);
+  CHECK_EQ(m.count, 2);
+  CHECK_EQ(m.buckets[0], 1);
+  CHECK_EQ(m.buckets[2], 1);
+  CHECK_EQ(m.bytes, 100);
+  CHECK(m.us >= 50);
+}
+
+TEST(longDurations){
+  memset(metrics, 0, sizeof(metrics));
+  int64_t now = esp_timer_get_time();
+  metricsRecord(MetricLoopTelegram, now - 10000000LL, 0);      // 10s: longer than the last bucket, but recorded
+  metricsRecord(MetricLoopTelegram, now - 3600000000LL, 0);    // An hour
+  MetricHist m;
+  metricsGet(MetricLoopTelegram, m);
+  CHECK_EQ(m.count, 2);
+  CHECK_EQ(m.buckets[MetricBuckets], 2);
+  CHECK(m.maxUs >= 3600000000UL);
+  CHECK(m.us >= 3610000000ULL);
+}
+
+TEST(scopeRecords){
+  memset(metrics, 0, sizeof(metrics));
+  {
+    metricsScope(MetricLoopCustom);
+    metricsBytes(5);
+    delay(20);
+  }
+  MetricHist m;
+  metricsGet(MetricLoopCustom, m);
+  CHECK_EQ(m.count, 1);
+  CHECK_EQ(m.bytes, 5);
+  CHECK(m.maxUs >= 20000);
+}
+
+TEST(registered){
+  memset(metrics, 0, sizeof(metrics));
+  metricsNum = MetricCount;
+  int sensor = metricsRegister("/sensor", "route");
+  CHECK_EQ(sensor, MetricCount);
+  CHECK_EQ(metricsRegister("getDateTime", "websocket"), MetricCount + 1);
+  CHECK_EQ(metricsRegister("/sensor", "route"), sensor);      // Same one again
+  metricsRecord(sensor, esp_timer_get_time() - 100, 7);
+  MetricHist m;
+  metricsGet(sensor, m);
+  CHECK_EQ(m.count, 1);
+  CHECK_EQ(m.bytes, 7);
+  static char names[MetricsRegistered][12];
+  for(int i = 0; i < MetricsRegistered; i++){
+    sprintf(names[i], "/page%02d", i);
+    metricsRegister(names[i], "route");
+  }
+  CHECK_EQ(metricsNum, MetricCount + MetricsRegistered);
+  CHECK_EQ(metricsRegister("/late", "route"), -1);             // Full
+  metricsRecord(-1, esp_timer_get_time(), 0);                  // Ignored
+  {
+    metricsScope(-1);
+  }
+  static char buf[65536];
+  CharPrint out(buf, sizeof(buf));
+  sendMetrics(&out);
+  CHECK(std::string(buf).find("webserver_duration_seconds_count{kind=\"route\",name=\"/sensor\"} 1\n") != std::string::npos);
+  metricsNum = MetricCount;
+}
+
+TEST(output){
+  memset(metrics, 0, sizeof(metrics));
+  metricsRecord(MetricStatic, esp_timer_get_time() - 9000000LL, 42);
+  static char buf[8192];
+  CharPrint out(buf, sizeof(buf));
+  sendMetrics(&out);
+  std::string text(buf);
+  CHECK(text.find("webserver_duration_seconds_bucket{kind=\"route\",name=\"static\",le=\"+Inf\"} 1\n") != std::string::npos);
+  CHECK(text.find("webserver_duration_seconds_bucket{kind=\"route\",name=\"static\",le=\"8.38861\"} 0\n") != std::string::npos);
+  CHECK(text.find("webserver_duration_seconds_sum{kind=\"route\",name=\"static\"} 9.0") != std::string::npos);
+  CHECK(text.find("name=\"/status\"") == std::string::npos);   // Never happened: left out
+  CHECK_STR(metricInfo[MetricLog][0], "/log");
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  WSRequest req;
+  wsGetMetrics(c, req);
+  std::string json = c->lastText();
+  CHECK(json.find("{\"name\":\"static\",\"kind\":\"route\",\"count\":1,\"sumUs\":9000") != std::string::npos);
+  CHECK(json.find("\"bytes\":42,") != std::string::npos);
+  ws.hostDisconnect(1);
+}
+
+TEST_MAIN
@@ -0,0 +1,73 @@
+// Parameters kept in Preferences (Params.ino): first boot defaults and updates
+#include "Sketch.h"
+#define timezone sketchTimezone                // glibc declares a timezone of its own
+#include "Prototypes.h"
+#include "Check.h"
+
+// ---- The settings, as in ESP32S3WebserverProject.ino ----
+char ssid[32];
+char password[64];
+char hostname[32] = "";
+char appasswd[64] = "";
+bool beacon = false;
+char adminUsername[32] = "";
+char adminPassword[32] = "";
+char timezone[64] = "";
+char ntpserver[64] = "";
+void serialPrint(char buff[], bool immediate){}
+
+#include "Params.ino"
+
+// Erases the flash and puts the settings back to how the sketch starts. update* only writes what differs from
+// these, so every test starts with this, whatever ran before it
+static void powerOn(){
+  Preferences::hostReset();
+  for(char *s : {ssid, password, hostname, appasswd, adminUsername, adminPassword, timezone, ntpserver}) s[0] = 0;
+  beacon = false;
+}
+
+static std::string stored(const char *key){
+  Preferences p;
+  p.begin(params, true);
+  char buf[100] = "";
+  p.getBytes(key, buf, sizeof(buf));
+  p.end();
+  return buf;
+}
+
+TEST(firstBoot){
+  powerOn();
+  CHECK(initParams());
+  CHECK_STR(hostname, def_HostName);
+  CHECK_STR(appasswd, def_APpassword);
+  CHECK_EQ(beacon, def_Beacon);
+  CHECK_STR(adminUsername, def_AdminName);
+  CHECK_STR(timezone, def_Timezone);
+  CHECK_STR(ntpserver, def_NTPServer);
+  CHECK_STR(stored(P_HOSTNAME), def_HostName);
+  char chipId[20];
+  uint64_t mac = ESP.getEfuseMac();
+  sprintf(chipId, "%08X%08X", (uint32_t)(mac >> 32), (uint32_t)(mac & 0xFFFFFFFFLL));
+  CHECK_STR(stored(P_CHIPID), chipId);
+}
+
+TEST(updates){
+  powerOn();
+  initParams();
+  Preferences p;
+  p.begin(params, false);
+  updateHostName("garden", &p);
+  updateNTPServer("ntp.example.org", &p);
+  updateBeacon(!def_Beacon, &p);
+  p.end();
+  CHECK_STR(hostname, "garden");
+  CHECK_STR(stored(P_HOSTNAME), "garden");
+  CHECK_STR(stored(P_NTPSERVER), "ntp.example.org");
+  CHECK_STR(stored(P_BEACON).substr(0, 1), def_Beacon ? "0" : "1");
+  p.begin(params, true);                       // Read only: nothing is written
+  updateSSID("other", &p);
+  p.end();
+  CHECK_STR(stored(P_SSID), def_SSID);
+}
+
+TEST_MAIN
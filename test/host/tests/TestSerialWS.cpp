@@ -0,0 +1,146 @@
+// SerialWS: the transmit and receive rings, wrapping around their ends, and the backlog of stalled clients
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "SerialWS.h"
+#include "Check.h"
+#include "HostHeap.h"
+
+extern AsyncWebSocket _ws;                     // SerialWS.cpp
+static AsyncWebServer server(80);
+
+// A SerialWS with small rings, so tests wrap around their ends quickly. Clients are disconnected at the end
+struct Fixture {
+  SerialWS s;
+  std::vector<uint32_t> ids;
+  Fixture(uint16_t tx = 16, uint16_t rx = 16){ s.begin(&server, tx, rx); }
+  ~Fixture(){
+    for(auto id : ids) _ws.hostDisconnect(id);
+    s.end();
+  }
+  AsyncWebSocketClient *connect(uint32_t id){
+    ids.push_back(id);
+    return _ws.hostConnect(id);
+  }
+};
+
+static std::string all(AsyncWebSocketClient *c){
+  std::string s;
+  for(auto &f : c->frames) s += f.data;
+  return s;
+}
+
+TEST(txWrapsAround){
+  Fixture f;
+  AsyncWebSocketClient *c = f.connect(1);
+  f.s.write("0123456789");
+  f.s.send();
+  f.s.write("abcdefghij");                     // Head and tail are at 10: this wraps around the end of the ring
+  CHECK_EQ(f.s.awaitingSend(), 10);
+  f.s.send();
+  CHECK_EQ(c->frames.size(), 2);
+  CHECK_STR(c->lastText(), "abcdefghij");
+  CHECK_EQ(f.s.framesSent(), 2);
+  CHECK_EQ(f.s.bytesCoalesced(), 20);
+}
+
+TEST(txFullRingIsSent){
+  Fixture f;
+  AsyncWebSocketClient *c = f.connect(1);
+  std::string text;
+  for(int i = 0; i < 40; i++) text += (char)('A' + i % 26);
+  f.s.write(text.c_str());                     // 40 bytes through a ring of 15: sent whenever it is full
+  f.s.send();
+  CHECK_EQ(c->frames.size(), 3);
+  CHECK_EQ(c->frames[0].data.size(), 15);
+  CHECK_STR(all(c), text);
+  CHECK_EQ(f.s.awaitingSend(), 0);
+}
+
+TEST(rxWrapsAround){
+  Fixture f;
+  AsyncWebSocketClient *c = f.connect(1);
+  char buf[32] = {};
+  _ws.hostText(c, "0123456789");
+  CHECK_EQ(f.s.read(buf, 6), 6);
+  CHECK_STR(std::string(buf, 6), "012345");
+  _ws.hostText(c, "abcdefghij");               // Wraps around the end
+  CHECK_EQ(f.s.available(), 14);
+  CHECK_EQ(f.s.peek(), '6');
+  CHECK_EQ(f.s.read(buf, sizeof(buf)), 14);
+  CHECK_STR(std::string(buf, 14), "6789abcdefghij");
+  CHECK_EQ(f.s.read(), -1);
+}
+
+TEST(rxOverflowIsDropped){
+  Fixture f;
+  AsyncWebSocketClient *c = f.connect(1);
+  char buf[32] = {};
+  _ws.hostText(c, "0123456789abcdefghij");     // Only 15 bytes fit
+  CHECK_EQ(f.s.available(), 15);
+  CHECK_EQ(f.s.read(buf, sizeof(buf)), 15);
+  CHECK_STR(std::string(buf, 15), "0123456789abcde");
+}
+
+TEST(stalledClientBacklog){
+  Fixture f(64, 16);
+  f.s.setClientPolicy(8, true);                // Keep the newest 8 bytes
+  AsyncWebSocketClient *fast = f.connect(1);
+  AsyncWebSocketClient *slow = f.connect(2);
+  slow->hostQueueFull = true;
+  f.s.write("0123456789");
+  f.s.send();
+  CHECK_STR(fast->lastText(), "0123456789");
+  CHECK_EQ(slow->framesReceived, 0);
+  CHECK_EQ(f.s.bytesDropped(), 2);
+  slow->hostQueueFull = false;
+  f.s.handle();                                // Caught up: gets its backlog in one frame
+  CHECK_STR(slow->lastText(), "23456789");
+}
+
+TEST(stalledClientDropNewest){
+  Fixture f(64, 16);
+  f.s.setClientPolicy(8, false);
+  f.connect(1);
+  AsyncWebSocketClient *slow = f.connect(2);
+  slow->hostQueueFull = true;
+  f.s.write("0123456789");
+  f.s.send();
+  slow->hostQueueFull = false;
+  f.s.handle();
+  CHECK_STR(slow->lastText(), "01234567");
+  CHECK_EQ(f.s.bytesDropped(), 2);
+}
+
+TEST(binaryKeepsOrder){
+  Fixture f;
+  AsyncWebSocketClient *c = f.connect(1);
+  f.s.write("text");
+  const uint8_t data[] = {1, 2, 3};
+  CHECK_EQ(f.s.binary(data, sizeof(data)), 3);
+  CHECK_EQ(c->frames.size(), 2);
+  CHECK(!c->frames[0].binary);
+  CHECK(c->frames[1].binary);
+  CHECK_STR(c->frames[1].data, std::string("\1\2\3"));
+}
+
+TEST(flushPolicy){
+  Fixture f(64, 16);
+  AsyncWebSocketClient *c = f.connect(1);
+  f.s.setFlushPolicy(8, 60000);
+  f.s.write("0123");
+  f.s.handle();                                // Fewer than 8 bytes, not old enough: held
+  CHECK_EQ(c->frames.size(), 0);
+  f.s.write("4567");
+  f.s.handle();
+  CHECK_STR(c->lastText(), "01234567");
+}
+
+TEST(writeDoesNotAllocate){
+  Fixture f(256, 16);
+  f.connect(1);
+  hostHeapReset();
+  for(int i = 0; i < 20; i++) f.s.write("0123456789");
+  CHECK_EQ(hostHeap().allocs, 0);
+}
+
+TEST_MAIN
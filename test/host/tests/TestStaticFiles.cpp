@@ -0,0 +1,199 @@
+// Static files (StaticFiles.ino): what staticLookup remembers about files and for how long, StaticFileHandler, and what
+// the PSRAM cache (AssetCache.ino) records when a file can't be loaded
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "Check.h"
+#include <unistd.h>
+#include <sys/time.h>
+#include <ftw.h>
+
+// ---- Stand-ins for the rest of the sketch ----
+AsyncWebServer server(80);
+void metricsRecord(int id, int64_t start, size_t bytes){}
+bool bootStorageReady(){ return true; }
+bool storageAvailable(AsyncWebServerRequest *request){ return true; }
+int fsUsageNum(const char *name){ return (strcmp(name, "LittleFS") == 0) ? FSUsageLittleFS : -1; }
+void serialPrint(char buff[], bool immediate){}
+
+#include "StaticFiles.ino"
+#include "AssetCache.ino"
+
+// ---- A temporary directory, mounted at /littlefs ----
+static int removeEntry(const char *path, const struct stat *st, int flag, struct FTW *ftw){ return ::remove(path); }
+
+struct StaticDir {
+  std::string dir;
+  StaticDir(){
+    char tmpl[] = "/tmp/statichostXXXXXX";
+    dir = mkdtemp(tmpl);
+    hostMount("/littlefs", dir.c_str());
+    memset(staticMeta, 0, sizeof(staticMeta));
+    memset(staticMiss, 0, sizeof(staticMiss));
+  }
+  ~StaticDir(){ nftw(dir.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS); }
+  void file(const std::string &path, const std::string &content, time_t mtime = 1600000000){
+    std::string full = dir + path;
+    FILE *f = fopen(full.c_str(), "wb");
+    fwrite(content.data(), 1, content.size(), f);
+    fclose(f);
+    struct timeval tv[2] = {{mtime, 0}, {mtime, 0}};
+    utimes(full.c_str(), tv);
+  }
+  void mkdir(const std::string &path){ ::mkdir((dir + path).c_str(), 0755); }
+};
+
+// Stat calls a lookup takes
+static uint32_t statsFor(const char *path, bool expect){
+  StaticInfo m;
+  uint32_t before = hostStatCalls;
+  CHECK(staticLookup(FSUsageLittleFS, path, m) == expect);
+  return hostStatCalls - before;
+}
+
+// Lets everything remembered run out of time, as if StaticMetaSec and StaticMissSec passed
+static void ageAll(){
+  for(auto &e : staticMeta) e.checked -= StaticMetaSec * 1000UL;
+  for(auto &x : staticMiss) x.checked -= StaticMissSec * 1000UL;
+}
+
+TEST(lookupRemembered){
+  StaticDir d;
+  d.file("/a.htm", "hello");
+  d.file("/a.htm.gz", "gz");
+  CHECK_EQ(statsFor("/a.htm", true), 3);
+  CHECK_EQ(statsFor("/a.htm", true), 0);
+  StaticInfo m;
+  staticLookup(FSUsageLittleFS, "/a.htm", m);
+  CHECK(m.exists[StaticPlain] && m.exists[StaticGz] && !m.exists[StaticBr]);
+  CHECK_EQ(m.size[StaticPlain], 5);
+  CHECK_EQ(m.mtime[StaticGz], 1600000000);
+}
+
+TEST(missesDontPushOutFiles){
+  StaticDir d;
+  char name[32];
+  for(int i = 0; i < StaticMetaFiles; i++){
+    sprintf(name, "/f%02d.css", i);
+    d.file(name, "x");
+    statsFor(name, true);
+  }
+  for(int i = 0; i < 10 * StaticMissFiles; i++){      // A scanner
+    sprintf(name, "/wp-admin%03d.php", i);
+    CHECK_EQ(statsFor(name, false), 3);
+  }
+  for(int i = 0; i < StaticMetaFiles; i++){
+    sprintf(name, "/f%02d.css", i);
+    CHECK_EQ(statsFor(name, true), 0);                // All still known
+  }
+  CHECK_EQ(statsFor("/wp-admin079.php", false), 0);   // The last misses are remembered for a while
+}
+
+TEST(missExpires){
+  StaticDir d;
+  CHECK_EQ(statsFor("/new.js", false), 3);
+  CHECK_EQ(statsFor("/new.js", false), 0);
+  d.file("/new.js", "x");                             // Created without staticFileChanged
+  CHECK_EQ(statsFor("/new.js", false), 0);
+  ageAll();
+  CHECK_EQ(statsFor("/new.js", true), 3);
+}
+
+TEST(changedOutsideRecheck){
+  StaticDir d;
+  d.file("/s.css", "one", 1600000000);
+  statsFor("/s.css", true);
+  d.file("/s.css", "changed", 1700000000);            // Replaced without staticFileChanged (custom code, other SD card)
+  StaticInfo m;
+  staticLookup(FSUsageLittleFS, "/s.css", m);
+  CHECK_EQ(m.size[StaticPlain], 3);                   // Not looked at yet
+  ageAll();
+  CHECK_EQ(statsFor("/s.css", true), 3);
+  staticLookup(FSUsageLittleFS, "/s.css", m);
+  CHECK_EQ(m.size[StaticPlain], 7);
+  CHECK_EQ(m.mtime[StaticPlain], 1700000000);
+  unlink((d.dir + "/s.css").c_str());                 // Removed
+  ageAll();
+  CHECK_EQ(statsFor("/s.css", false), 3);
+  for(auto &e : staticMeta) CHECK(strcmp(e.path, "/s.css") != 0);
+}
+
+TEST(fileChangedForgets){
+  StaticDir d;
+  statsFor("/up.htm", false);
+  d.file("/up.htm", "x");
+  staticFileChanged(FSUsageLittleFS, "/up.htm");      // The file manager tells
+  CHECK_EQ(statsFor("/up.htm", true), 3);
+  d.file("/up.htm", "xyz");
+  staticFileChanged(FSUsageLittleFS, "/up.htm.gz");   // A sibling counts as well
+  StaticInfo m;
+  staticLookup(FSUsageLittleFS, "/up.htm", m);
+  CHECK_EQ(m.size[StaticPlain], 3);
+}
+
+// Requests as the server hands them to StaticFileHandler. Returns the status sent
+static int get(const char *url, std::string *body = NULL){
+  AsyncWebServerRequest request(HTTP_GET, url);
+  server.hostRequest(&request);
+  AsyncWebServerResponse *r = request.hostResponse();
+  if(body) *body = r ? r->content : "";
+  return r ? r->code : 0;
+}
+
+TEST(handlerDefaultFile){
+  StaticDir d;
+  static bool added = false;
+  if(!added) addStaticFiles("/", FSUsageLittleFS, "/Main.htm");
+  added = true;
+  d.mkdir("/app");
+  d.file("/app/Main.htm", "app page");
+  d.file("/page.htm", "page");
+  std::string body;
+  CHECK_EQ(get("/page.htm", &body), 200);
+  CHECK_STR(body, "page");
+  CHECK_EQ(get("/app", &body), 200);                  // A directory is served by its default file
+  CHECK_STR(body, "app page");
+  CHECK_EQ(get("/app/", &body), 200);
+  CHECK_STR(body, "app page");
+  uint32_t before = hostStatCalls;
+  CHECK_EQ(get("/missing.php"), 404);
+  CHECK_EQ(hostStatCalls - before, 3);                // Not a directory: no default file tried
+  before = hostStatCalls;
+  CHECK_EQ(get("/missing.php"), 404);
+  CHECK_EQ(hostStatCalls - before, 0);
+}
+
+// ---- The PSRAM cache ----
+struct AssetDir : StaticDir {
+  AssetDir(){
+    for(int i = 0; i < AssetCacheFiles; i++) assetFree(i);
+    if(!assetMutex) assetMutex = xSemaphoreCreateMutex();
+    assetBudget = 4096;                                // psramFound() is false on the host
+  }
+  ~AssetDir(){
+    for(int i = 0; i < AssetCacheFiles; i++) assetFree(i);
+    assetBudget = 0;
+    hostPsramFailures = 0;
+  }
+};
+
+TEST(assetOutOfPsramRetried){
+  AssetDir d;
+  d.file("/a.css", "body{}");
+  hostPsramFailures = 1;
+  CHECK(!assetCacheLoad(FSUsageLittleFS, "/a.css"));
+  CHECK_EQ(assetFind(FSUsageLittleFS, "/a.css"), -1);  // Not taken for a file that can't be cached
+  CHECK(assetCacheLoad(FSUsageLittleFS, "/a.css"));
+  CHECK_EQ(assetBytes, 6);
+}
+
+TEST(assetUncacheableRemembered){
+  AssetDir d;
+  d.file("/big.jpg", std::string(AssetCacheMaxFileKB * 1024 + 1, 'x'));
+  CHECK(!assetCacheLoad(FSUsageLittleFS, "/big.jpg"));
+  int i = assetFind(FSUsageLittleFS, "/big.jpg");
+  CHECK(i >= 0);
+  CHECK(assetCache[i].data == NULL);
+  CHECK_EQ(assetBytes, 0);
+}
+
+TEST_MAIN
@@ -0,0 +1,241 @@
+// Websocket requests: parsing (wsParse, wsField), the sorted route tables (wsSorted, registerWSRequest, findWSRoute),
+// dispatching and putting fragmented messages back together
+#include "Sketch.h"
+#include "Prototypes.h"
+#include "Check.h"
+#include "HostHeap.h"
+#include "WSHost.h"
+
+#include "WSDispatch.ino"
+
+static AsyncWebSocket ws("/ws");
+
+// Dispatches a message the way the websocket event handler does, through wsAssemble
+static bool dispatch(AsyncWebSocketClient *client, const char *text){
+  std::string copy(text);
+  AwsFrameInfo info = {WS_TEXT, 0, 1, 1, WS_TEXT, copy.size(), {0, 0, 0, 0}, 0};
+  char *msg;
+  size_t msgLen;
+  if(!wsAssemble(client, &info, (uint8_t *)&copy[0], copy.size(), msg, msgLen)) return false;
+  return wsDispatch(client, msg, msgLen);
+}
+
+// ---- Parsing ----
+TEST(parseJson){
+  char msg[] = "{\"request\":\"FMgetDir\", \"dir\":\"/a \\\"b\\\"\\n\", 'single':'x', \"num\":42,"
+               "\"nested\":{\"k\":[1,\"}\"]},\"u\":\"\\u00e9\\u20ac\"}";
+  WSRequest req;
+  CHECK(wsParse(req, msg, strlen(msg)));
+  CHECK(req.json);
+  CHECK_STR(req.name, "FMgetDir");
+  char out[64];
+  CHECK(wsField(req, "dir", out, sizeof(out)));
+  CHECK_STR(out, "/a \"b\"\n");
+  CHECK(wsField(req, "single", out, sizeof(out)));
+  CHECK_STR(out, "x");
+  CHECK_EQ(wsFieldLong(req, "num", 0), 42);
+  CHECK_EQ(wsFieldLong(req, "missing", -1), -1);
+  CHECK(wsField(req, "u", out, sizeof(out)));
+  CHECK_STR(out, "\xC3\xA9\xE2\x82\xAC");
+  CHECK(!wsField(req, "k", out, sizeof(out)));  // Inside the nested object: not an attribute of the request
+  CHECK_STR(out, "");
+}
+
+TEST(parseJsonTruncates){
+  char msg[] = "{\"request\":\"x\",\"long\":\"0123456789\"}";
+  WSRequest req;
+  CHECK(wsParse(req, msg, sizeof(msg)));        // With the terminating 0, as pages send it
+  char out[5];
+  CHECK(wsField(req, "long", out, sizeof(out)));
+  CHECK_STR(out, "0123");
+}
+
+TEST(parseJsonMalformed){
+  const char *bad[] = {"{request:\"x\"}", "{\"request\" \"x\"}", "{\"request\":\"x", "{\"request\":{\"a\":1", "{\"other\":1}"};
+  for(auto b : bad){
+    std::string copy(b);
+    WSRequest req;
+    CHECK(!wsParse(req, &copy[0], copy.size()));
+  }
+}
+
+TEST(parseText){
+  char msg[] = "setDateTime\r\nUTC\npool.ntp.org";
+  WSRequest req;
+  CHECK(wsParse(req, msg, strlen(msg)));
+  CHECK(!req.json);
+  CHECK_STR(req.name, "setDateTime");
+  CHECK(req.data == msg);                       // The whole message is left for the handler
+}
+
+TEST(getOperandLimit){
+  char operand[6];
+  char input[] = "getHostSettings";
+  getOperand(operand, input, sizeof(operand));
+  CHECK_STR(operand, "getHo");
+}
+
+// ---- Route tables ----
+TEST(coreRoutesSorted){
+  CHECK(wsSorted(coreWSRoutes, numCoreWSRoutes));
+  for(int i = 0; i < numCoreWSRoutes; i++)
+    CHECK(findWSRoute(coreWSRoutes, numCoreWSRoutes, coreWSRoutes[i].name) == &coreWSRoutes[i]);
+  CHECK(findWSRoute(coreWSRoutes, numCoreWSRoutes, "FMget") == NULL);
+  CHECK(findWSRoute(coreWSRoutes, numCoreWSRoutes, "zzz") == NULL);
+  constexpr WSRoute unsorted[] = {{"b", NULL, 0}, {"a", NULL, 0}};
+  static_assert(!wsSorted(unsorted, 2), "wsSorted must find unsorted tables");
+}
+
+static void customHandler(AsyncWebSocketClient *client, WSRequest &req){
+  char rsvp[64];
+  snprintf(rsvp, sizeof(rsvp), "custom %s", req.name);
+  client->text(rsvp);
+}
+
+TEST(registerCustom){
+  numCustomWSRoutes = 0;
+  const char *names[] = {"m", "c", "x", "a", "Z"};
+  for(auto n : names) CHECK(registerWSRequest(n, customHandler, WSjson));
+  CHECK(!registerWSRequest("c", customHandler, WSjson));
+  CHECK_EQ(numCustomWSRoutes, 5);
+  CHECK(wsSorted(customWSRoutes, numCustomWSRoutes));
+  CHECK_STR(customWSRoutes[0].name, "Z");
+  static char extra[WSmaxCustomRequests][8];
+  int added = numCustomWSRoutes;
+  for(int i = 0; added < WSmaxCustomRequests + 2; i++, added++){
+    sprintf(extra[i % WSmaxCustomRequests], "e%02d", i);
+    CHECK(registerWSRequest(extra[i % WSmaxCustomRequests], customHandler, WSjson) == (added < WSmaxCustomRequests));
+  }
+  CHECK_EQ(numCustomWSRoutes, WSmaxCustomRequests);
+  numCustomWSRoutes = 0;
+}
+
+// ---- Dispatching ----
+TEST(dispatchFormats){
+  AsyncWebSocketClient *c = ws.hostConnect(1);
+  CHECK(dispatch(c, "{\"request\":\"getDateTime\"}"));
+  CHECK_STR(c->lastText(), "{\"answer\":\"setDateTime\"}");
+  CHECK(dispatch(c, "getDateTime"));
+  CHECK_STR(c->lastText(), "setDateTime");
+  CHECK(dispatch(c, "{\"request\":\"FMgetDir\",\"filesys\":\"LittleFS\",\"dir\":\"/d\",\"sort\":\"size\",\"desc\":1,\"cursor\":\"f.txt\"}"));
+  CHECK_STR(c->lastText(), "dir LittleFS|/d|size|1|f.txt");
+  CHECK(!dispatch(c, "FMgetDir"));              // JSON only
+  CHECK(!dispatch(c, "{\"request\":\"setDateTime\"}"));  // Text only
+  CHECK(!dispatch(c, "{\"request\":\"unknown\"}"));
+  ws.hostDisconnect(1);
+}
+
+TEST(dispatchLocalOnly){
+  AsyncWebSocketClient *remote = ws.hostConnect(2, IPAddress(10, 0, 0, 9));
+  hostCalls.clear();
+  CHECK(dispatch(remote, "setDateTime\nUTC"));  // Taken, but ignored
+  CHECK_STR(hostCalls, "");
+  CHECK(dispatch(remote, "{\"request\":\"FMuploadBegin\",\"path\":\"/a\",\"size\":3}"));
+  CHECK_STR(hostCalls, "createUpload");
+  AsyncWebSocketClient *local = ws.hostConnect(3);
+  hostCalls.clear();
+  CHECK(dispatch(local, "setDateTime\nUTC"));
+  CHECK_STR(hostCalls, "setDateTimeSettings");
+  CHECK(dispatch(local, "{\"request\":\"FMdelete\",\"filesys\":\"LittleFS\",\"dir\":\"/d/\",\"fname\":\"f.txt\"}"));
+  CHECK_STR(hostCalls, "setDateTimeSettings,/d/f.txt");
+  ws.hostDisconnect(2);
+  ws.hostDisconnect(3);
+}
+
+TEST(dispatchStorageNotReady){
+  AsyncWebSocketClient *c = ws.hostConnect(8);
+  hostStorageReady = false;
+  hostCalls.clear();
+  CHECK(dispatch(c, "{\"request\":\"FMgetDir\",\"filesys\":\"LittleFS\",\"dir\":\"/\"}"));
+  CHECK_STR(c->lastText(), "{\"answer\":\"storageNotReady\",\"request\":\"FMgetDir\",\"retry\":2000}");
+  CHECK(dispatch(c, "{\"request\":\"FMdelete\",\"filesys\":\"LittleFS\",\"dir\":\"/d/\",\"fname\":\"f.txt\"}"));
+  CHECK_STR(hostCalls, "");                    // Nothing deleted
+  CHECK(dispatch(c, "getDateTime"));            // Doesn't need the file systems
+  CHECK_STR(c->lastText(), "setDateTime");
+  hostStorageReady = true;
+  CHECK(dispatch(c, "{\"request\":\"FMgetBasic\"}"));
+  CHECK_STR(c->lastText(), "basic");
+  ws.hostDisconnect(8);
+}
+
+TEST(dispatchCustom){
+  numCustomWSRoutes = 0;
+  registerWSRequest("getDateTime", customHandler, WStext);   // Same name as a core request, other format
+  registerWSRequest("myRequest", customHandler, WSjson | WStext);
+  AsyncWebSocketClient *c = ws.hostConnect(4);
+  CHECK(dispatch(c, "{\"request\":\"myRequest\"}"));
+  CHECK_STR(c->lastText(), "custom myRequest");
+  CHECK(dispatch(c, "getDateTime"));            // The core request takes text as well, so it wins
+  CHECK_STR(c->lastText(), "setDateTime");
+  ws.hostDisconnect(4);
+  numCustomWSRoutes = 0;
+}
+
+TEST(dispatchMetrics){
+  hostMetricNames.clear();
+  wsSetupMetrics();
+  numCustomWSRoutes = 0;
+  registerWSRequest("zeta", customHandler, WSjson);
+  registerWSRequest("alpha", customHandler, WSjson);     // Moves zeta down the table. Its metric goes along
+  AsyncWebSocketClient *c = ws.hostConnect(6);
+  CHECK(dispatch(c, "getDateTime"));
+  CHECK_STR(hostMetricNames[hostMetricLast], "websocket:getDateTime");
+  CHECK(dispatch(c, "{\"request\":\"FMgetDir\",\"dir\":\"/\"}"));
+  CHECK_STR(hostMetricNames[hostMetricLast], "websocket:FMgetDir");
+  CHECK(dispatch(c, "{\"request\":\"zeta\"}"));
+  CHECK_STR(hostMetricNames[hostMetricLast], "websocket:zeta");
+  CHECK(dispatch(c, "{\"request\":\"alpha\"}"));
+  CHECK_STR(hostMetricNames[hostMetricLast], "websocket:alpha");
+  hostMetricLast = -1;
+  CHECK(!dispatch(c, "{\"request\":\"zzz\"}"));      // Nobody's: customWS_EVT times it as part of the event
+  CHECK_EQ(hostMetricLast, -1);
+  ws.hostDisconnect(6);
+  numCustomWSRoutes = 0;
+}
+
+TEST(dispatchDoesNotAllocate){
+  AsyncWebSocketClient *c = ws.hostConnect(5);
+  c->hostRecord = false;
+  std::string msg = "{\"request\":\"FMgetDir\",\"filesys\":\"LittleFS\",\"dir\":\"/\",\"sort\":\"name\",\"desc\":0,\"cursor\":\"\"}";
+  hostHeapReset();
+  CHECK(wsDispatch(c, &msg[0], msg.size()));
+  CHECK_EQ(hostHeap().allocs, 0);
+  ws.hostDisconnect(5);
+}
+
+// ---- Fragmented messages ----
+TEST(assembleFragments){
+  AsyncWebSocketClient *a = ws.hostConnect(6);
+  AsyncWebSocketClient *b = ws.hostConnect(7);
+  std::string part1 = "{\"request\":\"getD", part2 = "ateTime\"}";
+  char *msg;
+  size_t msgLen;
+  AwsFrameInfo first = {WS_TEXT, 0, 0, 1, WS_TEXT, part1.size(), {0, 0, 0, 0}, 0};
+  CHECK(!wsAssemble(a, &first, (uint8_t *)&part1[0], part1.size(), msg, msgLen));
+  AwsFrameInfo other = {WS_TEXT, 1, 1, 1, WS_CONTINUATION, part2.size(), {0, 0, 0, 0}, 0};
+  CHECK(!wsAssemble(b, &other, (uint8_t *)&part2[0], part2.size(), msg, msgLen));  // No beginning: dropped
+  AwsFrameInfo last = {WS_TEXT, 1, 1, 1, WS_CONTINUATION, part2.size(), {0, 0, 0, 0}, 0};
+  CHECK(wsAssemble(a, &last, (uint8_t *)&part2[0], part2.size(), msg, msgLen));
+  CHECK_STR(std::string(msg, msgLen), part1 + part2);
+  CHECK(wsDispatch(a, msg, msgLen));
+  wsRelease(a);
+  CHECK_STR(a->lastText(), "{\"answer\":\"setDateTime\"}");
+  for(auto &p : wsPartials) CHECK(p.id == 0);
+  ws.hostDisconnect(6);
+  ws.hostDisconnect(7);
+}
+
+TEST(assembleTooLong){
+  AsyncWebSocketClient *a = ws.hostConnect(8);
+  std::string piece(WSmaxMessage / 2 + 1, 'x');
+  char *msg;
+  size_t msgLen;
+  AwsFrameInfo f0 = {WS_TEXT, 0, 0, 1, WS_TEXT, piece.size(), {0, 0, 0, 0}, 0};
+  AwsFrameInfo f1 = {WS_TEXT, 1, 1, 1, WS_CONTINUATION, piece.size(), {0, 0, 0, 0}, 0};
+  CHECK(!wsAssemble(a, &f0, (uint8_t *)&piece[0], piece.size(), msg, msgLen));
+  CHECK(!wsAssemble(a, &f1, (uint8_t *)&piece[0], piece.size(), msg, msgLen));
+  for(auto &p : wsPartials) CHECK(p.id == 0);   // Released
+  ws.hostDisconnect(8);
+}
+
+TEST_MAIN